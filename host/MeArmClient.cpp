@@ -0,0 +1,211 @@
+#include "MeArmClient.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#ifdef __linux__
+#include <linux/serial.h>
+#endif
+
+static int64_t nowMs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (int64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static speed_t baudConstant(int baud) {
+  switch (baud) {
+    case 9600: return B9600;
+    case 57600: return B57600;
+    case 115200: return B115200;
+    case 230400: return B230400;
+    case 460800: return B460800;
+    case 921600: return B921600;
+    default: return 0;
+  }
+}
+
+MeArmClient::MeArmClient() : fd(-1), nextSeq(0), rxLen(0), rxPos(0) {
+  onLog = [](const std::string& line) { fprintf(stderr, "arm: %s\n", line.c_str()); };
+}
+
+MeArmClient::~MeArmClient() {
+  close();
+}
+
+bool MeArmClient::open(const std::string& device, int baud, int connectMs) {
+  close();
+  speed_t speed = baudConstant(baud);
+  if (!speed) {
+    fprintf(stderr, "Unsupported baud rate %d\n", baud);
+    return false;
+  }
+  fd = ::open(device.c_str(), O_RDWR | O_NOCTTY | O_CLOEXEC);
+  if (fd < 0) {
+    fprintf(stderr, "%s: %s\n", device.c_str(), strerror(errno));
+    return false;
+  }
+
+  struct termios tio;
+  if (tcgetattr(fd, &tio) == 0) {
+    cfmakeraw(&tio);
+    cfsetispeed(&tio, speed);
+    cfsetospeed(&tio, speed);
+    tio.c_cflag |= CLOCAL | CREAD;
+    tio.c_cc[VMIN] = 0;
+    tio.c_cc[VTIME] = 0;
+    tcsetattr(fd, TCSANOW, &tio);
+  }
+#ifdef __linux__
+  // USB serial adapters otherwise batch input for up to 16 ms
+  struct serial_struct ss;
+  if (ioctl(fd, TIOCGSERIAL, &ss) == 0) {
+    ss.flags |= ASYNC_LOW_LATENCY;
+    ioctl(fd, TIOCSSERIAL, &ss);
+  }
+#endif
+  tcflush(fd, TCIOFLUSH);
+  rxLen = rxPos = 0;
+
+  // A delimiter first ends anything half-sent before we opened the port
+  uint8_t zero = 0;
+  if (::write(fd, &zero, 1) != 1) return false;
+  int64_t deadline = nowMs() + connectMs;
+  int saved = timeoutMs;
+  timeoutMs = 200;
+  bool ok = false;
+  while (!ok && nowMs() < deadline) ok = ping();
+  timeoutMs = saved;
+  if (!ok) fprintf(stderr, "%s: no answer from the arm\n", device.c_str());
+  return ok;
+}
+
+void MeArmClient::close() {
+  if (fd < 0) return;
+  write(SERIAL_CLOSE, nextSeq++, nullptr, 0);
+  tcdrain(fd);
+  ::close(fd);
+  fd = -1;
+}
+
+bool MeArmClient::write(uint8_t type, uint8_t seq, const uint8_t* payload, size_t len) {
+  uint8_t frame[SERIAL_MAX_FRAME];
+  size_t n = serialEncodeFrame(type, seq, payload, len, frame);
+  if (fd < 0 || n == 0) return false;
+  size_t sent = 0;
+  while (sent < n) {
+    ssize_t w = ::write(fd, frame + sent, n - sent);
+    if (w < 0 && errno == EINTR) continue;
+    if (w <= 0) return false;
+    sent += w;
+  }
+  return true;
+}
+
+bool MeArmClient::request(uint8_t type, const uint8_t* payload, size_t len, uint8_t expect,
+                          std::vector<uint8_t>& reply) {
+  uint8_t seq = nextSeq++;
+  if (!write(type, seq, payload, len)) return false;
+
+  int64_t deadline = nowMs() + timeoutMs;
+  for (;;) {
+    // Bytes left over from the last read first
+    while (rxPos < rxLen) {
+      if (!decoder.push(rx[rxPos++])) continue;
+      if (decoder.type() == SERIAL_LOG) {
+        if (onLog) onLog(std::string((const char*)decoder.payload(), decoder.payloadLength()));
+      } else if (decoder.type() == expect && decoder.seq() == seq) {
+        reply.assign(decoder.payload(), decoder.payload() + decoder.payloadLength());
+        return true;
+      }
+      // Anything else answers an earlier request that timed out
+    }
+
+    int64_t left = deadline - nowMs();
+    if (left <= 0) return false;
+    struct pollfd pfd = {fd, POLLIN, 0};
+    int r = ::poll(&pfd, 1, (int)left);
+    if (r < 0 && errno == EINTR) continue;
+    if (r <= 0) return false;
+    ssize_t n = ::read(fd, rx, sizeof(rx));
+    if (n < 0 && errno == EINTR) continue;
+    if (n <= 0) return false;
+    rxLen = n;
+    rxPos = 0;
+  }
+}
+
+bool MeArmClient::requestAck(uint8_t type, const uint8_t* payload, size_t len, uint8_t& status, uint16_t* count) {
+  std::vector<uint8_t> reply;
+  if (!request(type, payload, len, SERIAL_ACK, reply) || reply.size() < 2 || reply[0] != type) return false;
+  status = reply[1];
+  if (count) *count = reply.size() >= 4 ? serialGetU16(&reply[2]) : 0;
+  return true;
+}
+
+bool MeArmClient::ping(const uint8_t* data, size_t len) {
+  std::vector<uint8_t> reply;
+  return request(SERIAL_PING, data, len, SERIAL_PONG, reply) && reply.size() == len &&
+         (len == 0 || memcmp(reply.data(), data, len) == 0);
+}
+
+static void packTargets(uint8_t mask, const uint16_t tenths[SERIAL_JOINTS], uint8_t* out) {
+  out[0] = mask;
+  for (uint8_t j = 0; j < SERIAL_JOINTS; j++) serialPutU16(out + 1 + 2 * j, tenths[j]);
+}
+
+bool MeArmClient::setTargets(uint8_t mask, const uint16_t tenths[SERIAL_JOINTS], uint8_t& status) {
+  uint8_t payload[SERIAL_TARGETS_SIZE];
+  packTargets(mask, tenths, payload);
+  return requestAck(SERIAL_SET_TARGETS, payload, sizeof(payload), status);
+}
+
+bool MeArmClient::enable(uint8_t mask, uint8_t enabled, uint8_t& status) {
+  uint8_t payload[2] = {mask, enabled};
+  return requestAck(SERIAL_ENABLE, payload, sizeof(payload), status);
+}
+
+bool MeArmClient::streamSetpoint(uint8_t mask, const uint16_t tenths[SERIAL_JOINTS]) {
+  uint8_t payload[SERIAL_TARGETS_SIZE];
+  packTargets(mask, tenths, payload);
+  return write(SERIAL_SETPOINT, nextSeq++, payload, sizeof(payload));
+}
+
+bool MeArmClient::getState(SerialState& state) {
+  std::vector<uint8_t> reply;
+  return request(SERIAL_GET_STATE, nullptr, 0, SERIAL_STATE, reply) &&
+         serialDecodeState(reply.data(), reply.size(), state);
+}
+
+bool MeArmClient::uploadSequence(const std::vector<Pose>& poses, const std::string& name, uint8_t& status) {
+  if (!requestAck(SERIAL_UPLOAD_BEGIN, nullptr, 0, status)) return false;
+  if (status != 0) return true;
+
+  const size_t perFrame = SERIAL_MAX_PAYLOAD / SERIAL_POSE_SIZE;
+  uint8_t payload[SERIAL_MAX_PAYLOAD];
+  for (size_t first = 0; first < poses.size(); first += perFrame) {
+    size_t n = poses.size() - first < perFrame ? poses.size() - first : perFrame;
+    for (size_t i = 0; i < n; i++) {
+      uint8_t* p = payload + i * SERIAL_POSE_SIZE;
+      memcpy(p, poses[first + i].joints, SERIAL_JOINTS);
+      serialPutU16(p + SERIAL_JOINTS, poses[first + i].dtMs);
+    }
+    if (!requestAck(SERIAL_UPLOAD_POSES, payload, n * SERIAL_POSE_SIZE, status)) return false;
+    if (status != 0) return true;
+  }
+  return requestAck(SERIAL_UPLOAD_END, (const uint8_t*)name.data(), name.size(), status);
+}
+
+// ArmStatus order, include/ArmController.h
+const char* MeArmClient::statusName(uint8_t status) {
+  static const char* const names[] = {
+    "OK", "busy", "motion queue full", "invalid", "not found", "joint not enabled", "out of reach",
+    "nothing recorded", "too large", "storage error", "outside the collision envelope",
+  };
+  return status < sizeof(names) / sizeof(names[0]) ? names[status] : "unknown";
+}
@@ -0,0 +1,68 @@
+#ifndef MEARM_CLIENT_H
+#define MEARM_CLIENT_H
+
+#include <functional>
+#include <string>
+#include <vector>
+#include "SerialProtocol.h"
+
+// Host side of the serial protocol (include/SerialProtocol.h) over a POSIX
+// serial device: the arm's USB port, or a pseudo-terminal. One request is
+// in flight at a time; LOG frames arriving meanwhile go to onLog.
+class MeArmClient {
+public:
+  struct Pose {
+    uint8_t joints[SERIAL_JOINTS]; // Degrees
+    uint16_t dtMs;                 // Since the previous pose
+  };
+
+  // Replies slower than this count as lost
+  int timeoutMs = 500;
+  std::function<void(const std::string&)> onLog;
+
+  MeArmClient();
+  ~MeArmClient();
+
+  // Opens the device raw at `baud` and pings until the arm answers (the
+  // port opening may reset the board, which then takes a moment to boot)
+  bool open(const std::string& device, int baud = 115200, int connectMs = 3000);
+  // Sends CLOSE, so the UART goes back to the text log, and closes the device
+  void close();
+
+  // The calls below return false when the link fails (I/O error, timeout);
+  // what the arm made of a request comes back separately.
+
+  // Round trip with an arbitrary payload echoed back
+  bool ping(const uint8_t* data = nullptr, size_t len = 0);
+  // `mask` bit j selects joint j; positions in tenths of a degree. `status`
+  // is the firmware's ArmStatus (0 = OK, see statusName()).
+  bool setTargets(uint8_t mask, const uint16_t tenths[SERIAL_JOINTS], uint8_t& status);
+  // Attaches (bit set in `enabled`) or detaches each joint in `mask`
+  bool enable(uint8_t mask, uint8_t enabled, uint8_t& status);
+  // Fire and forget, for streaming at a fixed rate; only fails on I/O errors
+  bool streamSetpoint(uint8_t mask, const uint16_t tenths[SERIAL_JOINTS]);
+  bool getState(SerialState& state);
+  // Replaces the recording with `poses` and, with a non-empty name, saves it
+  // as a stored sequence. Stops at the first pose the arm refuses; `status`
+  // says why.
+  bool uploadSequence(const std::vector<Pose>& poses, const std::string& name, uint8_t& status);
+
+  uint32_t frameErrors() const { return decoder.errors(); }
+  static const char* statusName(uint8_t status);
+
+private:
+  int fd;
+  uint8_t nextSeq;
+  SerialFrameDecoder decoder;
+  uint8_t rx[256];
+  size_t rxLen;
+  size_t rxPos;
+
+  bool write(uint8_t type, uint8_t seq, const uint8_t* payload, size_t len);
+  // Sends a request and waits for the reply of type `expect` with its seq
+  bool request(uint8_t type, const uint8_t* payload, size_t len, uint8_t expect, std::vector<uint8_t>& reply);
+  // Acks carry the request type, a status and sometimes a count
+  bool requestAck(uint8_t type, const uint8_t* payload, size_t len, uint8_t& status, uint16_t* count = nullptr);
+};
+
+#endif // MEARM_CLIENT_H
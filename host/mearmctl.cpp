@@ -0,0 +1,194 @@
+// Command line client for the serial protocol. Build on Linux or macOS:
+//   g++ -std=c++11 -O2 -Iinclude host/*.cpp src/SerialProtocol.cpp -o mearmctl
+//
+//   mearmctl DEVICE ping [COUNT]          round-trip latency
+//   mearmctl DEVICE state
+//   mearmctl DEVICE enable B S E C        1 attaches, 0 detaches, - leaves alone
+//   mearmctl DEVICE set B S E C           degrees; - leaves a joint alone
+//   mearmctl DEVICE stream HZ SECONDS     sweeps the base +-30 degrees
+//   mearmctl DEVICE upload FILE [NAME]    one pose per line: B S E C DT_MS
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include "MeArmClient.h"
+
+typedef std::chrono::steady_clock Clock;
+
+static int usage() {
+  fprintf(stderr,
+          "usage: mearmctl DEVICE [-b BAUD] COMMAND ...\n"
+          "  ping [COUNT]        round-trip latency\n"
+          "  state               joint positions and playback\n"
+          "  enable B S E C      attach (1) or detach (0) joints, - to skip\n"
+          "  set B S E C         move (degrees, - to skip a joint)\n"
+          "  stream HZ SECONDS   stream setpoints sweeping the base\n"
+          "  upload FILE [NAME]  send poses (B S E C DT_MS per line)\n");
+  return 2;
+}
+
+static int runPing(MeArmClient& arm, int count) {
+  std::vector<double> us;
+  uint8_t payload[8];
+  for (int i = 0; i < count; i++) {
+    memcpy(payload, &i, sizeof(i));
+    Clock::time_point start = Clock::now();
+    if (!arm.ping(payload, sizeof(payload))) {
+      fprintf(stderr, "ping %d lost\n", i);
+      continue;
+    }
+    us.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+  }
+  if (us.empty()) return 1;
+  std::sort(us.begin(), us.end());
+  printf("%zu/%d replies, round trip min %.0f us, median %.0f us, p99 %.0f us, max %.0f us\n", us.size(), count,
+         us.front(), us[us.size() / 2], us[std::min(us.size() - 1, us.size() * 99 / 100)], us.back());
+  return us.size() == (size_t)count ? 0 : 1;
+}
+
+static int runState(MeArmClient& arm) {
+  SerialState s;
+  if (!arm.getState(s)) {
+    fprintf(stderr, "No reply\n");
+    return 1;
+  }
+  static const char* const names[SERIAL_JOINTS] = {"base", "shoulder", "elbow", "claw"};
+  for (uint8_t j = 0; j < SERIAL_JOINTS; j++) {
+    printf("%-8s target %3u  at %3d  %s\n", names[j], s.target[j], s.actual[j],
+           s.enabled & (1 << j) ? "enabled" : "disabled");
+  }
+  printf("recorded %u poses%s%s%s", s.poses, s.flags & SERIAL_STATE_RECORDING ? ", recording" : "",
+         s.flags & SERIAL_STATE_PLAYING ? ", playing" : "", s.flags & SERIAL_STATE_PAUSED ? " (paused)" : "");
+  if (s.playTotal) printf(" %u/%u", s.playDone, s.playTotal);
+  printf("\n");
+  return 0;
+}
+
+static int report(bool replied, uint8_t status) {
+  if (!replied) {
+    fprintf(stderr, "No reply\n");
+    return 1;
+  }
+  printf("%s\n", MeArmClient::statusName(status));
+  return status == 0 ? 0 : 1;
+}
+
+static int runEnable(MeArmClient& arm, char** args) {
+  uint8_t mask = 0, enabled = 0;
+  for (uint8_t j = 0; j < SERIAL_JOINTS; j++) {
+    if (strcmp(args[j], "-") == 0) continue;
+    mask |= 1 << j;
+    if (atoi(args[j])) enabled |= 1 << j;
+  }
+  uint8_t status;
+  bool replied = arm.enable(mask, enabled, status);
+  return report(replied, status);
+}
+
+static int runSet(MeArmClient& arm, char** args) {
+  uint8_t mask = 0;
+  uint16_t tenths[SERIAL_JOINTS] = {0};
+  for (uint8_t j = 0; j < SERIAL_JOINTS; j++) {
+    if (strcmp(args[j], "-") == 0) continue;
+    mask |= 1 << j;
+    tenths[j] = (uint16_t)lround(std::max(0.0, std::min(180.0, atof(args[j]))) * 10);
+  }
+  uint8_t status;
+  bool replied = arm.setTargets(mask, tenths, status);
+  return report(replied, status);
+}
+
+static int runStream(MeArmClient& arm, double hz, double seconds) {
+  SerialState s;
+  if (!arm.getState(s)) return 1;
+  double center = s.target[0];
+  uint16_t tenths[SERIAL_JOINTS] = {0};
+  Clock::duration period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1 / hz));
+  Clock::time_point start = Clock::now();
+  Clock::time_point next = start;
+  int sent = 0;
+  for (;;) {
+    double t = std::chrono::duration<double>(Clock::now() - start).count();
+    if (t >= seconds) break;
+    double deg = std::max(0.0, std::min(180.0, center + 30 * sin(2 * M_PI * 0.25 * t)));
+    tenths[0] = (uint16_t)lround(deg * 10);
+    if (!arm.streamSetpoint(1, tenths)) return 1;
+    sent++;
+    next += period;
+    std::this_thread::sleep_until(next);
+  }
+  printf("%d setpoints in %.1f s\n", sent, seconds);
+  return 0;
+}
+
+static int runUpload(MeArmClient& arm, const char* path, const char* name) {
+  std::ifstream in(path);
+  if (!in) {
+    fprintf(stderr, "%s: can't read\n", path);
+    return 1;
+  }
+  std::vector<MeArmClient::Pose> poses;
+  std::string line;
+  while (std::getline(in, line)) {
+    if (line.empty() || line[0] == '#') continue;
+    std::istringstream fields(line);
+    int b, s, e, c, dt;
+    if (!(fields >> b >> s >> e >> c >> dt)) {
+      fprintf(stderr, "%s: bad line '%s'\n", path, line.c_str());
+      return 1;
+    }
+    MeArmClient::Pose pose = {{(uint8_t)b, (uint8_t)s, (uint8_t)e, (uint8_t)c}, (uint16_t)dt};
+    poses.push_back(pose);
+  }
+
+  uint8_t status;
+  Clock::time_point start = Clock::now();
+  if (!arm.uploadSequence(poses, name ? name : "", status)) {
+    fprintf(stderr, "Upload failed: no reply\n");
+    return 1;
+  }
+  double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+  printf("%zu poses: %s (%.0f ms)\n", poses.size(), MeArmClient::statusName(status), ms);
+  return status == 0 ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+  if (argc < 3) return usage();
+  const char* device = argv[1];
+  int baud = 115200;
+  int i = 2;
+  if (strcmp(argv[i], "-b") == 0) {
+    if (argc < 5) return usage();
+    baud = atoi(argv[i + 1]);
+    i += 2;
+  }
+  std::string command = argv[i++];
+  int left = argc - i;
+
+  MeArmClient arm;
+  if (!arm.open(device, baud)) return 1;
+
+  int result;
+  if (command == "ping") {
+    result = runPing(arm, left > 0 ? atoi(argv[i]) : 100);
+  } else if (command == "state") {
+    result = runState(arm);
+  } else if (command == "enable" && left == SERIAL_JOINTS) {
+    result = runEnable(arm, argv + i);
+  } else if (command == "set" && left == SERIAL_JOINTS) {
+    result = runSet(arm, argv + i);
+  } else if (command == "stream" && left == 2) {
+    result = runStream(arm, atof(argv[i]), atof(argv[i + 1]));
+  } else if (command == "upload" && (left == 1 || left == 2)) {
+    result = runUpload(arm, argv[i], left == 2 ? argv[i + 1] : nullptr);
+  } else {
+    return usage();
+  }
+  if (arm.frameErrors()) fprintf(stderr, "%u bad frames received\n", arm.frameErrors());
+  return result;
+}
@@ -0,0 +1,186 @@
+#ifndef ARM_CONTROLLER_H
+#define ARM_CONTROLLER_H
+
+#include <Arduino.h>
+#include "MotionTask.h"
+#include "PoseBuffer.h"
+#include "SequenceStore.h"
+#include "Keyframes.h"
+#include "Kinematics.h"
+
+// Outcome of a controller operation. The transport (HTTP, WebSocket, ...)
+// decides how to report it.
+enum ArmStatus : uint8_t {
+  ARM_OK,
+  ARM_BUSY,          // Playback (or recording) in progress
+  ARM_QUEUE_FULL,    // Motion queue full; the command was dropped
+  ARM_INVALID,       // Bad argument
+  ARM_NOT_FOUND,     // No such stored sequence
+  ARM_NOT_ENABLED,   // A joint the operation needs is disabled
+  ARM_OUT_OF_REACH,  // No IK solution
+  ARM_EMPTY,         // Nothing recorded
+  ARM_TOO_LARGE,     // Stored sequence doesn't fit in RAM
+  ARM_STORAGE_ERROR, // Flash write failed
+  ARM_UNSAFE,        // Shoulder/elbow outside the collision envelope (Envelope.h)
+};
+
+enum RecordEvent : uint8_t {
+  RECORD_STARTED,
+  RECORD_STOPPED,
+  RECORD_MUST_DELETE_FIRST,
+};
+
+// Everything the web handlers used to do inline, without any knowledge of
+// WebServer: commanded positions, enable flags, home positions, recording,
+// keyframe reduction, the sequence library and playback sequencing. Not
+// thread-safe: callers take turns (main.cpp's ArmLock), which also keeps the
+// motion queue down to one producer at a time.
+class ArmController {
+public:
+  static const size_t STATE_JSON_SIZE = 384; // Enough for stateJson()
+  static constexpr float MIN_PLAY_SPEED = 0.1f;
+  static constexpr float MAX_PLAY_SPEED = 3.0f;
+  static const uint16_t JOG_DEADMAN_MS = 300;
+
+  ArmController(MotionTask& motion, SequenceStore& store);
+
+  // Loads persisted settings; call once the filesystem is mounted
+  void begin();
+  // Playback sequencing; call regularly from the network task
+  void update();
+
+  // Sends an enabled joint towards pos (clamped to 0-180) and records the
+  // resulting pose if recording. Disabled joints are ignored. A shoulder or
+  // elbow move stops at the edge of the collision envelope.
+  ArmStatus setJoint(JointId joint, int pos);
+  // Like setJoint(), these change nothing and return ARM_QUEUE_FULL when the
+  // motion queue can't take every command they need; so do play() and
+  // runProgram(), which enable every joint for the duration.
+  ArmStatus toggleJoint(JointId joint, bool& nowEnabled);
+  ArmStatus goHome();
+  // ARM_UNSAFE if the home pose is outside the collision envelope
+  ArmStatus saveHome(const int newHome[JOINT_COUNT]);
+  // Moves the gripper tip; returns the servo angles through `out`. IK
+  // solutions outside the collision envelope, or that the arm would leave
+  // it on the way to, are ARM_UNSAFE.
+  ArmStatus moveXYZ(const ArmPoint& target, int out[JOINT_COUNT]);
+
+  // Mirroring (Mirror.h): heads every enabled joint in `mask` towards
+  // targets[] at the speed that gets it there in `periodSec` (at most the
+  // slider speed), so targets streamed once a period make one continuous
+  // motion. A pose outside the collision envelope is moved to the nearest
+  // allowed one. Recorded like slider moves.
+  ArmStatus track(const int targets[JOINT_COUNT], uint8_t mask, float periodSec);
+
+  // Teleoperation: runs each enabled joint at velocities[] deg/s, ramping
+  // within the motion engine's speed and acceleration limits and braking
+  // for the collision envelope. Clients repeat the
+  // command at least every JOG_DEADMAN_MS; when they stop, the joints ramp
+  // down to a stop. A 0 stops that joint the same way. Recorded like slider
+  // moves, one pose per command.
+  ArmStatus jog(const float velocities[JOINT_COUNT]);
+  bool jogging() const { return jogMask != 0; }
+
+  RecordEvent toggleRecording();
+  // Clears the recording (stopping playback and recording); returns true if
+  // recording was active
+  bool deleteRecording();
+  // Re-runs keyframe reduction; tolerances of nullptr keeps the current ones
+  ArmStatus compressRecording(const float* tolerance, KeyframeStats& stats);
+
+  // name == nullptr plays the recording, otherwise streams a stored
+  // sequence. It runs `loops` times (0 = until stopped); speed scales the
+  // joint speed limits and shortens the pause between poses to match. Where
+  // the straight move between two poses would leave the collision
+  // envelope, the arm goes round one joint at a time; if neither order is
+  // clear, playback stops there.
+  ArmStatus play(const char* name, uint16_t loops = 1, float speed = 1);
+  // Pose playback only (a program can only be stopped). Pausing holds the
+  // arm within one motion tick; resuming finishes the interrupted move.
+  ArmStatus pause();
+  ArmStatus resume();
+  // Ends pose playback or a program, holding the arm within one motion tick.
+  // ARM_NOT_FOUND if nothing is playing.
+  ArmStatus stop();
+  // Takes effect from the next pose (clamped to MIN/MAX_PLAY_SPEED)
+  ArmStatus setPlaySpeed(float speed);
+  ArmStatus saveSequence(const char* name);
+  ArmStatus loadSequence(const char* name);
+  ArmStatus deleteSequence(const char* name);
+  // Sequence upload (SerialLink.h): replaces the recording pose by pose.
+  // Poses are checked like a motion program's: ARM_INVALID past 180
+  // degrees, ARM_UNSAFE outside the collision envelope, ARM_TOO_LARGE once
+  // the buffer is full.
+  ArmStatus beginUpload();
+  ArmStatus uploadPose(const PackedPose& pose);
+
+  // Parses a motion program (see MotionProgram.h) and runs it on the motion
+  // task; counts as playback until it ends. ARM_INVALID fills `error`.
+  ArmStatus runProgram(const char* text, ProgramError& error);
+  ArmStatus stopProgram();
+
+  // JSON for /state and the event stream
+  size_t stateJson(char* json, size_t len) const;
+  void playProgress(uint32_t& done, uint32_t& total) const;
+
+  int position(JointId joint) const { return pos[joint]; }
+  int home(JointId joint) const { return homePos[joint]; }
+  bool enabled(JointId joint) const { return jointEnabled[joint]; }
+  float tolerance(JointId joint) const { return keyframeTolerance[joint]; }
+  bool recording() const { return isRecording; }
+  bool playing() const { return isPlaying; }
+  bool paused() const { return playPaused; }
+  float playSpeed() const { return playSpeedScale; }
+  const PoseBuffer& recordedSequence() const { return recorded; }
+  SequenceStore& sequenceStore() { return store; }
+  // Slider moves cut short, poses moved back inside the envelope and
+  // playback moves sent round it
+  uint32_t envelopeCorrections() const { return corrections; }
+
+private:
+  MotionTask& motion;
+  SequenceStore& store;
+
+  // Commanded positions (the motion task walks the servos towards these)
+  int pos[JOINT_COUNT];
+  int homePos[JOINT_COUNT];
+  bool jointEnabled[JOINT_COUNT];
+
+  // Recorded sequence of poses (fixed capacity, see PoseBuffer.h)
+  PoseBuffer recorded;
+  bool isRecording;
+  uint8_t jogMask; // Jogged joints; their pos[] follows the motion task until it stops
+  // When recording stops, poses within this many degrees of the straight
+  // line between their neighbours are dropped
+  float keyframeTolerance[JOINT_COUNT];
+
+  // Playback runs one pose at a time, either from `recorded` or streamed
+  // from a stored sequence
+  bool isPlaying;
+  size_t playIndex;
+  SequenceReader playReader;
+  bool playDwelling;
+  unsigned long playDwellStart;
+  bool tempEnabled[JOINT_COUNT]; // Joints playback had to attach
+  bool playProgram;              // Playing a motion program rather than poses
+  bool playPaused;
+  uint16_t playLoops;            // 0 = until stopped
+  uint16_t playLoop;             // Loops finished so far
+  float playSpeedScale;
+  int playTargets[JOINT_COUNT];  // Pose being moved to, for resume()
+  int playVia[JOINT_COUNT];      // Corner of a detour round the envelope, see update()
+  bool playDetour;               // Heading for playVia; playTargets comes next
+  uint32_t corrections;
+
+  int limitToEnvelope(JointId joint, int target) const;
+  void syncJog();
+  bool projectToEnvelope(int targets[JOINT_COUNT]);
+  bool lineAllowed(const int targets[JOINT_COUNT]) const;
+  void recordPose();
+  bool readPlayPose(PackedPose& pose);
+  bool startPlayback(size_t commands);
+  void finishPlayback(bool interrupted);
+  void stopPlayback();
+};
+
+#endif // ARM_CONTROLLER_H
@@ -0,0 +1,58 @@
+#ifndef BLEND_PATH_H
+#define BLEND_PATH_H
+
+#include <Arduino.h>
+#include "MotionEngine.h"
+
+// Multi-waypoint joint-space path with parabolic blends (LSPB): straight
+// constant-velocity segments between waypoints, joined by constant
+// acceleration blends centred on each intermediate waypoint. The arm starts
+// and ends at rest but never stops at the waypoints in between; it cuts each
+// corner by an amount that grows with the speed change there.
+//
+// Every joint shares the same segment and blend timing, so the joints stay
+// coordinated along the whole path. plan() looks ahead over all waypoints
+// and slows down any segment too short for the blends at its two ends.
+class BlendPath {
+public:
+  static const uint8_t MAX_POINTS = 64;
+
+  BlendPath();
+
+  void clear();
+  // Adds a waypoint; speedCap (deg/s, 0 for none) limits the segment that
+  // ends there. Returns false if the path is full.
+  bool addPoint(const int16_t target[JOINT_COUNT], float speedCap);
+  uint8_t size() const { return count; }
+
+  // Times the path from `start` through every waypoint within the per-joint
+  // limits; returns the total duration in seconds
+  float plan(const float start[JOINT_COUNT], const float maxSpeed[JOINT_COUNT],
+             const float maxAccel[JOINT_COUNT]);
+  float duration() const { return total; }
+
+  // Joint positions at time t after the start (clamped to [0, duration]).
+  // Cheapest when t only moves forwards, as it does when ticking.
+  void positionAt(float t, float out[JOINT_COUNT]) const;
+  // Final waypoint
+  void end(float out[JOINT_COUNT]) const;
+
+private:
+  // Point 0 is the start; waypoints are 1..count. Segment k runs from
+  // point k to point k+1.
+  float point[MAX_POINTS + 1][JOINT_COUNT];
+  float cap[MAX_POINTS + 1];              // Speed cap of segment k (stored at k)
+  float segTime[MAX_POINTS];              // Duration of segment k
+  float velocity[MAX_POINTS][JOINT_COUNT]; // Constant velocity of segment k
+  float viaTime[MAX_POINTS + 1];          // When the path passes point i
+  float blendTime[MAX_POINTS + 1];        // Blend length centred on viaTime[i]
+  uint8_t count;                          // Waypoints, not counting the start
+  uint8_t segments;                       // After dropping repeated points
+  float total;
+  mutable uint8_t cursor;                 // Last blend positionAt() was in
+
+  float segmentVelocity(int k, uint8_t joint) const;
+  void computeBlends(const float maxAccel[JOINT_COUNT]);
+};
+
+#endif // BLEND_PATH_H
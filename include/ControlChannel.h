@@ -0,0 +1,70 @@
+#ifndef CONTROL_CHANNEL_H
+#define CONTROL_CHANNEL_H
+
+#include <Arduino.h>
+#include "MotionEngine.h"
+
+// Binary slider frames received over the WebSocket. Every frame is
+// CONTROL_FRAME_SIZE bytes, little-endian:
+//   [0]    joint id (JointId)
+//   [1..2] position in tenths of a degree (0-1800)
+//   [3..4] sequence number, incremented by the client for every frame
+//
+// Only the newest target per joint is kept: frames whose sequence number is
+// not newer than the last one seen from that client for that joint are
+// dropped, and a pending target that hasn't been applied yet is simply
+// overwritten. However fast the user drags, at most one target per joint
+// waits to be applied.
+//
+// Jog frames (velocity mode, see ArmController::jog) are JOG_FRAME_SIZE
+// bytes:
+//   [0]     JOG_FRAME_TAG
+//   [1..8]  velocity per joint, signed tenths of a degree per second
+//   [9..10] sequence number, counted separately from slider frames
+// Clients resend them while a jog control is held, often enough to beat
+// the dead-man timeout; the newest one wins. When the client that sent the
+// last jog disconnects, a stop is queued straight away.
+const size_t CONTROL_FRAME_SIZE = 5;
+const size_t JOG_FRAME_SIZE = 11;
+const uint8_t JOG_FRAME_TAG = 'J';
+
+class ControlChannel {
+public:
+  static const uint8_t MAX_CLIENTS = 5; // Slider connections at once
+
+  ControlChannel();
+
+  // Clients are identified by the WebSocket server's connection id. connect()
+  // gives one a slot with fresh sequence numbers; false if all are taken.
+  bool connect(uint32_t client);
+  void disconnect(uint32_t client);
+  // Returns false if the frame was malformed, stale or from an unknown client
+  bool accept(uint32_t client, const uint8_t* frame, size_t length);
+  // Takes the pending target for a joint, if any (whole degrees)
+  bool takePending(JointId joint, int& position);
+  // Takes the pending jog velocities, if any (deg/s)
+  bool takeJog(float velocities[JOINT_COUNT]);
+
+  uint32_t acceptedCount() const { return accepted; }
+  uint32_t droppedCount() const { return dropped; }
+
+private:
+  bool used[MAX_CLIENTS];
+  uint32_t clientIds[MAX_CLIENTS];
+  uint16_t lastSeq[MAX_CLIENTS][JOINT_COUNT];
+  bool haveSeq[MAX_CLIENTS][JOINT_COUNT];
+  int pending[JOINT_COUNT];
+  bool hasPending[JOINT_COUNT];
+  uint16_t lastJogSeq[MAX_CLIENTS];
+  bool haveJogSeq[MAX_CLIENTS];
+  int16_t jogPending[JOINT_COUNT]; // Tenths of a deg/s
+  bool hasJogPending;
+  int jogSlot; // Client that sent the newest jog, or -1
+  uint32_t accepted;
+  uint32_t dropped;
+
+  int slotFor(uint32_t client) const;
+  bool acceptJog(int slot, const uint8_t* frame);
+};
+
+#endif // CONTROL_CHANNEL_H
@@ -0,0 +1,29 @@
+#ifndef ENVELOPE_H
+#define ENVELOPE_H
+
+#include <Arduino.h>
+
+// Shoulder/elbow combinations that keep the arm clear of the table and its
+// own base, looked up in a bitmap generated at build time from the geometry
+// in Kinematics.h (tools/build_envelope.py). Angles are whole servo degrees;
+// anything outside 0-180 is not allowed.
+
+// Constant time: one bit lookup
+bool envelopeAllows(int shoulder, int elbow);
+
+// Whether every pose on the straight line between two pairs is allowed, as
+// the servos see it: each whole-degree cell the line passes through once
+// positions are rounded. A coordinated move (MotionEngine::moveTo) follows
+// this line. Costs one lookup per cell crossed, at most 361.
+bool envelopeAllowsLine(int fromShoulder, int fromElbow, int toShoulder, int toElbow);
+
+// For a line that leaves the envelope, a corner to go through instead: one
+// joint moved first, then the other, each leg allowed. Returns false if
+// neither order works.
+bool envelopeDetour(int fromShoulder, int fromElbow, int toShoulder, int toElbow, int& viaShoulder, int& viaElbow);
+
+// Moves a pair to the nearest allowed one (straight-line distance in
+// degrees). Returns false if it was already allowed.
+bool envelopeProject(int& shoulder, int& elbow);
+
+#endif // ENVELOPE_H
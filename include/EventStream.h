@@ -0,0 +1,47 @@
+#ifndef EVENT_STREAM_H
+#define EVENT_STREAM_H
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+
+// Server-Sent Events for every open page (/events). AsyncEventSource keeps
+// the client list and formats a message once for all of them; this adds the
+// rate limit and skips snapshots identical to the previous one. The
+// heartbeat is not an SSE comment: after HEARTBEAT_MS without a change the
+// whole last frame (a few hundred bytes) goes out again, which keeps idle
+// connections open and costs the same as any other frame.
+class EventStream {
+public:
+  static const uint32_t HEARTBEAT_MS = 15000;
+  static const uint32_t RETRY_MS = 1000; // Reconnect delay sent to new clients
+
+  EventStream(const char* url, uint16_t rateHz);
+
+  // Register with the server: server.addHandler(&events.source())
+  AsyncEventSource& source() { return src; }
+  void setRate(uint16_t rateHz);
+  size_t clientCount() const { return src.count(); }
+
+  // True when the rate allows another frame and someone is listening;
+  // build the payload only then
+  bool due(uint32_t nowMs) const;
+  // Sends `data` as an `event` frame to every client, unless it's the same
+  // as the last one and the heartbeat isn't due; a heartbeat resends it
+  void publish(const char* event, const char* data, uint32_t nowMs);
+  // Sends the latest frame to a client that just connected, so the page
+  // doesn't wait for the next change
+  void replay(AsyncEventSourceClient* client);
+
+  uint32_t framesSent() const { return frames; }
+
+private:
+  AsyncEventSource src;
+  uint32_t intervalMs;
+  uint32_t lastPublishMs;
+  uint32_t lastSendMs;
+  const char* lastEvent;
+  char lastData[448];
+  uint32_t frames;
+};
+
+#endif // EVENT_STREAM_H
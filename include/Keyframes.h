@@ -0,0 +1,20 @@
+#ifndef KEYFRAMES_H
+#define KEYFRAMES_H
+
+#include <Arduino.h>
+#include "PoseBuffer.h"
+
+struct KeyframeStats {
+  size_t before;
+  size_t after;
+  float ratio() const { return after ? (float)before / after : 1.0f; }
+};
+
+// Ramer-Douglas-Peucker in joint space: drops every pose that lies within
+// tolerance[j] degrees (per joint, scaled to a unit ellipsoid) of the
+// straight line between the keyframes around it. Works in place without
+// allocating; the first and last poses are always kept and the delta
+// timestamps of dropped poses are folded into the next keyframe.
+KeyframeStats compressKeyframes(PoseBuffer& poses, const float tolerance[JOINT_COUNT]);
+
+#endif // KEYFRAMES_H
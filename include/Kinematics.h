@@ -0,0 +1,56 @@
+#ifndef KINEMATICS_H
+#define KINEMATICS_H
+
+#include <Arduino.h>
+
+// Inverse/forward kinematics for the MeArm, in integer fixed point so a solve
+// is a few table lookups and multiplies instead of libm calls.
+//
+// Units: lengths in tenths of a millimetre, angles in centidegrees, ratios
+// (sin, cos) in Q16 (65536 = 1.0).
+//
+// Frame: origin on the table under the base axis, +y straight ahead (base
+// servo at 90), +x to the right, +z up. The point being positioned is the
+// gripper tip.
+
+// Arm geometry - measure your own arm and adjust
+const int32_t ARM_SHOULDER_HEIGHT = 500; // Table to shoulder pivot
+const int32_t ARM_UPPER_LENGTH = 800;    // Shoulder pivot to elbow pivot
+const int32_t ARM_FOREARM_LENGTH = 800;  // Elbow pivot to wrist
+const int32_t ARM_GRIPPER_LENGTH = 680;  // Wrist to gripper tip (held level by the linkage)
+
+// Servo mapping (centidegrees). The shoulder servo angle is the upper arm's
+// elevation above horizontal; thanks to the MeArm's parallel linkage the
+// elbow servo sets the forearm's absolute angle, horizontal at
+// ARM_ELBOW_LEVEL.
+const int32_t ARM_ELBOW_LEVEL = 9000;
+
+// Collision envelope, used by tools/build_envelope.py to generate the
+// shoulder/elbow bitmap in EnvelopeTable.h (see Envelope.h). Lengths in
+// tenths of a millimetre, angles in centidegrees.
+const int32_t ARM_TABLE_CLEARANCE = 50; // Lowest any part of the arm may go
+const int32_t ARM_BASE_RADIUS = 450;    // Base housing, a cylinder round the base axis...
+const int32_t ARM_BASE_TOP = 420;       // ...this tall
+const int32_t ARM_LINK_MIN_ANGLE = 3500; // Upper arm to forearm, folded up
+const int32_t ARM_LINK_MAX_ANGLE = 17000; // Upper arm to forearm, stretched out
+
+struct ArmPoint {
+  int32_t x, y, z; // Tenths of a millimetre
+};
+
+struct ArmAngles {
+  int32_t base, shoulder, elbow; // Servo angles, centidegrees
+};
+
+// Fixed-point trig
+int32_t sinQ16(int32_t centideg);
+int32_t cosQ16(int32_t centideg);
+int32_t atan2Centideg(int32_t y, int32_t x); // -18000..18000
+int32_t acosCentideg(int32_t cosQ16);        // 0..18000
+uint32_t isqrt64(uint64_t v);
+
+// False if the point is out of reach or needs a servo outside 0-180
+bool solveIK(const ArmPoint& target, ArmAngles& out);
+void forwardKinematics(const ArmAngles& angles, ArmPoint& out);
+
+#endif // KINEMATICS_H
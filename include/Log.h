@@ -0,0 +1,140 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include <Arduino.h>
+
+// Deferred logging. LOG_INFO("Pose recorded. Sequence size: %u", n) copies
+// the format pointer and up to LOG_MAX_ARGS arguments into a fixed-size
+// record and pushes it onto a lock-free ring; a low-priority task formats
+// the records and writes them out. A call costs well under a microsecond,
+// never allocates and never waits for the UART.
+//
+// Formats must be string literals (only the pointer is kept). Arguments
+// may be integers, floats, bools or C strings; strings are copied, up to
+// LOG_TEXT_SIZE bytes per record in total. Length modifiers (%lu, %zu) are
+// accepted and ignored.
+//
+// When the ring is full the record is dropped and counted. Each call site
+// is also limited to LOG_SITE_RATE records a second, so a message in a hot
+// path can't crowd out the rest.
+
+enum LogLevel : uint8_t {
+  LOG_LEVEL_DEBUG,
+  LOG_LEVEL_INFO,
+  LOG_LEVEL_WARN,
+  LOG_LEVEL_ERROR,
+};
+
+// Calls below this level are compiled out (build_flags in platformio.ini)
+#ifndef MEARM_LOG_LEVEL
+#define MEARM_LOG_LEVEL LOG_LEVEL_INFO
+#endif
+
+const uint8_t LOG_MAX_ARGS = 4;
+const uint8_t LOG_TEXT_SIZE = 28;  // Room for a sequence name
+const uint16_t LOG_SITE_RATE = 20; // Records per second per call site
+const size_t LOG_RING_SIZE = 64;   // Power of two
+
+enum LogArgType : uint8_t {
+  LOG_ARG_INT,
+  LOG_ARG_UINT,
+  LOG_ARG_FLOAT,
+  LOG_ARG_STR, // Value is an offset into text
+};
+
+// 56 bytes
+struct LogRecord {
+  uint32_t timeMs;
+  const char* fmt;
+  LogLevel level;
+  uint8_t argCount;
+  uint8_t argTypes; // 2 bits per argument, first in the low bits
+  uint8_t textUsed;
+  uint32_t args[LOG_MAX_ARGS];
+  char text[LOG_TEXT_SIZE];
+};
+
+// Per call site rate limit state; the macros declare one static per call
+struct LogSite {
+  uint32_t windowStartMs;
+  uint16_t count;
+};
+
+// Receives each formatted line (with its newline). The default writes to
+// Serial; another transport can take over the UART (see logSetSink).
+typedef void (*LogSink)(const char* line, size_t len);
+
+// Starts the drain task. Records logged before are kept and written then.
+void logBegin();
+// Formats and writes everything queued, then reports records lost since the
+// last report. The drain task calls it; only one caller at a time.
+void logFlush();
+void logSetLevel(LogLevel level);
+// nullptr restores the default
+void logSetSink(LogSink sink);
+
+uint32_t logRecordsWritten();
+uint32_t logRecordsDropped();     // Ring full
+uint32_t logRecordsRateLimited(); // Over LOG_SITE_RATE at their call site
+
+// Formats a record as one line; returns its length (without the terminator)
+size_t logFormat(const LogRecord& rec, char* out, size_t len);
+
+// --- Internals used by the macros ---
+bool logAdmit(LogSite& site, LogLevel level, uint32_t nowMs);
+void logPush(const LogRecord& rec);
+
+inline void logPackArg(LogRecord& rec, LogArgType type, uint32_t value) {
+  rec.argTypes |= type << (2 * rec.argCount);
+  rec.args[rec.argCount++] = value;
+}
+inline void logArg(LogRecord& rec, int v) { logPackArg(rec, LOG_ARG_INT, (uint32_t)v); }
+inline void logArg(LogRecord& rec, long v) { logPackArg(rec, LOG_ARG_INT, (uint32_t)v); }
+inline void logArg(LogRecord& rec, unsigned v) { logPackArg(rec, LOG_ARG_UINT, v); }
+inline void logArg(LogRecord& rec, unsigned long v) { logPackArg(rec, LOG_ARG_UINT, (uint32_t)v); }
+inline void logArg(LogRecord& rec, bool v) { logPackArg(rec, LOG_ARG_UINT, v); }
+inline void logArg(LogRecord& rec, double v) {
+  float f = (float)v;
+  uint32_t bits;
+  memcpy(&bits, &f, sizeof(bits));
+  logPackArg(rec, LOG_ARG_FLOAT, bits);
+}
+void logArg(LogRecord& rec, const char* s);
+
+inline void logArgs(LogRecord&) {}
+template <typename T, typename... Rest>
+void logArgs(LogRecord& rec, T first, Rest... rest) {
+  logArg(rec, first);
+  logArgs(rec, rest...);
+}
+
+template <typename... Args>
+void logWrite(LogSite& site, LogLevel level, const char* fmt, Args... args) {
+  static_assert(sizeof...(Args) <= LOG_MAX_ARGS, "Too many log arguments");
+  uint32_t now = millis();
+  if (!logAdmit(site, level, now)) return;
+  LogRecord rec;
+  rec.timeMs = now;
+  rec.fmt = fmt;
+  rec.level = level;
+  rec.argCount = 0;
+  rec.argTypes = 0;
+  rec.textUsed = 0;
+  logArgs(rec, args...);
+  logPush(rec);
+}
+
+#define MEARM_LOG(level, ...)                     \
+  do {                                            \
+    if ((level) >= MEARM_LOG_LEVEL) {             \
+      static LogSite logSite_ = {0, 0};           \
+      logWrite(logSite_, (level), __VA_ARGS__);   \
+    }                                             \
+  } while (0)
+
+#define LOG_DEBUG(...) MEARM_LOG(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#define LOG_INFO(...) MEARM_LOG(LOG_LEVEL_INFO, __VA_ARGS__)
+#define LOG_WARN(...) MEARM_LOG(LOG_LEVEL_WARN, __VA_ARGS__)
+#define LOG_ERROR(...) MEARM_LOG(LOG_LEVEL_ERROR, __VA_ARGS__)
+
+#endif // LOG_H
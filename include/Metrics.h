@@ -0,0 +1,106 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <Arduino.h>
+
+// Build with -DMEARM_METRICS=0 (build_flags in platformio.ini) to compile
+// the instrumentation and the /metrics route out
+#ifndef MEARM_METRICS
+#define MEARM_METRICS 1
+#endif
+
+// Fixed-bucket histogram of durations in microseconds. observe() is a few
+// compares and two adds, no allocation. A single task writes to it; readers
+// on another core may see a bucket and the count one observation apart,
+// which is fine for monitoring.
+class LatencyHistogram {
+public:
+  static const uint8_t BUCKETS = 10; // Last one is +Inf
+  static const uint32_t BOUNDS_US[BUCKETS - 1];
+
+  LatencyHistogram();
+
+  void observe(uint32_t us);
+
+  uint32_t bucketCount(uint8_t bucket) const { return counts[bucket]; }
+  uint32_t count() const { return total; }
+  uint64_t sumUs() const { return sum; }
+  uint32_t maxUs() const { return largest; }
+
+private:
+  uint32_t counts[BUCKETS]; // Per bucket, not cumulative
+  uint32_t total;
+  uint64_t sum;
+  uint32_t largest;
+};
+
+// Average rate of a free-running counter between two samples
+class RateMeter {
+public:
+  RateMeter() : lastTotal(0), lastMs(0), started(false), rate(0) {}
+
+  // Returns the rate since the previous sample, per second
+  float sample(uint32_t total, uint32_t nowMs);
+
+private:
+  uint32_t lastTotal;
+  uint32_t lastMs;
+  bool started;
+  float rate;
+};
+
+// Prometheus text exposition format, built a few hundred bytes at a time
+// and handed to `flush` (e.g. AsyncResponseStream::write) as the buffer
+// fills.
+class MetricsWriter {
+public:
+  typedef void (*FlushFn)(const char* data, size_t len, void* ctx);
+
+  MetricsWriter(FlushFn flushFn, void* ctx) : flushFn(flushFn), ctx(ctx), used(0) {}
+
+  void printf(const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+  void flush();
+
+  void gauge(const char* name, const char* help, float value);
+  void counter(const char* name, const char* help, uint32_t value);
+  // labels is e.g. "route=\"/state\"" or nullptr; writeHeader is false for
+  // the second and later series of the same metric
+  void histogram(const char* name, const char* help, const char* labels,
+                 const LatencyHistogram& hist, bool writeHeader = true);
+
+private:
+  FlushFn flushFn;
+  void* ctx;
+  char buf[512];
+  size_t used;
+};
+
+// Per-route handler latency, recorded on the AsyncTCP task under the arm
+// lock, and network loop timing, recorded by the network task. Gauges that
+// belong to other modules (heap, motion queue, servo writes) are written by
+// the /metrics handler itself.
+class Metrics {
+public:
+  static const uint8_t MAX_ROUTES = 24;
+
+  Metrics();
+
+  // Returns the id to pass to observeRoute(), or -1 once MAX_ROUTES are in use
+  int addRoute(const char* path);
+  void observeRoute(int id, uint32_t us);
+  // Call once per pass of the network loop
+  void loopPass(uint32_t nowUs);
+
+  void write(MetricsWriter& out) const;
+
+private:
+  const char* routePaths[MAX_ROUTES];
+  LatencyHistogram routeLatency[MAX_ROUTES];
+  uint8_t routeCount;
+
+  LatencyHistogram loopPeriod;
+  uint32_t lastLoopUs;
+  bool loopStarted;
+};
+
+#endif // METRICS_H
@@ -0,0 +1,127 @@
+#ifndef MIRROR_H
+#define MIRROR_H
+
+#include <Arduino.h>
+#include "MotionEngine.h"
+
+// Leader/follower mirroring for several arms on one network. The leader
+// multicasts its joint positions at a fixed rate; followers move their own
+// joints along the same path. This class is the protocol and the follower's
+// timing; main.cpp owns the UDP socket.
+//
+// Packet, MIRROR_PACKET_SIZE bytes, little-endian:
+//   [0..1]   magic 'M' 'R'
+//   [2]      version
+//   [3]      enabled joints (bit per JointId)
+//   [4..7]   leader id, random per leader session
+//   [8..11]  sequence number, +1 per packet
+//   [12..15] leader clock when sampled (micros())
+//   [16..19] joint positions, degrees
+//
+// Followers lock onto one leader and drop packets whose sequence number is
+// not newer than the newest one seen, so duplicates and packets overtaken
+// on the way never move the arm backwards. Each sample is placed on the
+// leader's timeline by its timestamp: the follower learns the clock offset
+// from the fastest packets and renders the path a fixed playout delay
+// (about two periods plus PLAYOUT_MARGIN_US) behind the leader, interpolating
+// between the two samples around that point. Variable network delay
+// therefore becomes a constant lag instead of jerky motion. When packets
+// are late the path is extrapolated for up to MAX_EXTRAPOLATE_US, then
+// held.
+const size_t MIRROR_PACKET_SIZE = 20;
+const uint8_t MIRROR_VERSION = 1;
+
+enum MirrorMode : uint8_t {
+  MIRROR_OFF,
+  MIRROR_LEADER,
+  MIRROR_FOLLOWER,
+};
+
+class Mirror {
+public:
+  static const uint8_t HISTORY = 8;                   // Samples kept by a follower
+  static const uint32_t PLAYOUT_MARGIN_US = 10000;    // Jitter allowance on top of the leader's period
+  static const uint32_t MAX_EXTRAPOLATE_US = 60000;
+  static const uint32_t LEADER_TIMEOUT_US = 500000;   // Then another leader may take over
+  static const uint32_t OFFSET_WINDOW_US = 2000000;   // Clock offset is re-learnt this often
+
+  explicit Mirror(uint16_t rateHz);
+
+  // leaderId identifies our own packets in leader mode
+  void setMode(MirrorMode mode, uint32_t leaderId);
+  void setRate(uint16_t rateHz);
+  MirrorMode mode() const { return currentMode; }
+  uint16_t rate() const { return rateHz; }
+  uint32_t periodUs() const { return intervalUs; }
+
+  // True once per period: the leader sends a packet, the follower commands
+  // its joints
+  bool due(uint32_t nowUs);
+
+  // Leader: fills `out` with the next packet
+  size_t encode(const int positions[JOINT_COUNT], uint8_t enabled, uint32_t nowUs, uint8_t* out);
+
+  // Follower: returns true if the packet was accepted
+  bool receive(const uint8_t* data, size_t len, uint32_t nowUs);
+  // Where the joints should be one period from now, and which the leader
+  // has enabled. False without a live leader.
+  bool target(uint32_t nowUs, int out[JOINT_COUNT], uint8_t& enabled);
+
+  bool following() const { return haveLeader; }
+  uint32_t leader() const { return leaderId; }
+  uint32_t packetsSent() const { return sent; }
+  uint32_t packetsAccepted() const { return accepted; }
+  uint32_t packetsStale() const { return stale; } // Late or duplicate
+  uint32_t packetsLost() const { return lost; }   // Sequence gaps
+  uint32_t packetsInvalid() const { return invalid; } // Malformed, or from a second leader
+  uint32_t extrapolations() const { return extrapolated; }
+  // Arrival delay of the last packet beyond the fastest recent one
+  uint32_t lastJitterUs() const { return jitterUs; }
+  // How far behind the leader a follower renders the path: a leader period
+  // for the next sample to arrive, one of ours since each target is where
+  // to be a period later, and the jitter margin
+  uint32_t playoutUs() const { return leaderPeriodUs + intervalUs + PLAYOUT_MARGIN_US; }
+
+private:
+  struct Sample {
+    uint32_t timeUs; // Leader clock
+    uint8_t pos[JOINT_COUNT];
+  };
+
+  MirrorMode currentMode;
+  uint16_t rateHz;
+  uint32_t intervalUs;
+  uint32_t lastDueUs;
+  uint32_t ownId;
+  uint32_t nextSeq;
+
+  bool haveLeader;
+  uint32_t leaderId;
+  uint32_t newestSeq;
+  uint32_t lastHeardUs;
+  uint8_t leaderEnabled;
+  uint32_t leaderPeriodUs;
+  Sample history[HISTORY]; // Ring, oldest first from `oldest`
+  uint8_t oldest;
+  uint8_t count;
+
+  // Offset between the clocks as seen through the network, relative to the
+  // first packet's (recv - sent) so the arithmetic stays small
+  uint32_t offsetBase;
+  int32_t windowMin;
+  int32_t previousMin;
+  uint32_t windowStartUs;
+
+  uint32_t sent;
+  uint32_t accepted;
+  uint32_t stale;
+  uint32_t lost;
+  uint32_t invalid;
+  uint32_t extrapolated;
+  uint32_t jitterUs;
+
+  void resetFollower();
+  const Sample& sample(uint8_t i) const { return history[(oldest + i) % HISTORY]; }
+};
+
+#endif // MIRROR_H
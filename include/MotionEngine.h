@@ -0,0 +1,124 @@
+#ifndef MOTION_ENGINE_H
+#define MOTION_ENGINE_H
+
+#include <Arduino.h>
+#include "Trajectory.h"
+
+class BlendPath;
+class ServoDriver;
+
+// Joint ids, in the same order the web interface lists them
+enum JointId : uint8_t {
+  JOINT_BASE = 0,
+  JOINT_SHOULDER,
+  JOINT_ELBOW,
+  JOINT_GRIPPER,
+  JOINT_COUNT
+};
+
+// Holds a target for every joint and walks the servos towards them from a
+// fixed-rate tick, so callers never have to wait for a move to finish.
+// update() runs the tick whenever one is due. In the firmware MotionTask
+// owns the engine and is the only caller of update() (on core 1); anything
+// else goes through the task's command queue, since calling the engine
+// directly would race the motion task.
+//
+// Joints either follow their own target at a fixed speed (setTarget, used for
+// sliders) or take part in a synchronized segment (moveTo), where every joint
+// runs a trapezoidal profile stretched so that all of them start and finish
+// together. A BlendPath (followPath) is a third mode: all joints follow a
+// multi-waypoint path with blended corners. Jogging (jog) is the fourth:
+// joints follow commanded velocities, integrated every tick within the
+// acceleration limits.
+class MotionEngine {
+public:
+  static const uint32_t TICK_INTERVAL_US = 5000; // 200 Hz control rate
+  static const uint8_t MAX_CATCH_UP_TICKS = 4;   // Beyond this we resync instead of bursting
+
+  MotionEngine();
+
+  // Every tick's positions go to `driver`, all joints at once
+  void setDriver(ServoDriver* driver);
+  // Where the joint is assumed to be at start-up
+  void setStartPosition(JointId joint, int position);
+  // Starts or stops the joint's servo pulses
+  void setEnabled(JointId joint, bool enabled);
+
+  // Sets a new target (0-180) and the speed in degrees per second used to reach it
+  void setTarget(JointId joint, int target, float speedDegPerSec);
+  // Stops the joint where it is
+  void hold(JointId joint);
+
+  // Per-joint limits used by moveTo()
+  void setLimits(JointId joint, float maxSpeedDegPerSec, float maxAccelDegPerSec2);
+  float maxSpeed(JointId joint) const { return joints[joint].maxSpeed; }
+  float maxAccel(JointId joint) const { return joints[joint].maxAccel; }
+  // Coordinated move of all joints to targets[JOINT_COUNT]; returns the
+  // planned segment duration in seconds. speedScale multiplies the speed
+  // limits (and the acceleration limits by its square), so the move takes
+  // 1/speedScale as long.
+  float moveTo(const int targets[JOINT_COUNT], float speedScale = 1);
+  // Plans `path` from the current positions within the same limits and
+  // follows it; returns its duration in seconds. The path must stay alive
+  // and unchanged until the engine is idle. setTarget, hold and moveTo
+  // abandon it.
+  float followPath(BlendPath& path);
+
+  // Velocity mode for teleoperation. Each joint with a non-zero velocity
+  // (deg/s, capped at its speed limit) leaves whatever it was doing and
+  // ramps to that velocity within its acceleration limit; a jogging joint
+  // given 0 ramps down to a stop. Joints brake in time to stop at 0 and 180
+  // degrees and wherever the jog guard says. Unless jog() is called again
+  // within deadmanSec, every jogging joint ramps down to a stop.
+  void jog(const float velocities[JOINT_COUNT], float deadmanSec);
+  // Pose check for jogging (e.g. the collision envelope). Called a few
+  // times a tick while jogging, so it must be quick.
+  typedef bool (*JogGuard)(const float positions[JOINT_COUNT]);
+  void setJogGuard(JogGuard guard);
+
+  // Runs any ticks that are due. Returns true if at least one tick ran.
+  bool update(uint32_t nowUs);
+  // Advances every joint by one tick of dtSec seconds
+  void tick(float dtSec);
+
+  int position(JointId joint) const;
+  int target(JointId joint) const;
+  bool isMoving(JointId joint) const;
+  bool isIdle() const;
+
+  uint32_t tickCount() const { return ticks; }
+  uint32_t servoWriteCount() const { return servoWrites; }
+
+private:
+  struct Joint {
+    float position;   // Where the joint is now, in degrees
+    float target;     // Where the joint is heading
+    float speed;      // Degrees per second
+    float maxSpeed;   // Limits for synchronized segments
+    float maxAccel;
+    bool inSegment;   // Following `profile` rather than the speed above
+    float segmentStart;
+    TrapezoidProfile profile;
+    bool jogging;     // Following jogCommand rather than target
+    float jogCommand; // deg/s
+    float velocity;   // While jogging, deg/s
+  };
+
+  Joint joints[JOINT_COUNT];
+  ServoDriver* driver;
+  float segmentTime;     // Seconds since the current segment or path started
+  const BlendPath* path; // Being followed, or nullptr
+  JogGuard jogGuard;
+  float jogTimeLeft;     // Dead-man timer, seconds
+  uint32_t lastTickUs;
+  bool started;
+  uint32_t ticks;
+  uint32_t servoWrites;
+
+  void writeOutputs();
+  void stopPath();
+  void stopJog(Joint& j);
+  void stepJog(float dtSec);
+};
+
+#endif // MOTION_ENGINE_H
@@ -0,0 +1,62 @@
+#ifndef MOTION_PROGRAM_H
+#define MOTION_PROGRAM_H
+
+#include <Arduino.h>
+#include "MotionEngine.h"
+#include "BlendPath.h"
+
+// One waypoint of a motion program
+struct ProgramBlock {
+  int16_t targets[JOINT_COUNT]; // Degrees
+  float speed;                  // deg/s cap for the move here, 0 = joint limits
+  uint16_t dwellMs;             // Pause after arriving
+  bool stop;                    // Come to rest here (set by G4) instead of blending through
+  uint16_t line;                // Where it was written, for errors
+};
+
+struct ProgramError {
+  uint16_t line; // 1-based
+  const char* message;
+};
+
+// A batch of waypoints run by the motion task without a round trip per
+// move. Consecutive moves are blended into one BlendPath; only G4 (or the
+// end of the program) brings the arm to rest.
+//
+// Text format, one block per line, G-code style:
+//   G1 B90 S100 E60 C30 F90   move; omitted joints keep their last value
+//   G0 B45                    same, at the joints' own speed limits
+//   G4 P250                   stop at the last waypoint, then wait 250 ms
+//   ; anything after a semicolon is a comment
+// B, S, E and C are base, shoulder, elbow and claw (gripper) in degrees
+// (0-180); shoulder/elbow pairs outside the collision envelope (Envelope.h)
+// are rejected, and so are moves that would pass outside it on the way. F
+// caps the joint speed in deg/s and carries over to later G1 lines. A line
+// without a G word repeats the last G0/G1. Numbers are plain decimals (no
+// exponent), so words may run together: G1B90S100E60.
+class MotionProgram {
+public:
+  static const uint8_t MAX_BLOCKS = BlendPath::MAX_POINTS;
+
+  MotionProgram() : count(0) {}
+
+  // `start` is where omitted joints begin (the current commanded position)
+  bool parse(const char* text, const int start[JOINT_COUNT], ProgramError& error);
+  // Plans each run of blended moves the way the motion task will, from
+  // `start` (where the arm actually is) and within the given limits, and
+  // checks poses along the whole path a quarter degree apart against the
+  // collision envelope, rounded corners included. The error names the
+  // waypoint nearest the collision. `scratch` is used for planning.
+  bool checkPath(const float start[JOINT_COUNT], const float maxSpeed[JOINT_COUNT],
+                 const float maxAccel[JOINT_COUNT], BlendPath& scratch, ProgramError& error) const;
+  void clear() { count = 0; }
+
+  uint8_t size() const { return count; }
+  const ProgramBlock& operator[](uint8_t i) const { return blocks[i]; }
+
+private:
+  ProgramBlock blocks[MAX_BLOCKS];
+  uint8_t count;
+};
+
+#endif // MOTION_PROGRAM_H
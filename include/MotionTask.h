@@ -0,0 +1,141 @@
+#ifndef MOTION_TASK_H
+#define MOTION_TASK_H
+
+#include <Arduino.h>
+#include <atomic>
+#include "MotionEngine.h"
+#include "SpscQueue.h"
+#include "Metrics.h"
+#include "MotionProgram.h"
+
+enum MotionCommandType : uint8_t {
+  MOTION_SET_TARGET,  // joint, values[0], speed
+  MOTION_MOVE_TO,     // values[JOINT_COUNT], speed = speed scale
+  MOTION_HOLD,        // joint
+  MOTION_SET_ENABLED, // joint, values[0] = 0/1 (attach/detach the servo)
+  MOTION_RUN_PROGRAM, // Starts MotionTask::program()
+  MOTION_JOG,         // values[JOINT_COUNT] = tenths of a deg/s, speed = dead-man seconds
+};
+
+struct MotionCommand {
+  MotionCommandType type;
+  uint8_t joint;
+  int16_t values[JOINT_COUNT];
+  float speed;
+  uint32_t queuedUs; // For latency measurement
+};
+
+// What the motion task publishes after every tick. Read it with
+// MotionTask::snapshot(); it is always internally consistent.
+struct MotionSnapshot {
+  int16_t position[JOINT_COUNT];
+  int16_t target[JOINT_COUNT];
+  bool idle;
+  uint32_t commandsApplied;
+  uint32_t ticks;
+  uint32_t servoWrites;
+  uint32_t lastCommandLatencyUs; // Queue to apply
+  uint32_t maxCommandLatencyUs;
+  uint32_t maxTickJitterUs;      // Worst lateness of a tick against its schedule
+  uint32_t programsDone;         // Programs finished or stopped
+  uint8_t programBlock;          // Blocks of the running program handed to the engine
+};
+
+// Runs the MotionEngine in its own high-priority task pinned to the core that
+// doesn't run Wi-Fi. Everything else talks to it through a lock-free command
+// queue (one producer at a time: whoever holds the arm lock) and reads back
+// a seqlock-published snapshot, so no servo state is shared between the
+// cores.
+class MotionTask {
+public:
+  static const BaseType_t CORE = 1;
+  static const UBaseType_t PRIORITY = configMAX_PRIORITIES - 2;
+  static const uint32_t STACK_SIZE = 4096;
+  static const size_t QUEUE_SIZE = 32;
+
+  // Configure joints on the engine before begin(), then leave it alone
+  MotionEngine& engine() { return eng; }
+  void begin();
+  // One tick, as if woken at nowUs: applies queued commands, moves the
+  // engine on and publishes the snapshot. The task calls it every
+  // TICK_INTERVAL_US; the host tests call it with a simulated clock.
+  void step(uint32_t nowUs);
+
+  // Producer side; calls must not overlap. All return false if the queue is full.
+  // hasRoom() says whether the next `commands` sends will all fit: the
+  // motion task only ever makes more room.
+  bool hasRoom(size_t commands) const { return queue.size() + commands <= queue.capacity(); }
+  bool setTarget(JointId joint, int target, float speedDegPerSec);
+  bool moveTo(const int targets[JOINT_COUNT], float speedScale = 1);
+  bool hold(JointId joint);
+  bool setEnabled(JointId joint, bool enabled);
+  // See MotionEngine::jog(); velocities in deg/s
+  bool jog(const float velocities[JOINT_COUNT], float deadmanSec);
+
+  // The program buffer belongs to the producer side while programBusy() is
+  // false: fill it, then runProgram() hands it to the motion task, which
+  // blends each run of moves between G4 stops into one path.
+  MotionProgram& program() { return prog; }
+  // Plans the buffer from `start` with the engine's limits and checks the
+  // whole path against the collision envelope (MotionProgram::checkPath)
+  bool checkProgram(const float start[JOINT_COUNT], ProgramError& error);
+  bool runProgram();
+  bool programBusy() const;
+
+  // Holds every joint where it is and abandons any program, on the next
+  // tick. Doesn't go through the queue, so it works even when that is full;
+  // commands sent before it are applied first, commands sent after it still
+  // run afterwards.
+  void stopAll();
+
+  // True once every queued command has been applied and nothing is moving
+  bool isIdle() const;
+  int target(JointId joint) const;
+  void snapshot(MotionSnapshot& out) const;
+  size_t queueDepth() const { return queue.size(); }
+  size_t queueCapacity() const { return queue.capacity(); }
+  // Deepest the queue has been right after a push, producer side only
+  size_t queueHighWater() const { return maxQueueDepth; }
+  // Lateness of each tick against its schedule; written by the motion task
+  const LatencyHistogram& tickJitterHistogram() const { return tickJitter; }
+
+private:
+  MotionEngine eng;
+  SpscQueue<MotionCommand, QUEUE_SIZE> queue;
+  uint32_t commandsSent = 0; // Producer side only
+  uint32_t programsSent = 0; // Producer side only
+  // stopAll() requests: the count is bumped after stopAfter (commands sent
+  // before the stop) is written. stopsSeen is the motion task's.
+  std::atomic<uint32_t> stopRequests{0};
+  std::atomic<uint32_t> stopAfter{0};
+  uint32_t stopsSeen = 0;
+  size_t maxQueueDepth = 0;  // Producer side only
+  LatencyHistogram tickJitter; // Motion task only
+  uint32_t nextTickUs = 0;   // When the next tick is due; motion task only
+
+  // Program state, motion task only while a program runs
+  MotionProgram prog;
+  BlendPath path;
+  bool programActive = false;
+  uint8_t programNext = 0;  // Next block to plan
+  uint16_t dwellMs = 0;     // Dwell due once the current path ends
+  bool dwelling = false;
+  uint32_t dwellStartUs = 0;
+
+  // Seqlock: odd while the motion task is writing `published`
+  std::atomic<uint32_t> snapshotSeq{0};
+  MotionSnapshot published = {};
+  MotionSnapshot local = {}; // Motion task's working copy
+
+  bool send(MotionCommand& cmd);
+  void apply(const MotionCommand& cmd);
+  void publish();
+  void drainQueue();
+  void stopNow();
+  void stepProgram(uint32_t nowUs);
+  void endProgram();
+  void run();
+  static void taskEntry(void* self);
+};
+
+#endif // MOTION_TASK_H
@@ -0,0 +1,46 @@
+#ifndef POSE_BUFFER_H
+#define POSE_BUFFER_H
+
+#include <Arduino.h>
+#include "MotionEngine.h"
+
+// One recorded pose: every joint in whole degrees plus the time since the
+// previous pose (saturating at ~65 s). 6 bytes instead of 16.
+struct PackedPose {
+  uint8_t joints[JOINT_COUNT];
+  uint16_t dtMs;
+};
+
+// Fixed-capacity, statically allocated store for a recorded sequence.
+// Appending never touches the heap; once full, append() returns false.
+class PoseBuffer {
+public:
+  static const size_t CAPACITY = 2048; // 12 KB
+
+  PoseBuffer();
+
+  // Returns false (and stores nothing) when the buffer is full
+  bool append(const uint8_t joints[JOINT_COUNT], uint32_t nowMs);
+  // Appends a pose with its delta timestamp as-is (loading from flash)
+  bool appendPacked(const PackedPose& pose);
+  void clear();
+
+  size_t size() const { return count; }
+  size_t capacity() const { return CAPACITY; }
+  size_t bytesUsed() const { return count * sizeof(PackedPose); }
+  bool empty() const { return count == 0; }
+  bool full() const { return count == CAPACITY; }
+
+  const PackedPose& operator[](size_t i) const { return poses[i]; }
+  const PackedPose& back() const { return poses[count - 1]; }
+  // In-place editing (keyframe compression)
+  PackedPose& at(size_t i) { return poses[i]; }
+  void truncate(size_t n) { if (n < count) count = n; }
+
+private:
+  PackedPose poses[CAPACITY];
+  size_t count;
+  uint32_t lastMs;
+};
+
+#endif // POSE_BUFFER_H
@@ -0,0 +1,79 @@
+#ifndef SEQUENCE_STORE_H
+#define SEQUENCE_STORE_H
+
+#include <Arduino.h>
+#include <FS.h>
+#include "PoseBuffer.h"
+
+// Named sequences and home positions kept on a flash filesystem (LittleFS on
+// the board, anything implementing fs::FS elsewhere).
+//
+// Sequence file format, /seq/<name>.seq, all little-endian:
+//   magic "MARM" | version u8 | joint count u8 | reserved u16 | pose count u32
+//   followed by pose count records of PackedPose (joints u8[4], dtMs u16)
+// Home file, /home.bin: magic "MARH" | version u8 | home u8[JOINT_COUNT]
+const uint8_t SEQUENCE_FILE_VERSION = 1;
+const size_t SEQUENCE_HEADER_SIZE = 12;
+const size_t SEQUENCE_NAME_MAX = 24;
+
+class SequenceStore {
+public:
+  typedef void (*ListCallback)(const char* name, uint32_t poses, void* ctx);
+
+  explicit SequenceStore(fs::FS& fs);
+
+  // Names are 1-24 characters of [A-Za-z0-9_-]
+  static bool validName(const char* name);
+
+  bool save(const char* name, const PoseBuffer& poses);
+  // Loads into RAM; fails if the file is missing, corrupt or too big
+  bool load(const char* name, PoseBuffer& poses);
+  bool remove(const char* name);
+  bool exists(const char* name);
+  // Calls fn for every stored sequence; returns the number found
+  size_t list(ListCallback fn, void* ctx);
+
+  bool saveHome(const int home[JOINT_COUNT]);
+  bool loadHome(int home[JOINT_COUNT]);
+
+  fs::FS& filesystem() { return fs; }
+  static void pathFor(const char* name, char* path, size_t len);
+
+private:
+  fs::FS& fs;
+};
+
+// Streams a stored sequence a chunk at a time, so playback never needs the
+// whole file in RAM.
+class SequenceReader {
+public:
+  static const uint8_t CHUNK_POSES = 32; // 192 bytes
+
+  SequenceReader();
+
+  bool open(fs::FS& fs, const char* name);
+  // Next pose, or false at the end (or on a read error)
+  bool next(PackedPose& pose);
+  // Back to the first pose
+  bool rewind();
+  void close();
+
+  bool isOpen() const { return opened; }
+  uint32_t size() const { return total; }
+
+private:
+  File file;
+  bool opened;
+  PackedPose chunk[CHUNK_POSES];
+  uint8_t chunkLen;
+  uint8_t chunkPos;
+  uint32_t remaining; // Poses still in the file, not yet in chunk
+  uint32_t total;
+
+  bool fillChunk();
+};
+
+// Reads and checks a sequence header; returns the pose count through `poses`
+bool readSequenceHeader(File& file, uint32_t& poses);
+
+#endif // SEQUENCE_STORE_H
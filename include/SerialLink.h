@@ -0,0 +1,55 @@
+#ifndef SERIAL_LINK_H
+#define SERIAL_LINK_H
+
+#include <Arduino.h>
+#include "ArmController.h"
+#include "SerialProtocol.h"
+
+// Binary control over the USB UART (protocol in SerialProtocol.h), for a
+// host on a cable rather than the Wi-Fi page. The UART carries the text log
+// until the first valid frame arrives. From then on log lines go out as LOG
+// frames, so text never lands in the middle of a frame, until the host
+// sends CLOSE or stays silent for IDLE_MS.
+class SerialLink {
+public:
+  static const uint32_t IDLE_MS = 10000;
+
+  SerialLink(Stream& port, ArmController& arm, MotionTask& motion);
+
+  // Takes over the log sink (see Log.h); call after logBegin()
+  void begin();
+  // Reads whatever has arrived and answers it. Drives the arm, so call it
+  // under the arm lock.
+  void poll();
+
+  bool active() const { return isActive; }
+  uint32_t framesReceived() const { return received; }
+  uint32_t frameErrors() const { return decoder.errors(); }
+  // SETPOINT frames that couldn't be applied (playback, full queue, ...)
+  uint32_t setpointsDropped() const { return droppedSetpoints; }
+
+private:
+  Stream& port;
+  ArmController& arm;
+  MotionTask& motion;
+  SerialFrameDecoder decoder;
+  SemaphoreHandle_t txMutex; // The log task writes too
+  volatile bool isActive;
+  uint32_t lastFrameMs;
+  uint32_t received;
+  uint32_t droppedSetpoints;
+
+  static SerialLink* logTarget;
+  static void logSink(const char* line, size_t len);
+
+  void handleFrame();
+  void setActive(bool active);
+  void send(uint8_t type, uint8_t seq, const uint8_t* payload, size_t len);
+  void ack(uint8_t seq, uint8_t request, ArmStatus status);
+  void ack(uint8_t seq, uint8_t request, ArmStatus status, uint16_t count);
+  ArmStatus applyTargets(const uint8_t* payload, size_t len);
+  ArmStatus applyEnable(const uint8_t* payload, size_t len);
+  void sendState(uint8_t seq);
+};
+
+#endif // SERIAL_LINK_H
@@ -0,0 +1,116 @@
+#ifndef SERIAL_PROTOCOL_H
+#define SERIAL_PROTOCOL_H
+
+// No Arduino dependencies: the host client (host/) builds this too.
+#include <stddef.h>
+#include <stdint.h>
+
+// Framed binary protocol on the USB UART (see SerialLink.h). A frame is
+//   [type][seq][payload ...][crc16 lo][crc16 hi]
+// COBS-encoded so it contains no zero bytes, then terminated by one. The
+// CRC is CRC-16/CCITT-FALSE over type, seq and payload. Multi-byte fields
+// are little-endian. Replies echo the request's seq.
+//
+// Host to arm:
+//   PING          any payload            -> PONG with the same payload
+//   SET_TARGETS   mask, tenths[4]        -> ACK
+//   SETPOINT      mask, tenths[4]        no reply; for streaming
+//   ENABLE        mask, enabled mask     -> ACK; attaches/detaches joints
+//   GET_STATE                            -> STATE
+//   UPLOAD_BEGIN                         -> ACK; empties the recording
+//   UPLOAD_POSES  PackedPose[n]          -> ACK, poses stored so far
+//   UPLOAD_END    name (may be empty)    -> ACK; saves the recording as name
+//   CLOSE                                no reply; the UART goes back to text
+// `mask` has bit j set for each joint j (JointId order) to move; tenths are
+// positions in tenths of a degree (0-1800), one per joint.
+//
+// Arm to host:
+//   ACK    request type, ArmStatus[, uint16 count]
+//   PONG   the PING payload
+//   STATE  see SerialState
+//   LOG    one log line (text, no terminator), unsolicited
+enum SerialMessage : uint8_t {
+  SERIAL_PING = 0x01,
+  SERIAL_SET_TARGETS = 0x02,
+  SERIAL_SETPOINT = 0x03,
+  SERIAL_GET_STATE = 0x04,
+  SERIAL_UPLOAD_BEGIN = 0x05,
+  SERIAL_UPLOAD_POSES = 0x06,
+  SERIAL_UPLOAD_END = 0x07,
+  SERIAL_CLOSE = 0x08,
+  SERIAL_ENABLE = 0x09,
+
+  SERIAL_ACK = 0x80,
+  SERIAL_PONG = 0x81,
+  SERIAL_STATE = 0x82,
+  SERIAL_LOG = 0x83,
+};
+
+const uint8_t SERIAL_JOINTS = 4;                   // JOINT_COUNT
+const size_t SERIAL_TARGETS_SIZE = 1 + 2 * SERIAL_JOINTS;
+const size_t SERIAL_POSE_SIZE = SERIAL_JOINTS + 2; // PackedPose: joints, dtMs
+const size_t SERIAL_MAX_PAYLOAD = 240;             // 40 poses per UPLOAD_POSES
+const size_t SERIAL_MAX_RAW = 2 + SERIAL_MAX_PAYLOAD + 2;
+// COBS adds one byte per 254, plus the delimiter
+const size_t SERIAL_MAX_FRAME = SERIAL_MAX_RAW + SERIAL_MAX_RAW / 254 + 2;
+
+// STATE payload, 22 bytes
+const uint8_t SERIAL_STATE_RECORDING = 0x01;
+const uint8_t SERIAL_STATE_PLAYING = 0x02;
+const uint8_t SERIAL_STATE_PAUSED = 0x04;
+const size_t SERIAL_STATE_SIZE = 22;
+
+struct SerialState {
+  uint8_t flags;                  // SERIAL_STATE_*
+  uint8_t enabled;                // Joint mask
+  uint8_t target[SERIAL_JOINTS];  // Commanded positions, degrees
+  int16_t actual[SERIAL_JOINTS];  // Where the motion engine has the servos, degrees
+  uint16_t poses;                 // Recorded poses
+  uint16_t playDone;              // Playback progress, 0/0 when idle
+  uint16_t playTotal;
+};
+
+uint16_t crc16(const uint8_t* data, size_t len, uint16_t crc = 0xFFFF);
+
+// Returns the encoded length (at most len + len / 254 + 1), no delimiter
+size_t cobsEncode(const uint8_t* in, size_t len, uint8_t* out);
+// out may be in (decoding only ever shrinks). Returns false on a malformed
+// block or a zero byte.
+bool cobsDecode(const uint8_t* in, size_t len, uint8_t* out, size_t& outLen);
+
+// Builds a complete frame, delimiter included, into out (SERIAL_MAX_FRAME
+// bytes); returns its length, or 0 if the payload is too long
+size_t serialEncodeFrame(uint8_t type, uint8_t seq, const uint8_t* payload, size_t len, uint8_t* out);
+
+void serialPutU16(uint8_t* p, uint16_t v);
+uint16_t serialGetU16(const uint8_t* p);
+void serialEncodeState(const SerialState& state, uint8_t* out);
+bool serialDecodeState(const uint8_t* in, size_t len, SerialState& state);
+
+// Splits a byte stream into frames. Anything that isn't a frame (text, or
+// the tail of one joined mid-stream) fails the checks and is dropped at the
+// next delimiter, so either end can start listening at any point.
+class SerialFrameDecoder {
+public:
+  SerialFrameDecoder() : used(0), overflow(false), frameLen(0), badFrames(0) {}
+
+  // Returns true when b completes a valid frame
+  bool push(uint8_t b);
+
+  uint8_t type() const { return frame[0]; }
+  uint8_t seq() const { return frame[1]; }
+  const uint8_t* payload() const { return frame + 2; }
+  size_t payloadLength() const { return frameLen; }
+  // Frames that failed COBS, length or CRC checks
+  uint32_t errors() const { return badFrames; }
+
+private:
+  uint8_t buf[SERIAL_MAX_FRAME];
+  uint8_t frame[SERIAL_MAX_FRAME]; // Decoding never grows
+  size_t used;
+  bool overflow;
+  size_t frameLen;
+  uint32_t badFrames;
+};
+
+#endif // SERIAL_PROTOCOL_H
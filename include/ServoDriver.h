@@ -0,0 +1,59 @@
+#ifndef SERVO_DRIVER_H
+#define SERVO_DRIVER_H
+
+#include <Arduino.h>
+#include "MotionEngine.h"
+
+// One row of the joint table: where the servo is wired and how its pulse
+// width maps to the joint angle the rest of the firmware works in
+struct JointConfig {
+  const char* name;  // As used by the web interface
+  uint8_t pin;
+  uint16_t minUs;    // Pulse at 0 degrees
+  uint16_t maxUs;    // Pulse at 180 degrees
+  int8_t direction;  // 1, or -1 for a servo mounted the other way round
+  float offsetDeg;   // Added to the angle (after direction) to trim the horn
+};
+
+// Drives the joint servos straight from the LEDC peripheral: one 50 Hz
+// timer at 16 bits (about 0.3 us, or 1/35 degree, per step) shared by all
+// channels. Angles are staged per joint and latched together by commit(),
+// so every joint picks up its new pulse on the same PWM period.
+class ServoDriver {
+public:
+  static const uint32_t FREQUENCY_HZ = 50;
+  static const uint8_t RESOLUTION_BITS = 16;
+  static const uint32_t PERIOD_US = 1000000 / FREQUENCY_HZ;
+
+  // table must hold JOINT_COUNT entries, in JointId order, and outlive the driver
+  explicit ServoDriver(const JointConfig* table);
+
+  // Sets up the timer and channels; outputs stay idle until enabled
+  void begin();
+  // Starts or stops pulses on a joint (a stopped servo goes limp)
+  void setEnabled(JointId joint, bool enabled);
+  bool enabled(JointId joint) const { return channels[joint].enabled; }
+
+  // Stages a new angle (0-180). Returns true if the pulse width changed.
+  bool stage(JointId joint, float degrees);
+  // Latches every staged pulse width
+  void commit();
+
+  const JointConfig& config(JointId joint) const { return table[joint]; }
+  // Pulse width (us) and LEDC duty for an angle under a joint's calibration
+  static float pulseUs(const JointConfig& cfg, float degrees);
+  static uint32_t dutyFor(float pulseUs);
+  uint32_t duty(JointId joint) const { return channels[joint].duty; }
+
+private:
+  struct Channel {
+    bool enabled;
+    bool dirty;    // duty staged but not latched yet
+    uint32_t duty; // 0 until the first stage() after enabling
+  };
+
+  const JointConfig* table;
+  Channel channels[JOINT_COUNT];
+};
+
+#endif // SERVO_DRIVER_H
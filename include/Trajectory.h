@@ -0,0 +1,26 @@
+#ifndef TRAJECTORY_H
+#define TRAJECTORY_H
+
+#include <Arduino.h>
+
+// Trapezoidal velocity profile for one joint over one segment: accelerate at
+// `accel`, cruise at `vPeak`, decelerate at `accel`. Short moves never reach
+// cruise speed and come out triangular.
+struct TrapezoidProfile {
+  float distance; // Signed, in degrees
+  float vPeak;    // Degrees per second
+  float accel;    // Degrees per second^2
+  float tAccel;   // Time spent accelerating (and again decelerating)
+  float duration; // Total time of the segment
+
+  // Fastest profile for the move within the given limits
+  void plan(float distance, float vMax, float aMax);
+  // The same timing over another distance: peak speed and acceleration
+  // scale with it. Joints given one unit-distance profile move in
+  // proportion, along a straight line in joint space.
+  TrapezoidProfile scaled(float newDistance) const;
+  // Offset from the start position at time t (clamped to [0, duration])
+  float positionAt(float t) const;
+};
+
+#endif // TRAJECTORY_H
@@ -0,0 +1,341 @@
+// Generated by tools/build_web.py from web/index.html - do not edit.
+#ifndef WEB_ASSETS_H
+#define WEB_ASSETS_H
+
+#include <Arduino.h>
+
+const char INDEX_HTML_ETAG[] = "\"3a9fb1b19df25675\"";
+const size_t INDEX_HTML_GZ_LEN = 5259;
+const uint8_t INDEX_HTML_GZ[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xcd, 0x5c, 0x7b, 0x73, 0xdb, 0x36,
+  0x12, 0xff, 0xdf, 0x9f, 0x02, 0x49, 0x67, 0x42, 0xea, 0x62, 0x51, 0x92, 0x1f, 0xb9, 0xc4, 0xb2,
+  0x9c, 0x71, 0x62, 0xe7, 0xd1, 0x73, 0x12, 0x9f, 0xed, 0x5c, 0xf3, 0x98, 0x8c, 0x87, 0x12, 0x21,
+  0x89, 0x0d, 0x45, 0xb0, 0x7c, 0x58, 0x76, 0xd3, 0x7c, 0xf7, 0xdb, 0x5d, 0x00, 0x24, 0x48, 0x51,
+  0xb4, 0x6c, 0x27, 0x77, 0x4d, 0xa7, 0xb6, 0x08, 0x02, 0x8b, 0xc5, 0x3e, 0x7e, 0xbb, 0x0b, 0x40,
+  0xde, 0xbd, 0x77, 0xf0, 0xee, 0xf9, 0xd9, 0xc7, 0xe3, 0x43, 0x36, 0x4d, 0x67, 0xc1, 0xde, 0xda,
+  0x2e, 0xfe, 0x62, 0x81, 0x1b, 0x4e, 0x06, 0x16, 0x0f, 0x2d, 0x6c, 0xe0, 0xae, 0x07, 0xbf, 0x66,
+  0x3c, 0x75, 0xd9, 0x68, 0xea, 0xc6, 0x09, 0x4f, 0x07, 0xd6, 0xfb, 0xb3, 0x17, 0xed, 0xc7, 0x96,
+  0x6e, 0x0e, 0xdd, 0x19, 0x1f, 0x58, 0x17, 0x3e, 0x9f, 0x47, 0x22, 0x4e, 0x2d, 0x36, 0x12, 0x61,
+  0xca, 0x43, 0xe8, 0x36, 0xf7, 0xbd, 0x74, 0x3a, 0xf0, 0xf8, 0x85, 0x3f, 0xe2, 0x6d, 0x7a, 0x58,
+  0x67, 0x7e, 0xe8, 0xa7, 0xbe, 0x1b, 0xb4, 0x93, 0x91, 0x1b, 0xf0, 0x41, 0xcf, 0xe9, 0x22, 0x99,
+  0xd4, 0x4f, 0x03, 0xbe, 0xf7, 0x86, 0xef, 0xc7, 0x33, 0xf6, 0x1c, 0x46, 0xc7, 0x22, 0xd8, 0xed,
+  0xc8, 0xc6, 0xb5, 0xdd, 0x7b, 0xed, 0x36, 0x34, 0xce, 0x22, 0x3f, 0xe0, 0x1e, 0x0c, 0x4f, 0x05,
+  0xfc, 0x18, 0x05, 0x99, 0xc7, 0x3b, 0xbf, 0xf1, 0xe1, 0x7e, 0x02, 0x0c, 0x25, 0xce, 0x94, 0x0d,
+  0xaf, 0x58, 0x2a, 0x44, 0x90, 0x74, 0x86, 0x99, 0x1f, 0x78, 0xe7, 0x73, 0x3e, 0x74, 0xa2, 0xab,
+  0x3e, 0x0b, 0xfc, 0x0b, 0xce, 0x2e, 0xdc, 0x20, 0xe3, 0x09, 0xf0, 0x35, 0xe3, 0x6c, 0x1c, 0x8b,
+  0x19, 0xeb, 0x24, 0xa9, 0x9b, 0x72, 0xd6, 0x6e, 0x03, 0xf9, 0x24, 0xbd, 0xc2, 0x69, 0x86, 0xc2,
+  0xbb, 0x62, 0xdf, 0xd8, 0x18, 0x66, 0x6f, 0x8f, 0xdd, 0x99, 0x1f, 0x5c, 0xed, 0xb0, 0xc4, 0x0d,
+  0x93, 0x76, 0xc2, 0x63, 0x7f, 0xdc, 0x67, 0x43, 0x77, 0xf4, 0x75, 0x12, 0x8b, 0x2c, 0xf4, 0xda,
+  0x23, 0x11, 0x88, 0x78, 0x87, 0xfd, 0xb2, 0xb1, 0xb1, 0xd1, 0x67, 0xfa, 0x81, 0x73, 0xde, 0x67,
+  0x9e, 0x9f, 0x44, 0x81, 0x0b, 0x23, 0xc7, 0x01, 0xbf, 0xec, 0xd3, 0xcf, 0xb6, 0xe7, 0xc7, 0x7c,
+  0x94, 0xfa, 0x22, 0xdc, 0xc1, 0xbe, 0xd9, 0x2c, 0xec, 0x33, 0x37, 0xf0, 0x27, 0x61, 0xdb, 0x4f,
+  0xf9, 0x2c, 0x81, 0x46, 0x10, 0x15, 0x8f, 0xfb, 0xec, 0xfb, 0xda, 0xb4, 0x07, 0x0c, 0x68, 0x7a,
+  0xe3, 0xb1, 0xf7, 0xcf, 0x6e, 0xb7, 0xcf, 0x66, 0x6e, 0x3c, 0xf1, 0xc3, 0xf6, 0x50, 0xa4, 0xa9,
+  0x98, 0xed, 0xb0, 0x8d, 0x6e, 0x74, 0x89, 0x7d, 0x1d, 0x60, 0xeb, 0x42, 0xb4, 0x47, 0x52, 0x58,
+  0x30, 0xae, 0xb6, 0x5f, 0xca, 0x2f, 0xd3, 0x36, 0xcd, 0x56, 0xcc, 0x53, 0xb3, 0x90, 0xcd, 0x2e,
+  0xfe, 0xd7, 0x67, 0x91, 0xeb, 0x79, 0x7e, 0x38, 0xd9, 0x61, 0xbd, 0x6d, 0x1c, 0x3d, 0x14, 0xb1,
+  0xc7, 0xe3, 0x76, 0xec, 0x7a, 0x7e, 0x06, 0x8c, 0x3e, 0xc6, 0x36, 0xd2, 0x22, 0x90, 0xdf, 0x46,
+  0xfa, 0xc0, 0xf2, 0x86, 0xc1, 0xf2, 0x70, 0x38, 0xcc, 0xf9, 0x4d, 0x45, 0xb4, 0xc3, 0xba, 0xc8,
+  0x69, 0xe0, 0x0e, 0x39, 0x32, 0x98, 0xcb, 0x66, 0x18, 0x88, 0xd1, 0xd7, 0x85, 0x85, 0x6d, 0xcb,
+  0x75, 0xf9, 0x61, 0x94, 0xa5, 0x9f, 0xd3, 0xab, 0x08, 0x2c, 0x2a, 0x06, 0x33, 0xe4, 0xd6, 0x17,
+  0xb4, 0x99, 0xa2, 0x31, 0xcc, 0x66, 0x43, 0x1e, 0x5b, 0x5f, 0x80, 0xa2, 0xe2, 0xa5, 0xf7, 0x98,
+  0xd6, 0x9a, 0x33, 0x4f, 0x94, 0x2a, 0xd4, 0x7b, 0x4a, 0x6c, 0xc3, 0x0c, 0x9e, 0x43, 0x18, 0x5b,
+  0x23, 0x85, 0xad, 0xe7, 0xfb, 0x2f, 0xb6, 0xbb, 0xb9, 0x46, 0xe7, 0x53, 0x50, 0x90, 0x16, 0xc2,
+  0x0e, 0x0b, 0x45, 0xc8, 0x4d, 0x09, 0x01, 0x41, 0x98, 0xb9, 0x46, 0x4c, 0x34, 0xfd, 0x28, 0x8b,
+  0x13, 0x24, 0x12, 0x09, 0x5f, 0x4a, 0x5d, 0xf1, 0x13, 0xfb, 0x93, 0x69, 0xaa, 0xfa, 0xa4, 0xb0,
+  0xbe, 0xc4, 0x97, 0x96, 0x51, 0x65, 0x87, 0x75, 0x9d, 0xcd, 0xa4, 0xaf, 0xf9, 0xdd, 0x99, 0x8a,
+  0x0b, 0x1e, 0x2f, 0xe1, 0x7a, 0xdb, 0xed, 0x6e, 0x3d, 0x29, 0xd6, 0xe6, 0x80, 0x9c, 0xdd, 0x61,
+  0xc0, 0xeb, 0x7b, 0x8f, 0xb7, 0xb6, 0x36, 0x37, 0x1f, 0xf5, 0xab, 0x9d, 0x9b, 0x26, 0xf0, 0xdc,
+  0xde, 0x93, 0xee, 0xb0, 0x18, 0x02, 0xd6, 0x0c, 0x0b, 0x06, 0x21, 0x34, 0xce, 0xc0, 0x16, 0xfb,
+  0xaf, 0x30, 0x49, 0x31, 0xea, 0x77, 0xb1, 0x84, 0xfe, 0xf6, 0xf6, 0x36, 0x88, 0x4e, 0x64, 0xa3,
+  0x69, 0xdb, 0x55, 0x6e, 0x25, 0x55, 0x93, 0x81, 0x47, 0x80, 0xb3, 0x06, 0xe0, 0x6c, 0xba, 0xc9,
+  0xa4, 0xd6, 0x34, 0xfb, 0xa3, 0x47, 0xc4, 0xb0, 0xa3, 0xbc, 0x29, 0x21, 0xb7, 0x72, 0xfd, 0x90,
+  0xfa, 0xd7, 0xf9, 0xf4, 0x3c, 0x76, 0xc1, 0xbc, 0xf1, 0x67, 0x9f, 0xfd, 0x9e, 0x25, 0xa9, 0x3f,
+  0xbe, 0x6a, 0x2b, 0xd4, 0x2b, 0x1c, 0x6d, 0x82, 0x7d, 0xa4, 0x1f, 0xd6, 0x39, 0x27, 0xcc, 0x27,
+  0x45, 0xd3, 0x46, 0xf2, 0xda, 0x93, 0x93, 0xff, 0xb9, 0x2b, 0xbb, 0x59, 0x2a, 0x80, 0x43, 0x98,
+  0x50, 0x36, 0x6c, 0x76, 0x15, 0x77, 0x00, 0xac, 0x29, 0x90, 0x30, 0x38, 0x22, 0xa7, 0xde, 0xec,
+  0x1a, 0x04, 0xa9, 0xa5, 0x07, 0xae, 0x90, 0x88, 0xc0, 0xf7, 0x94, 0x76, 0xd4, 0xdc, 0xf2, 0xe5,
+  0xdd, 0xb8, 0xdf, 0xe8, 0x2e, 0xe1, 0xfe, 0xfb, 0xda, 0x2f, 0x88, 0xe1, 0x59, 0xf2, 0x86, 0x27,
+  0x89, 0x3b, 0xe1, 0x06, 0x0c, 0x8d, 0x46, 0xa3, 0x32, 0x0c, 0x49, 0xe7, 0xc7, 0x15, 0x4e, 0xb9,
+  0xf4, 0xbf, 0x9e, 0xb3, 0xc1, 0x67, 0xa8, 0xf2, 0xdd, 0x8e, 0x82, 0xff, 0xdd, 0x8e, 0x0a, 0x74,
+  0x18, 0x07, 0x30, 0xec, 0xf5, 0xca, 0xe1, 0x88, 0xbd, 0x46, 0xa6, 0xc7, 0xee, 0x88, 0x43, 0xcf,
+  0xde, 0xde, 0xda, 0xda, 0xae, 0xe7, 0x5f, 0xb0, 0x51, 0xe0, 0x26, 0xc9, 0xc0, 0x5a, 0xb4, 0x1b,
+  0x0c, 0x6a, 0x46, 0x87, 0x12, 0x58, 0x53, 0x54, 0xdd, 0xd8, 0x7b, 0xe6, 0x26, 0x48, 0x6b, 0x03,
+  0x9e, 0xa2, 0xbd, 0x5d, 0x89, 0x92, 0x63, 0x11, 0x0f, 0xac, 0x21, 0xbc, 0x38, 0x05, 0x69, 0x22,
+  0x95, 0x63, 0xa1, 0x11, 0x62, 0x37, 0x89, 0xdc, 0x90, 0xf9, 0x9e, 0x7c, 0xff, 0x1f, 0x8c, 0x68,
+  0xd6, 0xde, 0x93, 0x2e, 0x2c, 0x00, 0xda, 0xf7, 0x76, 0x3b, 0x44, 0x60, 0x8f, 0xed, 0x12, 0x56,
+  0x32, 0x13, 0x40, 0xf3, 0x41, 0x8a, 0x28, 0x4a, 0x62, 0x60, 0x75, 0xe1, 0xb7, 0x7b, 0x39, 0xb0,
+  0x00, 0x3d, 0x2d, 0x19, 0x20, 0x07, 0xd6, 0x13, 0xf8, 0x28, 0x42, 0xa2, 0x30, 0xb0, 0xb2, 0xc8,
+  0x83, 0x18, 0x79, 0x8a, 0x9c, 0xdb, 0xe9, 0xd4, 0x4f, 0x1c, 0xdf, 0x5b, 0x67, 0xf4, 0x81, 0x7a,
+  0xb7, 0x20, 0xda, 0x89, 0x51, 0x36, 0x03, 0x65, 0x3a, 0x13, 0x9e, 0x1e, 0x06, 0x1c, 0x3f, 0x3e,
+  0xbb, 0x7a, 0xed, 0xd9, 0xf7, 0x73, 0x0e, 0xef, 0xb7, 0x1c, 0xd4, 0xfc, 0x73, 0xe9, 0x1a, 0x6c,
+  0x60, 0x8c, 0xef, 0x5b, 0xc0, 0x74, 0x24, 0x17, 0xaf, 0x50, 0x59, 0x09, 0x0b, 0x9c, 0xd5, 0x62,
+  0x30, 0xb7, 0xdb, 0xfe, 0x1d, 0xd1, 0x53, 0xf2, 0xae, 0x5a, 0x20, 0x98, 0x0e, 0xac, 0x76, 0xcf,
+  0xda, 0x7b, 0xf0, 0xcb, 0x93, 0x47, 0x8f, 0xb6, 0xfa, 0xbb, 0x1d, 0x39, 0xf6, 0xc6, 0x34, 0x14,
+  0x89, 0x6d, 0x93, 0x44, 0x85, 0x1d, 0x01, 0x59, 0x86, 0x3f, 0xfa, 0x3a, 0xb0, 0x52, 0x31, 0x99,
+  0x04, 0x4a, 0x12, 0xb4, 0xb6, 0xfb, 0xad, 0x42, 0xa8, 0xcf, 0xa8, 0xb3, 0xb5, 0x77, 0x18, 0x22,
+  0x90, 0x56, 0x88, 0x75, 0xc0, 0x06, 0x2a, 0xb6, 0x52, 0x67, 0x0a, 0xa7, 0x53, 0x91, 0x05, 0xa0,
+  0x9a, 0x5a, 0x73, 0x48, 0xd4, 0xcb, 0x26, 0x93, 0xd0, 0x7d, 0x6e, 0x6c, 0x16, 0x15, 0xe2, 0x3f,
+  0xdf, 0x34, 0x4a, 0x9c, 0xfe, 0x18, 0xf3, 0xd0, 0x24, 0xef, 0x6a, 0x22, 0x75, 0x74, 0x6e, 0x6d,
+  0x26, 0x9a, 0x98, 0x36, 0x15, 0xfd, 0xfc, 0x23, 0xcc, 0xe5, 0x30, 0x18, 0x8a, 0x79, 0xad, 0xad,
+  0x70, 0x7c, 0xd3, 0x64, 0x28, 0xd4, 0xe1, 0xc6, 0x56, 0x62, 0x92, 0xfd, 0xf9, 0x26, 0x52, 0xf0,
+  0xf8, 0x63, 0xec, 0x83, 0xe8, 0xdd, 0xd5, 0x38, 0x16, 0x88, 0xdc, 0xda, 0x32, 0x88, 0x92, 0x36,
+  0x0b, 0x7a, 0xf8, 0x11, 0x36, 0xf1, 0x32, 0xf6, 0xa3, 0x28, 0x47, 0x10, 0x2c, 0x99, 0x54, 0x0b,
+  0x14, 0x1b, 0x89, 0x60, 0xdd, 0x36, 0x68, 0x6a, 0x9d, 0xb9, 0x1e, 0x66, 0x2b, 0xcc, 0x1f, 0xb3,
+  0x2b, 0x91, 0xc5, 0x6c, 0xa2, 0xba, 0x4c, 0xdd, 0x84, 0xb9, 0x2c, 0x99, 0xb9, 0x41, 0x00, 0x4f,
+  0xa4, 0x78, 0x16, 0x4d, 0xaf, 0x12, 0x1f, 0x6a, 0xb4, 0xe0, 0x4a, 0x96, 0x49, 0x65, 0x43, 0x53,
+  0x23, 0x9b, 0x4c, 0x4d, 0x75, 0xb9, 0xb1, 0xb1, 0x95, 0x49, 0xff, 0x7c, 0x73, 0x33, 0xf9, 0xfc,
+  0x31, 0x06, 0xa7, 0x28, 0xde, 0xd5, 0xe4, 0x6a, 0xc8, 0xdc, 0xda, 0xe8, 0x14, 0x2d, 0x6d, 0x76,
+  0xea, 0x71, 0x05, 0xc3, 0xab, 0xb3, 0xbf, 0xba, 0xb4, 0x55, 0x99, 0xe1, 0x1b, 0x48, 0xb2, 0xd9,
+  0x99, 0x60, 0xf6, 0x6c, 0xd6, 0xca, 0x11, 0xea, 0xc3, 0x4e, 0x59, 0xd9, 0xaa, 0x84, 0x23, 0x4e,
+  0x52, 0x3f, 0xfa, 0x60, 0x31, 0x4a, 0xc2, 0xd4, 0x7e, 0xc1, 0xce, 0x3f, 0x21, 0x5d, 0xb3, 0xf6,
+  0xd8, 0xc7, 0xe6, 0x51, 0x1f, 0xeb, 0x47, 0x7d, 0x6a, 0x1e, 0xf5, 0xa9, 0x76, 0x94, 0x5c, 0x70,
+  0x55, 0x80, 0x33, 0x58, 0xcb, 0x87, 0x8f, 0x9f, 0xec, 0x96, 0x45, 0xcb, 0xca, 0xc5, 0x73, 0x53,
+  0x99, 0xfc, 0x2a, 0x26, 0xb9, 0x28, 0x5e, 0x89, 0xc0, 0x63, 0xca, 0x10, 0x98, 0x52, 0x25, 0x83,
+  0x72, 0xef, 0x2b, 0xbf, 0x4a, 0xd8, 0x7e, 0xe7, 0x80, 0x61, 0x4a, 0xb1, 0xce, 0x7e, 0xeb, 0x9c,
+  0x32, 0x1d, 0x31, 0xd6, 0xd9, 0x49, 0xe7, 0x05, 0x23, 0xa0, 0x58, 0x67, 0xff, 0xee, 0x1c, 0x6a,
+  0xaf, 0xd5, 0x8a, 0x3f, 0x8d, 0x38, 0xf7, 0x76, 0x96, 0xba, 0x13, 0x98, 0x15, 0xf5, 0x50, 0x9e,
+  0xb4, 0x6d, 0x7a, 0x52, 0x92, 0xf2, 0x88, 0x9a, 0x94, 0x4b, 0x6d, 0x6d, 0x1b, 0x2e, 0xb5, 0xd4,
+  0x61, 0x34, 0xc5, 0xeb, 0x3c, 0x06, 0xb4, 0x51, 0xa0, 0x41, 0x69, 0x90, 0xb5, 0xb7, 0xb5, 0xad,
+  0xe0, 0x80, 0x3d, 0xf0, 0xf8, 0xa4, 0xdf, 0x49, 0x96, 0x82, 0x5d, 0x83, 0x60, 0x4f, 0xe8, 0x15,
+  0x7b, 0xc0, 0x8e, 0xe1, 0xa5, 0x12, 0xb1, 0x52, 0x22, 0x4e, 0x29, 0x47, 0x2a, 0x1b, 0xaf, 0xfa,
+  0xc5, 0x89, 0xae, 0x4a, 0x51, 0xbd, 0xa7, 0xa9, 0x1b, 0xa7, 0x4c, 0x36, 0x19, 0x6a, 0xae, 0x1a,
+  0x04, 0xf2, 0x70, 0xca, 0xff, 0xc8, 0x78, 0x38, 0xe2, 0x38, 0x0c, 0xa7, 0x65, 0xba, 0xa1, 0x61,
+  0x9c, 0x07, 0x45, 0x29, 0x82, 0x53, 0x31, 0xf2, 0x80, 0x5a, 0xea, 0xc6, 0x46, 0x7b, 0x47, 0x42,
+  0x44, 0x09, 0xb3, 0xbb, 0x20, 0x4b, 0x80, 0x5a, 0x0e, 0x45, 0x6b, 0xab, 0xc1, 0xa6, 0x91, 0x27,
+  0x1a, 0x91, 0x2b, 0xb1, 0x57, 0x60, 0x66, 0xc9, 0xd4, 0xb7, 0xc9, 0xd4, 0xd7, 0xae, 0x31, 0x17,
+  0x5a, 0xa3, 0x61, 0x2f, 0x5d, 0xa7, 0xa7, 0x2c, 0x66, 0x53, 0xdb, 0x0b, 0x35, 0x15, 0x93, 0xe5,
+  0x06, 0x03, 0x06, 0x3b, 0x3f, 0xd6, 0xc3, 0x6d, 0x03, 0x7c, 0x49, 0xf8, 0x53, 0x9c, 0x03, 0x63,
+  0x57, 0x5a, 0xdf, 0xc7, 0x34, 0x96, 0x9c, 0x09, 0x65, 0x2d, 0x3d, 0xa7, 0x7b, 0x99, 0x87, 0x8f,
+  0x25, 0x70, 0x87, 0x63, 0xb0, 0xa2, 0xdc, 0xa7, 0x4d, 0x01, 0xfb, 0x7e, 0xe4, 0x66, 0x09, 0x3f,
+  0x4f, 0x94, 0x84, 0xef, 0xa3, 0xba, 0xb0, 0x65, 0x01, 0x7d, 0x97, 0x12, 0x88, 0x79, 0x02, 0xf6,
+  0x5f, 0xa2, 0x70, 0x42, 0x4d, 0xab, 0x93, 0x48, 0xa0, 0xfc, 0x2c, 0x11, 0x38, 0x85, 0x86, 0x0a,
+  0xcc, 0x4e, 0x37, 0xf7, 0x8e, 0xfc, 0x61, 0xec, 0xc6, 0x68, 0xc1, 0x9b, 0x72, 0x6d, 0xa6, 0x6e,
+  0xd0, 0xbb, 0x54, 0x0a, 0xc9, 0xff, 0x78, 0xeb, 0xce, 0x40, 0x4f, 0x30, 0xcd, 0x88, 0x4f, 0x05,
+  0x82, 0x03, 0x18, 0x03, 0x35, 0x81, 0x86, 0x02, 0x1e, 0x4e, 0xd2, 0xe9, 0xc0, 0xda, 0xd8, 0x42,
+  0x59, 0x56, 0x59, 0x4b, 0xdc, 0x8b, 0x92, 0x05, 0x9e, 0xba, 0x17, 0x7c, 0x31, 0x86, 0xc8, 0xed,
+  0x13, 0x3d, 0xdb, 0x91, 0x9f, 0xa4, 0x08, 0x8e, 0xb2, 0xb5, 0x8e, 0x68, 0x0a, 0x06, 0xea, 0xe5,
+  0x12, 0x87, 0xd5, 0x97, 0x05, 0x4e, 0x6e, 0xb9, 0x4c, 0x58, 0xe5, 0xc1, 0x81, 0x70, 0xbd, 0xd2,
+  0xe0, 0x23, 0x68, 0x58, 0x75, 0xb0, 0x74, 0xb0, 0xd2, 0x70, 0xe9, 0x61, 0xd5, 0x15, 0xca, 0x95,
+  0x99, 0xfb, 0x06, 0xd6, 0xde, 0x6d, 0x90, 0xe7, 0x38, 0x16, 0x93, 0xd8, 0x9d, 0x15, 0x39, 0x38,
+  0x6a, 0xc9, 0x8d, 0xb9, 0x2b, 0xcd, 0x57, 0xbe, 0x3d, 0x23, 0xcd, 0xc5, 0x62, 0x0e, 0xb4, 0x1e,
+  0xe1, 0xae, 0x78, 0x00, 0x1f, 0x36, 0x37, 0x2a, 0xfa, 0x7b, 0xd9, 0x63, 0xcf, 0x7a, 0x1b, 0x5d,
+  0x76, 0xda, 0xeb, 0x76, 0xd9, 0x8b, 0x27, 0xdd, 0x07, 0xbf, 0xf4, 0xba, 0x7d, 0x68, 0x3c, 0x7c,
+  0xd4, 0x65, 0xcf, 0x37, 0xd5, 0xe3, 0x16, 0x3b, 0xde, 0xd8, 0xee, 0x22, 0xaf, 0x7a, 0xa2, 0x25,
+  0x31, 0x2b, 0xce, 0x42, 0xc5, 0x1b, 0x2a, 0xf9, 0x24, 0x0b, 0x1b, 0x60, 0x09, 0xad, 0xd3, 0xe8,
+  0x5c, 0xb2, 0xcd, 0x25, 0x79, 0xa7, 0xdc, 0x10, 0xd2, 0x55, 0xab, 0x7a, 0x54, 0x52, 0x00, 0xe3,
+  0x7d, 0x85, 0x1b, 0xec, 0x3a, 0x17, 0x4c, 0x72, 0x7b, 0xc6, 0x9d, 0x8e, 0x06, 0x08, 0xc3, 0x90,
+  0x87, 0x23, 0xcd, 0xcc, 0x6e, 0x8f, 0xe9, 0x9a, 0xb8, 0x61, 0xa0, 0x8e, 0x90, 0x0b, 0x83, 0xb5,
+  0x3d, 0x53, 0xa1, 0xd4, 0x40, 0x80, 0x82, 0xea, 0xe2, 0xd4, 0x2a, 0x73, 0x6e, 0x18, 0xa8, 0x42,
+  0xf0, 0x92, 0x89, 0xeb, 0x7c, 0x6f, 0x3f, 0x08, 0xb4, 0xbc, 0xb4, 0xfb, 0x31, 0x12, 0x57, 0x21,
+  0xc5, 0xa5, 0x8a, 0x9a, 0x08, 0xec, 0x89, 0xc3, 0x5e, 0x0a, 0x1a, 0x54, 0xa3, 0xa6, 0x64, 0x04,
+  0x2c, 0xa5, 0x7b, 0x6b, 0x17, 0x6e, 0xcc, 0x28, 0x7f, 0x4c, 0x20, 0x7e, 0x7c, 0x96, 0xdb, 0x1e,
+  0xeb, 0xac, 0xa8, 0x6d, 0xe1, 0xb3, 0x2c, 0x65, 0xe0, 0x83, 0x4e, 0x30, 0xbf, 0xf4, 0xd7, 0xd6,
+  0x3a, 0x1d, 0x26, 0x33, 0x6e, 0x86, 0x69, 0x4f, 0xc2, 0x26, 0x82, 0xd1, 0x7e, 0x69, 0x3a, 0xe5,
+  0xec, 0x37, 0x3e, 0x3c, 0x15, 0xa3, 0xaf, 0x3c, 0x65, 0x50, 0x27, 0x6c, 0xb7, 0x87, 0x57, 0x29,
+  0x1e, 0xa3, 0x00, 0xee, 0x40, 0x98, 0xa2, 0xb9, 0xd6, 0x59, 0x24, 0x92, 0x7f, 0xf4, 0xa0, 0xc0,
+  0x00, 0x17, 0x6c, 0xad, 0x23, 0x31, 0x37, 0x05, 0x42, 0x50, 0x6a, 0x88, 0x10, 0x4a, 0x09, 0xae,
+  0x78, 0xa2, 0x4f, 0x6e, 0xe8, 0xcf, 0x5c, 0x34, 0x10, 0x49, 0xc3, 0x61, 0x1f, 0x5e, 0x9d, 0x30,
+  0x3f, 0xa1, 0x99, 0xc6, 0x50, 0x6f, 0x20, 0x80, 0x3a, 0xb4, 0x8e, 0x39, 0xae, 0x21, 0xcc, 0x82,
+  0x60, 0x1d, 0x3e, 0x02, 0x78, 0xc1, 0x13, 0x4c, 0x11, 0xf1, 0x10, 0xe3, 0x36, 0x98, 0x19, 0x3c,
+  0x7f, 0xfb, 0xbe, 0xce, 0xc6, 0x41, 0x96, 0x4c, 0xff, 0x9d, 0xf1, 0x8c, 0x7b, 0x18, 0x33, 0xa1,
+  0xde, 0xe1, 0xfd, 0xb5, 0x71, 0x16, 0x12, 0x38, 0xe0, 0x61, 0x54, 0x08, 0xe8, 0xf5, 0x1b, 0x88,
+  0x9d, 0x7d, 0x5b, 0x63, 0x8a, 0x28, 0x9f, 0x17, 0xab, 0xb2, 0xad, 0x79, 0xb2, 0xd3, 0xe9, 0x58,
+  0xec, 0x21, 0x0b, 0xc4, 0x88, 0x58, 0x73, 0xa6, 0xc8, 0xfb, 0x43, 0x66, 0x75, 0xe6, 0x89, 0xd5,
+  0xea, 0xd3, 0x30, 0x67, 0xe8, 0x87, 0x80, 0xd2, 0x67, 0x60, 0x0c, 0x40, 0xc1, 0x72, 0xe3, 0x18,
+  0xc0, 0x3e, 0x1b, 0x8f, 0x41, 0x80, 0xaa, 0x03, 0x2a, 0x4c, 0x24, 0xf8, 0x56, 0xcf, 0x8e, 0x73,
+  0x16, 0xcb, 0xe8, 0x83, 0x78, 0xd2, 0x33, 0x7f, 0xc6, 0x45, 0x96, 0xda, 0x39, 0x5f, 0xeb, 0x0c,
+  0x3c, 0xbf, 0x0b, 0x15, 0xca, 0xf7, 0xfe, 0xda, 0xf7, 0x82, 0x6f, 0x5a, 0x15, 0x65, 0xef, 0x9a,
+  0xf3, 0xda, 0x75, 0x32, 0x4c, 0x12, 0x98, 0x8d, 0xe2, 0xc2, 0x48, 0xc0, 0xfc, 0xd0, 0x10, 0x90,
+  0x1c, 0xc7, 0x18, 0xbe, 0x05, 0x56, 0xd5, 0xc2, 0x0f, 0xa0, 0x9c, 0xf8, 0x8f, 0xcf, 0xe7, 0x36,
+  0x3e, 0xec, 0xe3, 0x32, 0x9e, 0xd1, 0x32, 0xec, 0xed, 0x16, 0x2d, 0x95, 0xe5, 0xd2, 0xb6, 0xe5,
+  0x87, 0x87, 0xac, 0xd7, 0x82, 0x2c, 0xab, 0x7b, 0x39, 0x86, 0x7f, 0xb2, 0x07, 0x50, 0xc3, 0xfd,
+  0xe1, 0xf7, 0xa0, 0xd4, 0xc7, 0x36, 0x28, 0x45, 0x9a, 0x9c, 0xe3, 0x87, 0x1e, 0xbf, 0x7c, 0x37,
+  0xb6, 0x91, 0x15, 0x4d, 0xcc, 0xe8, 0xda, 0x7b, 0x64, 0xf7, 0x4c, 0x05, 0x7e, 0xc6, 0x7e, 0x5f,
+  0xd8, 0x3f, 0x18, 0x9a, 0x4e, 0x1a, 0x63, 0x9d, 0x56, 0x33, 0x64, 0x53, 0xa9, 0xbf, 0xd4, 0x05,
+  0xc4, 0x9d, 0x00, 0x1d, 0x1b, 0xbb, 0x4a, 0x2d, 0xd0, 0x8b, 0xef, 0xf0, 0x7f, 0xc5, 0x40, 0x4a,
+  0x52, 0x35, 0xeb, 0xc4, 0x84, 0xec, 0xfd, 0x35, 0x14, 0x8a, 0x32, 0x05, 0x21, 0x61, 0xa1, 0xa8,
+  0xa8, 0xbe, 0xc6, 0x50, 0x0b, 0xe3, 0x75, 0x27, 0x27, 0xe6, 0x04, 0xdb, 0xb6, 0xa5, 0x0a, 0x53,
+  0xf0, 0x1f, 0x69, 0x19, 0x50, 0x4c, 0x83, 0x9c, 0xd8, 0x83, 0x07, 0xc8, 0x13, 0x20, 0xb3, 0x77,
+  0x75, 0x4a, 0x87, 0x8b, 0x83, 0xc1, 0x00, 0xe5, 0x26, 0x35, 0x60, 0xac, 0x39, 0xa7, 0xfe, 0x05,
+  0xc8, 0x47, 0x78, 0xa0, 0xfa, 0x3a, 0x4c, 0x6d, 0x55, 0xa6, 0x52, 0x67, 0xa4, 0x78, 0xcf, 0xd0,
+  0x36, 0x1a, 0x51, 0x59, 0xf9, 0x28, 0x88, 0x3e, 0x8b, 0x31, 0xde, 0x25, 0xe9, 0xbe, 0x76, 0xa8,
+  0x17, 0xe8, 0x4f, 0xb6, 0x61, 0x38, 0x68, 0x54, 0x44, 0x31, 0xe6, 0x69, 0x16, 0x87, 0x5a, 0x40,
+  0xb8, 0xc6, 0xcb, 0x69, 0xac, 0xcc, 0xe1, 0xc3, 0x9b, 0xa3, 0x57, 0x69, 0x1a, 0x9d, 0x48, 0x62,
+  0x36, 0xf1, 0x00, 0x6f, 0x1d, 0x01, 0x3c, 0xdb, 0xd6, 0xcb, 0xc3, 0x33, 0x5c, 0x2a, 0xe4, 0x00,
+  0xe9, 0x39, 0x71, 0xfe, 0x54, 0x55, 0xa7, 0x60, 0x15, 0x15, 0xa5, 0xe7, 0x0b, 0x6b, 0xa1, 0xe7,
+  0x3c, 0x00, 0x48, 0xa0, 0x5e, 0xb4, 0x32, 0x43, 0x77, 0x48, 0x9b, 0x54, 0xd7, 0x42, 0xcd, 0x20,
+  0x56, 0x40, 0x81, 0x34, 0xa1, 0xdd, 0xfe, 0xf9, 0xd4, 0x0f, 0x38, 0x73, 0x19, 0x1e, 0xfe, 0x68,
+  0x10, 0xa4, 0xda, 0x08, 0xf1, 0x61, 0xca, 0x03, 0x50, 0x15, 0x64, 0x88, 0xbd, 0x9e, 0x01, 0x41,
+  0xcc, 0xb6, 0x7e, 0xb5, 0x08, 0x71, 0x2e, 0x38, 0x78, 0xaf, 0x9f, 0x5e, 0x01, 0x0e, 0x15, 0x88,
+  0x23, 0x11, 0x09, 0xd0, 0x0c, 0xb0, 0x0a, 0xbc, 0x8e, 0x61, 0x3a, 0x7d, 0x85, 0x0e, 0xc7, 0x66,
+  0x09, 0x9e, 0x2b, 0x26, 0xa0, 0x4b, 0x42, 0x1e, 0x37, 0x9e, 0x59, 0x09, 0xdb, 0xa4, 0x17, 0x48,
+  0xcd, 0x03, 0x45, 0xb6, 0x67, 0x30, 0x5b, 0x2a, 0xfd, 0x15, 0xa5, 0x1d, 0x70, 0x37, 0xc1, 0x73,
+  0x2f, 0x22, 0x02, 0xb9, 0x2b, 0x7c, 0xc4, 0x85, 0x24, 0xec, 0x4f, 0x1e, 0x8b, 0xc4, 0x61, 0x67,
+  0x92, 0x0e, 0x03, 0xbe, 0x20, 0x83, 0xcf, 0x22, 0x60, 0xd6, 0x23, 0x5a, 0x62, 0x1e, 0xb2, 0xb9,
+  0x8f, 0x23, 0x98, 0x0f, 0xc0, 0xec, 0x8e, 0x46, 0x40, 0x2b, 0x96, 0x20, 0x18, 0xf8, 0x33, 0x68,
+  0x73, 0x14, 0x70, 0x4f, 0x0e, 0xfc, 0x58, 0xe3, 0x1a, 0x3c, 0x21, 0x58, 0xc4, 0x39, 0x08, 0x62,
+  0x0d, 0x25, 0x51, 0xb0, 0xaf, 0xbb, 0xff, 0x0b, 0xeb, 0x46, 0xe8, 0xee, 0xee, 0x14, 0x60, 0xdf,
+  0xee, 0x7d, 0x59, 0x67, 0x9e, 0xd1, 0x80, 0xcf, 0x09, 0x3e, 0x1b, 0x51, 0x80, 0x3a, 0xcd, 0x2b,
+  0x8d, 0xd0, 0x46, 0xe6, 0x62, 0xfc, 0x1b, 0x63, 0x17, 0x1d, 0x31, 0x68, 0x50, 0x6c, 0xb6, 0x60,
+  0xc3, 0x1f, 0xd8, 0xa0, 0x63, 0x89, 0xea, 0xc4, 0xcb, 0x6d, 0xbd, 0x2f, 0xdf, 0x0d, 0x48, 0x46,
+  0xa1, 0x81, 0xce, 0x6d, 0xc3, 0xe3, 0x30, 0xd9, 0xd7, 0xee, 0xf0, 0x02, 0x72, 0xc1, 0xd4, 0x5e,
+  0x56, 0x7e, 0x16, 0x05, 0x6d, 0xcb, 0x29, 0x9c, 0x06, 0x89, 0x5c, 0x00, 0x01, 0x65, 0x92, 0x33,
+  0x37, 0xb2, 0x73, 0x0c, 0x26, 0x30, 0x02, 0x17, 0x92, 0x4e, 0x80, 0x21, 0x8b, 0xa4, 0xac, 0xc0,
+  0xe7, 0xaf, 0xbf, 0x58, 0xb7, 0x05, 0x10, 0x44, 0x2c, 0x80, 0xbf, 0xac, 0xee, 0xd3, 0x2b, 0xa2,
+  0x6a, 0xaf, 0xa7, 0x91, 0x30, 0xd7, 0x9f, 0xad, 0x3e, 0xad, 0x00, 0xac, 0xdd, 0xcb, 0x2d, 0x57,
+  0x0d, 0xcf, 0x81, 0xde, 0x27, 0x13, 0x80, 0x5f, 0xbb, 0x7a, 0xbd, 0x32, 0xf7, 0x87, 0xa6, 0x87,
+  0x0f, 0x5b, 0x9a, 0xc4, 0x6b, 0x89, 0xb7, 0x30, 0xc9, 0x06, 0x2c, 0xcf, 0x07, 0x94, 0xfb, 0xec,
+  0x5f, 0x8b, 0xb5, 0x4f, 0xb4, 0x95, 0xad, 0x02, 0xb6, 0x3f, 0x02, 0x57, 0x60, 0xb6, 0xa7, 0x17,
+  0x12, 0x27, 0x1c, 0x5c, 0x8c, 0x6d, 0xad, 0x5b, 0xad, 0xa5, 0x68, 0x61, 0x98, 0x50, 0x8a, 0x16,
+  0x84, 0x2a, 0x04, 0x5b, 0xf7, 0x63, 0xa9, 0x13, 0x54, 0x1b, 0x3d, 0x94, 0x55, 0x3c, 0xc0, 0x1e,
+  0x7d, 0xc6, 0x21, 0x60, 0x32, 0x59, 0x2a, 0x94, 0x3b, 0xe0, 0x3c, 0xb9, 0x4d, 0x6a, 0x6b, 0x42,
+  0xb8, 0x81, 0x91, 0xef, 0x86, 0xbf, 0x43, 0x94, 0x76, 0x70, 0x7f, 0x46, 0x1b, 0x4e, 0x4b, 0x89,
+  0x9b, 0xed, 0xa1, 0x23, 0xca, 0x59, 0xa9, 0x37, 0x98, 0xcb, 0x3d, 0xed, 0xb4, 0x2d, 0xd3, 0x7d,
+  0xa5, 0x36, 0x00, 0x1e, 0xdd, 0xc0, 0x56, 0x13, 0x51, 0xd4, 0xcf, 0x6d, 0xed, 0x9e, 0x1e, 0x5f,
+  0x0c, 0xff, 0x06, 0x59, 0x37, 0x77, 0xe3, 0x7c, 0x5c, 0xfe, 0xa6, 0x5f, 0x05, 0x06, 0x04, 0x79,
+  0x53, 0x34, 0x90, 0xc7, 0x17, 0xde, 0x85, 0xd4, 0x1b, 0xd6, 0x80, 0xf3, 0x98, 0xa8, 0xd3, 0xcf,
+  0x25, 0x4b, 0x88, 0x43, 0x69, 0x49, 0x45, 0xee, 0x59, 0x54, 0xf6, 0x5d, 0x09, 0xd4, 0x38, 0x3c,
+  0x77, 0x59, 0xd0, 0x78, 0x7c, 0x75, 0x4a, 0x55, 0xa3, 0x88, 0x21, 0xf3, 0xb5, 0xad, 0xe2, 0x1c,
+  0x5e, 0x06, 0xcd, 0x3a, 0x5b, 0x56, 0x84, 0xca, 0xc6, 0x2c, 0x5d, 0xad, 0x70, 0xe6, 0xa1, 0x6e,
+  0x02, 0xcb, 0x75, 0x5c, 0xcf, 0x3b, 0xbc, 0x80, 0x09, 0xb1, 0x50, 0xe5, 0x21, 0xf8, 0x9a, 0xa5,
+  0xee, 0x5b, 0x20, 0xe2, 0x82, 0x79, 0xe5, 0xa3, 0xc8, 0xff, 0x87, 0x68, 0xe7, 0xc7, 0xb2, 0xc3,
+  0x73, 0x37, 0x02, 0xcb, 0xe5, 0x36, 0x77, 0xd4, 0x88, 0xd7, 0x5e, 0x2b, 0x5f, 0xfb, 0xd0, 0xc1,
+  0x1d, 0x57, 0x78, 0x70, 0x74, 0x76, 0xab, 0xa3, 0x74, 0xf1, 0x06, 0xcd, 0xac, 0xa5, 0xe1, 0xe2,
+  0x1a, 0x6e, 0xb2, 0xc8, 0xe4, 0x05, 0x59, 0x59, 0x36, 0x51, 0x77, 0x55, 0x92, 0x23, 0x17, 0xea,
+  0xdc, 0xe0, 0x36, 0x64, 0xbf, 0xb7, 0x6c, 0x25, 0x68, 0x80, 0x83, 0x3c, 0x67, 0xca, 0x55, 0xb7,
+  0x38, 0x23, 0x98, 0x4d, 0x9d, 0x38, 0x73, 0x08, 0xfc, 0x4a, 0xb0, 0x4b, 0x91, 0xe8, 0x33, 0x47,
+  0x23, 0x73, 0x52, 0x71, 0x24, 0xe6, 0x28, 0xe3, 0x04, 0x8a, 0x96, 0x2f, 0x46, 0x4e, 0xf3, 0x15,
+  0xd1, 0x96, 0x63, 0x2a, 0xc5, 0xa1, 0x3e, 0xa0, 0xcf, 0x50, 0xcc, 0x02, 0xc0, 0xc3, 0xaf, 0x89,
+  0x4c, 0xb8, 0x00, 0x60, 0xad, 0xd7, 0x6f, 0x8f, 0xdf, 0x9f, 0x59, 0xcb, 0xdf, 0x9f, 0x1d, 0x7e,
+  0x38, 0xdb, 0x3f, 0x39, 0xdc, 0xb7, 0x5a, 0x06, 0x00, 0x31, 0xbd, 0xfa, 0xaf, 0x9f, 0xbb, 0x10,
+  0x80, 0xbe, 0x7e, 0xee, 0xa9, 0xd5, 0xd1, 0xcf, 0xe6, 0xf5, 0x95, 0x15, 0x74, 0xcb, 0xd5, 0x7d,
+  0x55, 0xfe, 0x4b, 0xb8, 0x82, 0x4c, 0x7c, 0x21, 0x6e, 0x89, 0x91, 0x32, 0x6f, 0x5d, 0x83, 0xb1,
+  0x39, 0x64, 0x4f, 0x62, 0x5e, 0xc3, 0xd6, 0x30, 0xc8, 0x30, 0x72, 0x2a, 0x6f, 0x96, 0xb9, 0x92,
+  0xe9, 0x86, 0x32, 0x0d, 0x55, 0x08, 0x68, 0x24, 0xb0, 0xcb, 0xe2, 0x26, 0x55, 0x07, 0x90, 0x97,
+  0xa9, 0xf4, 0x55, 0x05, 0x4f, 0x58, 0x9d, 0x3c, 0xdd, 0x58, 0x61, 0xa4, 0xdc, 0x8c, 0xab, 0xee,
+  0xf7, 0xaa, 0xe1, 0x65, 0x8c, 0x90, 0x07, 0x0a, 0x6a, 0xef, 0x55, 0xf1, 0xc8, 0x65, 0x5b, 0x15,
+  0x38, 0x4c, 0xdc, 0x58, 0x32, 0xb1, 0xda, 0xc2, 0x25, 0x79, 0x29, 0x20, 0x29, 0xf3, 0xa0, 0x48,
+  0xb3, 0xa7, 0xcc, 0x3a, 0x90, 0x17, 0x9a, 0x2c, 0xb6, 0xc3, 0x2c, 0xc9, 0x85, 0xa5, 0x41, 0x36,
+  0x67, 0x40, 0xd1, 0xa0, 0x5d, 0x0d, 0x14, 0x38, 0x4a, 0xdf, 0xb6, 0xd4, 0x55, 0x28, 0x98, 0x46,
+  0x46, 0x8a, 0x85, 0x5e, 0x31, 0xc7, 0xd2, 0xd8, 0xec, 0x58, 0x59, 0xf5, 0x89, 0xb1, 0xe1, 0x6c,
+  0xe7, 0xd7, 0x9e, 0x8a, 0x05, 0x9b, 0x1b, 0xd2, 0x0d, 0xcb, 0x2e, 0x6f, 0x5c, 0xd3, 0xaa, 0xcd,
+  0x96, 0xca, 0xda, 0x8b, 0xeb, 0x58, 0xb0, 0x7a, 0xdc, 0xc3, 0x61, 0xf9, 0xd6, 0x36, 0x09, 0xc1,
+  0xdc, 0xdb, 0xce, 0x45, 0x61, 0x30, 0x57, 0x22, 0x5d, 0x11, 0x49, 0xde, 0x2d, 0x17, 0xca, 0x92,
+  0xde, 0x5a, 0x34, 0xe6, 0x00, 0x95, 0xdc, 0xbf, 0xf0, 0x83, 0x40, 0x16, 0xf7, 0x11, 0x5e, 0xd3,
+  0xf1, 0x43, 0xf3, 0x06, 0x26, 0xd8, 0xb7, 0x0f, 0x40, 0x66, 0xbc, 0x4e, 0x13, 0x1e, 0x8c, 0x31,
+  0xdd, 0xc7, 0xf7, 0xfe, 0xa8, 0x90, 0x2f, 0x6e, 0x10, 0x52, 0x12, 0x66, 0x84, 0x9e, 0x1b, 0x17,
+  0x31, 0x38, 0xde, 0xaa, 0x64, 0x17, 0x22, 0x44, 0xd2, 0x95, 0xa2, 0x3d, 0xf7, 0x6a, 0xca, 0x3f,
+  0x68, 0xc3, 0x90, 0xdd, 0x03, 0x6f, 0xde, 0x80, 0xa0, 0x5d, 0x02, 0x1d, 0xca, 0x5e, 0x65, 0x6e,
+  0xc8, 0x7e, 0x3d, 0x7d, 0xf7, 0xd6, 0xa1, 0x58, 0x41, 0xc3, 0x62, 0x9e, 0x44, 0x00, 0xb3, 0x1c,
+  0xf7, 0x01, 0x15, 0xf8, 0xba, 0x51, 0x14, 0xc8, 0x54, 0xd2, 0xa6, 0x41, 0x37, 0xcc, 0xec, 0x74,
+  0xe4, 0x5b, 0x66, 0x39, 0x72, 0x0c, 0xa6, 0x79, 0xe0, 0x35, 0xb4, 0x39, 0x55, 0xb8, 0x39, 0xcd,
+  0xe7, 0x4c, 0xa1, 0x11, 0xde, 0xab, 0x50, 0xb0, 0xd6, 0x44, 0x4c, 0x1e, 0xcd, 0x55, 0x09, 0x5c,
+  0x5e, 0xfd, 0x09, 0x18, 0xd6, 0xbf, 0x76, 0xe4, 0xc7, 0xda, 0x91, 0xbd, 0x15, 0x46, 0x7e, 0xaa,
+  0x1d, 0xb9, 0x61, 0x20, 0xad, 0x6c, 0x85, 0xfa, 0x12, 0x8a, 0xba, 0x3d, 0xcc, 0xde, 0xaf, 0x93,
+  0x4b, 0x65, 0xcb, 0xb7, 0x0a, 0x61, 0x96, 0xf4, 0x0e, 0x00, 0x10, 0xa2, 0x09, 0x4e, 0x03, 0xf2,
+  0x33, 0x27, 0x01, 0x69, 0xb2, 0x8e, 0xd1, 0x3a, 0x72, 0x23, 0x17, 0x4b, 0xcd, 0x42, 0x8c, 0xdf,
+  0xeb, 0x2b, 0xdb, 0xd3, 0xa9, 0x1b, 0x03, 0xd9, 0xe1, 0x95, 0xbe, 0x71, 0x0c, 0x15, 0x21, 0x19,
+  0x7b, 0x87, 0x23, 0xda, 0xa3, 0x95, 0x43, 0x75, 0x31, 0x73, 0xd8, 0xbe, 0xda, 0x68, 0x60, 0x43,
+  0x8e, 0xae, 0xec, 0xc5, 0xee, 0x64, 0x02, 0x03, 0xa7, 0x3c, 0x06, 0x9f, 0xa0, 0x82, 0x34, 0xe0,
+  0xe3, 0x94, 0xb9, 0x01, 0xdd, 0x6b, 0xf4, 0xb2, 0x18, 0x7b, 0xe9, 0xe3, 0x06, 0xa2, 0x28, 0xc7,
+  0x27, 0x60, 0x4b, 0x41, 0x20, 0xe6, 0xb2, 0x89, 0x36, 0x01, 0x9c, 0xc2, 0x87, 0x16, 0xcc, 0x4f,
+  0xee, 0x2b, 0xdd, 0xc8, 0xfa, 0xc8, 0xe0, 0x25, 0xaf, 0x83, 0xd5, 0x0c, 0x51, 0x47, 0x1c, 0x43,
+  0x81, 0x72, 0x3c, 0x3a, 0x54, 0x11, 0x98, 0x81, 0xc5, 0x0b, 0xae, 0x88, 0x60, 0xec, 0x57, 0x0a,
+  0x80, 0x35, 0xe6, 0x20, 0xaa, 0xa2, 0xbc, 0x0a, 0x7d, 0xf9, 0x24, 0xeb, 0xe5, 0xbe, 0x00, 0x84,
+  0xf2, 0x19, 0x48, 0x66, 0x6e, 0x80, 0x5c, 0xec, 0x14, 0xea, 0xd4, 0x59, 0x8f, 0x36, 0xff, 0x85,
+  0x68, 0xb5, 0x40, 0x56, 0xc5, 0x0d, 0x33, 0x5d, 0xaa, 0x82, 0xbd, 0xec, 0x58, 0xa0, 0xaa, 0xd6,
+  0xff, 0x11, 0xde, 0x3e, 0x97, 0x7b, 0x4e, 0x89, 0xc4, 0x3d, 0xb9, 0x01, 0x21, 0x40, 0x3d, 0xb1,
+  0x44, 0x3c, 0xb4, 0x08, 0x7a, 0xa3, 0xb5, 0x29, 0xb7, 0x3e, 0xdd, 0xe4, 0x58, 0xad, 0x66, 0xe9,
+  0x96, 0x26, 0x25, 0x0c, 0x89, 0x91, 0xe7, 0xdf, 0x53, 0xc9, 0x04, 0xbd, 0x38, 0x15, 0x59, 0x3c,
+  0xe2, 0x26, 0x58, 0x91, 0xe6, 0xa8, 0x55, 0x81, 0xa6, 0xd1, 0xcf, 0xb6, 0x94, 0x45, 0x4a, 0x35,
+  0xc9, 0x6e, 0x35, 0x59, 0x89, 0x46, 0xd0, 0xfa, 0x64, 0xa9, 0x06, 0x08, 0x39, 0xe5, 0xa2, 0xcd,
+  0xf0, 0xa7, 0x87, 0x82, 0x87, 0x26, 0x93, 0xa6, 0xc0, 0x58, 0x71, 0xe3, 0x05, 0x44, 0xa8, 0xda,
+  0x0a, 0x12, 0x0e, 0x04, 0x84, 0x44, 0x8d, 0x24, 0xf8, 0x00, 0x20, 0x24, 0xeb, 0x78, 0x0c, 0x98,
+  0x14, 0x22, 0x99, 0x4d, 0x9d, 0x0a, 0xff, 0xa6, 0x6e, 0x5d, 0x34, 0x5e, 0xbb, 0x3c, 0x0e, 0x46,
+  0x30, 0x31, 0xae, 0xf6, 0xec, 0xa1, 0x81, 0x59, 0x16, 0x6d, 0x7b, 0xb5, 0x2c, 0x9d, 0xbd, 0xe7,
+  0x2b, 0xaa, 0xa0, 0x8d, 0x66, 0x16, 0x4f, 0x23, 0x29, 0x65, 0x39, 0x96, 0x9f, 0x20, 0x23, 0x26,
+  0x6e, 0xb4, 0xde, 0x89, 0x9e, 0xea, 0x8b, 0xa7, 0x34, 0xb0, 0x6a, 0xc9, 0x53, 0x19, 0x8b, 0xf2,
+  0x77, 0xbd, 0x2f, 0xb4, 0x81, 0x2d, 0x22, 0x65, 0xdd, 0x32, 0x60, 0xd3, 0x4e, 0x46, 0x6e, 0x4c,
+  0x86, 0x1b, 0x2d, 0xe1, 0x8e, 0xa6, 0x27, 0x50, 0x19, 0xfb, 0xa1, 0x9f, 0x4c, 0xb9, 0xe7, 0x58,
+  0xa6, 0xbb, 0x94, 0x0c, 0xb3, 0x24, 0x76, 0x9d, 0xd3, 0x9a, 0x79, 0xaa, 0x79, 0x07, 0xc5, 0xd8,
+  0x1e, 0xbc, 0x6d, 0xfc, 0x96, 0xe4, 0x56, 0xdf, 0x87, 0xbc, 0x6d, 0xa4, 0x1f, 0xe8, 0x48, 0xaf,
+  0xa5, 0xa5, 0xdf, 0x9b, 0x21, 0x5d, 0xd6, 0x22, 0x0a, 0x1c, 0xac, 0xa2, 0x6f, 0x0d, 0xa4, 0xe4,
+  0x1c, 0x95, 0x76, 0x55, 0x4a, 0x3a, 0xaa, 0xa7, 0xae, 0x52, 0xcd, 0xd5, 0xc9, 0x13, 0x54, 0x14,
+  0xf4, 0x1b, 0xe3, 0x53, 0x91, 0xba, 0x56, 0xcf, 0xa7, 0x72, 0x05, 0x81, 0x0f, 0xbb, 0x33, 0x2c,
+  0xed, 0xf3, 0x43, 0x3a, 0x12, 0xf8, 0x52, 0x07, 0xcd, 0x8f, 0xf2, 0x54, 0x08, 0xc7, 0x59, 0x15,
+  0x8d, 0x87, 0x40, 0xe4, 0x81, 0x79, 0x62, 0xd7, 0x4c, 0xa9, 0x74, 0xb6, 0xb7, 0x84, 0x5a, 0x7e,
+  0x7c, 0xd7, 0x4c, 0xaa, 0x38, 0xe5, 0x5b, 0x42, 0xc7, 0x38, 0xcd, 0x6b, 0xa6, 0x64, 0x1e, 0xfb,
+  0x19, 0xb4, 0x6e, 0x95, 0x8a, 0x82, 0xcc, 0xcf, 0xf5, 0x81, 0xea, 0x53, 0x9c, 0x55, 0x72, 0x64,
+  0x58, 0xc8, 0x5d, 0x60, 0x71, 0xa9, 0xb9, 0x83, 0xb1, 0xd5, 0x5a, 0xfa, 0x52, 0x3c, 0xa0, 0x43,
+  0xca, 0xfc, 0xab, 0x00, 0xc8, 0xb6, 0x77, 0xcf, 0x52, 0xd5, 0xc0, 0xd2, 0x41, 0x87, 0x71, 0x0c,
+  0x49, 0x05, 0x74, 0x96, 0x7b, 0xe4, 0x72, 0x30, 0x00, 0x49, 0xb3, 0x1d, 0xea, 0x73, 0xce, 0x5b,
+  0xe3, 0xc3, 0x44, 0x9c, 0x63, 0x82, 0x6b, 0xfd, 0x6c, 0x21, 0xae, 0x84, 0x19, 0xca, 0x7f, 0xe8,
+  0x20, 0xb6, 0xea, 0xdd, 0x4e, 0x12, 0x05, 0x7e, 0x4a, 0x7b, 0x9d, 0x7d, 0x03, 0x62, 0xa8, 0xbb,
+  0xde, 0x5d, 0x44, 0x82, 0x8f, 0x4d, 0xbf, 0xbf, 0x69, 0x95, 0x50, 0xa2, 0xfa, 0x79, 0x0b, 0x4c,
+  0xcc, 0x97, 0x91, 0xcf, 0xea, 0x59, 0xad, 0xfa, 0x3c, 0x4a, 0x76, 0xcd, 0x33, 0xa4, 0x02, 0x43,
+  0x1a, 0x43, 0xc6, 0x1b, 0x41, 0x7a, 0x4e, 0x05, 0x43, 0xe9, 0x63, 0x12, 0x2d, 0x2f, 0x00, 0xdc,
+  0xb3, 0x2a, 0x40, 0x24, 0xad, 0xe6, 0xdb, 0x75, 0x76, 0x33, 0x11, 0x48, 0x0e, 0x69, 0x91, 0xc9,
+  0x5c, 0x07, 0x5f, 0xf9, 0x3d, 0xbd, 0x1a, 0xd8, 0xba, 0x6c, 0x76, 0x68, 0xb3, 0xc4, 0xa9, 0xa2,
+  0xc2, 0xd5, 0xb5, 0x43, 0x3f, 0x2e, 0x1b, 0xfa, 0xe7, 0xb5, 0x43, 0x3f, 0xdd, 0x15, 0x3f, 0x70,
+  0xd1, 0xe7, 0x50, 0x18, 0xfd, 0x0f, 0xa1, 0xe3, 0x67, 0x58, 0x7d, 0x9d, 0x4d, 0x6f, 0x2a, 0x3b,
+  0x5e, 0xcd, 0x42, 0x57, 0xb0, 0xca, 0x0f, 0x9d, 0x8f, 0x9d, 0x4f, 0x79, 0x1a, 0x73, 0x9d, 0x11,
+  0x56, 0xb9, 0x5e, 0xc1, 0x02, 0xcd, 0x5b, 0x37, 0x37, 0x06, 0xaf, 0xe3, 0x77, 0xa7, 0x52, 0xa5,
+  0xea, 0xda, 0x90, 0xb5, 0x70, 0xfa, 0x91, 0xaa, 0x91, 0xaf, 0xb8, 0x8b, 0xd2, 0xb0, 0x14, 0xaf,
+  0x6d, 0xbc, 0x8a, 0x80, 0x23, 0x91, 0xff, 0x0e, 0x64, 0x61, 0xbe, 0xda, 0x2d, 0xfa, 0xff, 0x69,
+  0x7f, 0xa9, 0x32, 0x4e, 0xb2, 0x30, 0xa4, 0x92, 0x55, 0xae, 0x51, 0x27, 0xd1, 0x4d, 0x3b, 0x26,
+  0x8e, 0xbc, 0x88, 0x82, 0xf9, 0x2e, 0x7d, 0xfa, 0xa1, 0x0a, 0x5c, 0x2a, 0x12, 0xf3, 0xee, 0x56,
+  0x71, 0xc0, 0x58, 0xca, 0x96, 0xcc, 0x6b, 0x53, 0x77, 0xd8, 0x8a, 0x12, 0xd1, 0xf9, 0x12, 0x8d,
+  0x2f, 0x97, 0xff, 0x2d, 0x37, 0x38, 0x16, 0x24, 0xd2, 0xa8, 0x4c, 0x63, 0xa7, 0xad, 0x7f, 0x9d,
+  0xe5, 0x2f, 0x5c, 0xa6, 0xbd, 0x6b, 0x6e, 0x2f, 0x6b, 0xe8, 0xbf, 0x47, 0x04, 0x5f, 0x9e, 0x97,
+  0x9f, 0x1c, 0x3e, 0x7f, 0x77, 0x72, 0xf0, 0xfa, 0xed, 0xcb, 0xf3, 0xd3, 0xb3, 0xfd, 0x93, 0xb3,
+  0xc3, 0x83, 0x6a, 0x82, 0x5e, 0xda, 0x1d, 0x28, 0xe5, 0xfc, 0x4d, 0x4e, 0x92, 0x6f, 0xe5, 0x26,
+  0xb8, 0x69, 0x0b, 0xa5, 0x97, 0xe3, 0x58, 0x2b, 0xd7, 0x0a, 0x26, 0x4f, 0xef, 0x8e, 0x8f, 0xaf,
+  0xe1, 0xa9, 0x5c, 0x28, 0xac, 0xc8, 0x94, 0x80, 0xec, 0xd7, 0xbb, 0x01, 0x4b, 0x6f, 0xde, 0x9f,
+  0x9e, 0x9d, 0x1f, 0x1c, 0x1e, 0x1d, 0x9e, 0x1d, 0x9e, 0xbf, 0x78, 0x7d, 0x02, 0x38, 0x57, 0x62,
+  0x69, 0xd9, 0x94, 0xfb, 0xc6, 0xa6, 0xb6, 0x1b, 0xd0, 0xf1, 0x3b, 0xe3, 0x97, 0x7e, 0x02, 0x89,
+  0x0e, 0x53, 0x37, 0xa7, 0xfd, 0x14, 0x81, 0x9d, 0xc4, 0xc4, 0x5c, 0xb2, 0x32, 0x11, 0xf2, 0x05,
+  0xce, 0x6e, 0x8a, 0x11, 0x2b, 0xa7, 0x28, 0x72, 0x8b, 0xb0, 0xb0, 0x9d, 0x7e, 0xd3, 0x26, 0x20,
+  0x5e, 0xcf, 0x66, 0x23, 0x91, 0xc1, 0x78, 0xdc, 0xec, 0x91, 0x77, 0x1d, 0x30, 0xf0, 0x95, 0x2e,
+  0xcc, 0x16, 0x3e, 0x85, 0xcd, 0xfb, 0x71, 0x5e, 0x87, 0xa9, 0x6b, 0x0b, 0x16, 0x96, 0xf6, 0xf2,
+  0x46, 0x4d, 0x03, 0x7a, 0xe5, 0xb7, 0xc1, 0xf5, 0x1e, 0xea, 0x5f, 0x7f, 0xe1, 0x1d, 0x83, 0x87,
+  0x45, 0x4a, 0x08, 0x45, 0x18, 0x32, 0xd0, 0x9c, 0xa1, 0x14, 0xb7, 0xc0, 0xf3, 0x34, 0xa5, 0x04,
+  0x81, 0xa5, 0x9b, 0xde, 0x44, 0xaf, 0xf9, 0xf0, 0xa9, 0x7a, 0xa3, 0xbb, 0x0a, 0x50, 0x6f, 0xe9,
+  0x6e, 0xa5, 0xa2, 0xe4, 0xa4, 0xe2, 0x85, 0x7f, 0x09, 0x84, 0x7b, 0xb4, 0xa3, 0x72, 0x69, 0x69,
+  0x41, 0xee, 0x47, 0x90, 0x3f, 0x40, 0x48, 0x00, 0xcd, 0xbb, 0x18, 0x73, 0xc3, 0xd2, 0x26, 0x28,
+  0x6d, 0xa2, 0xe1, 0xf5, 0x9a, 0x10, 0xed, 0x0f, 0x37, 0x6e, 0xd7, 0xe5, 0x76, 0xab, 0xa0, 0xcd,
+  0x50, 0x6a, 0xc5, 0xdb, 0x88, 0xca, 0xb7, 0x4a, 0x27, 0x37, 0xb5, 0x8b, 0xb9, 0xdd, 0x35, 0x29,
+  0xa9, 0xcd, 0x73, 0xa2, 0xf3, 0xb4, 0x10, 0x35, 0x7d, 0x6a, 0xbc, 0x05, 0x05, 0x21, 0x32, 0x61,
+  0xe5, 0x5b, 0xeb, 0xeb, 0xac, 0x72, 0x09, 0x1d, 0xaf, 0x43, 0x95, 0x2e, 0x95, 0x97, 0xad, 0xc6,
+  0xb8, 0x7b, 0x1e, 0x8b, 0x2c, 0xbd, 0xc3, 0x4e, 0x0b, 0xb2, 0x4c, 0x24, 0x7e, 0x7a, 0x3d, 0x7a,
+  0x03, 0x0f, 0x6d, 0x0a, 0x44, 0xe5, 0xef, 0x66, 0xdc, 0x7a, 0xdd, 0x25, 0x97, 0x94, 0xb9, 0x75,
+  0xee, 0x8d, 0x3f, 0x48, 0x14, 0xd7, 0xef, 0xbc, 0x91, 0x85, 0x82, 0x6d, 0x6b, 0xf8, 0xff, 0x39,
+  0x39, 0xd9, 0xa2, 0x80, 0xc1, 0x08, 0xb9, 0x33, 0x71, 0xd6, 0xd9, 0xfd, 0xe3, 0xa3, 0xfd, 0x8f,
+  0xcf, 0xf6, 0x9f, 0xff, 0x4b, 0x87, 0xb7, 0xfb, 0x68, 0x78, 0xf7, 0xdf, 0x0a, 0x96, 0x5f, 0xb1,
+  0xff, 0x39, 0x68, 0x99, 0xab, 0xb3, 0xfa, 0x95, 0x99, 0x5b, 0x2b, 0xb4, 0xf2, 0xd5, 0x80, 0xbf,
+  0x47, 0x62, 0xb1, 0xb2, 0x4a, 0xd6, 0xae, 0x0f, 0xde, 0x3f, 0x23, 0x62, 0xb5, 0xdb, 0xed, 0xfc,
+  0xbb, 0x49, 0x2c, 0x90, 0xdf, 0x4e, 0xc1, 0xc6, 0xca, 0x69, 0xac, 0xea, 0x81, 0xa7, 0x03, 0xf6,
+  0xdd, 0x21, 0x33, 0xf9, 0xf1, 0x07, 0xb3, 0x01, 0x70, 0xb6, 0xd2, 0xb9, 0xac, 0xbc, 0xf5, 0x4b,
+  0xdf, 0x7d, 0x69, 0xb2, 0x03, 0xf5, 0x95, 0x98, 0x96, 0xbe, 0x6f, 0x82, 0x03, 0x1c, 0x3f, 0x0c,
+  0x79, 0xfc, 0xea, 0xec, 0xcd, 0x11, 0xca, 0xda, 0x5a, 0x7e, 0xa0, 0x8b, 0xcc, 0xd4, 0x6f, 0xd4,
+  0x60, 0x47, 0x11, 0x91, 0x5c, 0x8d, 0xd9, 0x47, 0x90, 0xf8, 0xa4, 0xfa, 0x40, 0xcc, 0xb6, 0x64,
+  0x87, 0xa2, 0x72, 0x96, 0xcf, 0xf9, 0x49, 0x29, 0x52, 0x87, 0xb2, 0xd8, 0xc1, 0x3b, 0x13, 0x95,
+  0x2e, 0x65, 0x73, 0x30, 0x3b, 0x52, 0x71, 0x65, 0xd3, 0xc5, 0x77, 0xd5, 0x9a, 0x9f, 0x77, 0x1a,
+  0xe7, 0x18, 0x72, 0x99, 0x6e, 0x84, 0x77, 0x98, 0x9f, 0x4f, 0xfd, 0xc0, 0xb3, 0x25, 0xe1, 0x56,
+  0x7f, 0xf5, 0xed, 0xe5, 0x1a, 0x4f, 0x0e, 0xe5, 0x05, 0xeb, 0x26, 0x69, 0xd3, 0xd7, 0x9d, 0x7e,
+  0xcc, 0x46, 0xab, 0x42, 0x74, 0xf9, 0xa7, 0xaa, 0x60, 0x81, 0xf0, 0x24, 0x3c, 0xfe, 0xfe, 0xe4,
+  0x35, 0xfe, 0x65, 0x29, 0x48, 0x0b, 0x40, 0xc4, 0x61, 0xe5, 0xc8, 0xe0, 0xff, 0x1d, 0xef, 0x16,
+  0x7d, 0xac, 0xbf, 0xcc, 0x61, 0x65, 0xee, 0x60, 0xc6, 0xae, 0x75, 0x56, 0xfa, 0x46, 0x15, 0xe2,
+  0x77, 0x05, 0x0a, 0x19, 0x96, 0x6f, 0x74, 0x4a, 0x8c, 0xfa, 0x85, 0x94, 0x54, 0x7e, 0xa7, 0x8a,
+  0x2d, 0xa6, 0x16, 0xa5, 0x2f, 0x5b, 0x55, 0x12, 0x8b, 0x15, 0xb4, 0x28, 0x7d, 0xa6, 0xd0, 0x22,
+  0x1d, 0x55, 0xca, 0x4b, 0xb9, 0xe5, 0xc3, 0xc9, 0x66, 0xd5, 0x62, 0x0f, 0x17, 0x02, 0x31, 0xde,
+  0x79, 0x41, 0x1e, 0x64, 0x89, 0x51, 0x5a, 0xb4, 0x85, 0xc7, 0x69, 0x0f, 0xca, 0x51, 0x9b, 0x8e,
+  0xe6, 0xae, 0x49, 0x72, 0xd0, 0xe0, 0xaf, 0x37, 0x0d, 0x78, 0x85, 0xf3, 0xff, 0x8d, 0x2c, 0x84,
+  0xae, 0xf2, 0x14, 0xb2, 0xa8, 0xc6, 0xba, 0xd6, 0xca, 0x26, 0xd4, 0x70, 0x3d, 0xee, 0xe0, 0xdd,
+  0x1b, 0xc5, 0x02, 0x7e, 0x23, 0x8f, 0x7b, 0x95, 0x3b, 0x87, 0x40, 0xcb, 0xf8, 0x86, 0x8d, 0xbc,
+  0x49, 0xab, 0xaf, 0x88, 0xe2, 0x53, 0x65, 0x33, 0xa1, 0x72, 0x74, 0x9d, 0xf7, 0x28, 0xf3, 0xb8,
+  0x86, 0xe7, 0x88, 0xbb, 0x1d, 0xfd, 0x9d, 0xa6, 0xdd, 0x8e, 0xfa, 0xa3, 0x3c, 0x1d, 0xf9, 0x47,
+  0xea, 0xfe, 0x0b, 0x52, 0x95, 0x47, 0x08, 0xb5, 0x4e, 0x00, 0x00,
+};
+
+#endif // WEB_ASSETS_H
@@ -0,0 +1,353 @@
+#include "NativeSim.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <random>
+#include <vector>
+
+HardwareSerial Serial;
+EspClass ESP;
+
+// --- Clock ---
+static std::atomic<uint64_t> simClockUs{0};
+static std::atomic<bool> hostClock{false};
+static std::atomic<uint64_t> hostOffsetUs{0};
+static const std::chrono::steady_clock::time_point hostStart = std::chrono::steady_clock::now();
+
+uint64_t simMicros() {
+  if (hostClock.load(std::memory_order_relaxed)) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - hostStart)
+               .count() +
+           hostOffsetUs.load(std::memory_order_relaxed);
+  }
+  return simClockUs.load(std::memory_order_relaxed);
+}
+
+void simSetMicros(uint64_t us) {
+  simClockUs.store(us, std::memory_order_relaxed);
+}
+
+void simAdvanceMicros(uint64_t us) {
+  simClockUs.fetch_add(us, std::memory_order_relaxed);
+}
+
+void simUseHostClock(bool host, uint64_t offsetUs) {
+  hostOffsetUs.store(offsetUs, std::memory_order_relaxed);
+  hostClock.store(host, std::memory_order_relaxed);
+}
+
+unsigned long micros() {
+  return (uint32_t)simMicros();
+}
+
+unsigned long millis() {
+  return (uint32_t)(simMicros() / 1000);
+}
+
+void delay(unsigned long ms) {
+  if (!hostClock.load(std::memory_order_relaxed)) simAdvanceMicros(ms * 1000ULL);
+}
+
+void delayMicroseconds(unsigned int us) {
+  if (!hostClock.load(std::memory_order_relaxed)) simAdvanceMicros(us);
+}
+
+uint32_t esp_random() {
+  static std::mt19937 gen(std::random_device{}());
+  static std::mutex lock;
+  std::lock_guard<std::mutex> guard(lock);
+  return gen();
+}
+
+// --- Print ---
+size_t Print::printf(const char* fmt, ...) {
+  char buf[256];
+  va_list args;
+  va_start(args, fmt);
+  int n = vsnprintf(buf, sizeof(buf), fmt, args);
+  va_end(args);
+  if (n < 0) return 0;
+  return write((const uint8_t*)buf, (size_t)n < sizeof(buf) ? n : sizeof(buf) - 1);
+}
+
+// --- Serial ---
+void HardwareSerial::simAttach(int newFd) {
+  fd = newFd;
+  if (fd >= 0) fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+}
+
+void HardwareSerial::fill() {
+  if (fd < 0) return;
+  if (rxPos == rx.size()) {
+    rx.clear();
+    rxPos = 0;
+  }
+  char buf[256];
+  ssize_t n;
+  while ((n = ::read(fd, buf, sizeof(buf))) > 0) rx.append(buf, n);
+}
+
+size_t HardwareSerial::write(const uint8_t* data, size_t len) {
+  if (fd < 0) return fwrite(data, 1, len, stdout);
+  size_t sent = 0;
+  while (sent < len) {
+    ssize_t n = ::write(fd, data + sent, len - sent);
+    if (n > 0) {
+      sent += n;
+    } else if (n < 0 && (errno == EAGAIN || errno == EINTR)) {
+      struct pollfd pfd = {fd, POLLOUT, 0};
+      ::poll(&pfd, 1, 10); // Like a full UART FIFO: wait for room
+    } else {
+      break;
+    }
+  }
+  return sent;
+}
+
+void HardwareSerial::flush() {
+  if (fd < 0) fflush(stdout);
+}
+
+// --- Tasks ---
+static std::vector<SimTask>& tasks() {
+  static std::vector<SimTask> list;
+  return list;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char* name, uint32_t stackSize, void* arg,
+                                   UBaseType_t priority, TaskHandle_t* handle, BaseType_t core) {
+  tasks().push_back({fn, name, arg, stackSize, priority, core});
+  if (handle) *handle = (TaskHandle_t)(uintptr_t)tasks().size();
+  return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t) {}
+
+void vTaskDelay(TickType_t ticks) {
+  delay(ticks * portTICK_PERIOD_MS);
+}
+
+void vTaskDelayUntil(TickType_t* lastWake, TickType_t period) {
+  *lastWake += period;
+  int32_t ahead = (int32_t)(*lastWake - xTaskGetTickCount());
+  if (ahead > 0) delay(ahead * portTICK_PERIOD_MS);
+}
+
+TickType_t xTaskGetTickCount() {
+  return (TickType_t)millis();
+}
+
+size_t simTaskCount() {
+  return tasks().size();
+}
+
+const SimTask* simFindTask(const char* name) {
+  for (const SimTask& task : tasks()) {
+    if (strcmp(task.name, name) == 0) return &task;
+  }
+  return nullptr;
+}
+
+// --- Semaphores ---
+// Every semaphore the firmware makes is a mutex
+SemaphoreHandle_t xSemaphoreCreateMutex() {
+  return new std::timed_mutex;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks) {
+  std::timed_mutex* mutex = static_cast<std::timed_mutex*>(sem);
+  if (ticks == portMAX_DELAY) {
+    mutex->lock();
+    return pdTRUE;
+  }
+  return mutex->try_lock_for(std::chrono::milliseconds(ticks * portTICK_PERIOD_MS)) ? pdTRUE : pdFALSE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem) {
+  static_cast<std::timed_mutex*>(sem)->unlock();
+  return pdTRUE;
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t sem) {
+  delete static_cast<std::timed_mutex*>(sem);
+}
+
+// --- Heap ---
+// Each block carries its size in front so frees can be counted in bytes
+static const size_t HEAP_HEADER = alignof(std::max_align_t);
+
+static std::atomic<uint32_t> heapAllocations{0};
+static std::atomic<uint32_t> heapFrees{0};
+static std::atomic<size_t> heapLive{0};
+static std::atomic<size_t> heapPeak{0};
+
+static void* countedAlloc(size_t size) {
+  char* block = (char*)malloc(size + HEAP_HEADER);
+  if (!block) return nullptr;
+  memcpy(block, &size, sizeof(size));
+  heapAllocations.fetch_add(1, std::memory_order_relaxed);
+  size_t live = heapLive.fetch_add(size, std::memory_order_relaxed) + size;
+  size_t peak = heapPeak.load(std::memory_order_relaxed);
+  while (live > peak && !heapPeak.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+  }
+  return block + HEAP_HEADER;
+}
+
+static void countedFree(void* ptr) {
+  if (!ptr) return;
+  char* block = (char*)ptr - HEAP_HEADER;
+  size_t size;
+  memcpy(&size, block, sizeof(size));
+  heapFrees.fetch_add(1, std::memory_order_relaxed);
+  heapLive.fetch_sub(size, std::memory_order_relaxed);
+  free(block);
+}
+
+SimHeapStats simHeapStats() {
+  SimHeapStats stats;
+  stats.allocations = heapAllocations.load(std::memory_order_relaxed);
+  stats.frees = heapFrees.load(std::memory_order_relaxed);
+  stats.liveBytes = heapLive.load(std::memory_order_relaxed);
+  stats.peakBytes = heapPeak.load(std::memory_order_relaxed);
+  return stats;
+}
+
+void simResetHeapPeak() {
+  heapPeak.store(heapLive.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+uint32_t EspClass::getFreeHeap() {
+  size_t live = heapLive.load(std::memory_order_relaxed);
+  return live < HEAP_SIZE ? HEAP_SIZE - (uint32_t)live : 0;
+}
+
+uint32_t EspClass::getMinFreeHeap() {
+  size_t peak = heapPeak.load(std::memory_order_relaxed);
+  return peak < HEAP_SIZE ? HEAP_SIZE - (uint32_t)peak : 0;
+}
+
+void* operator new(size_t size) {
+  void* ptr = countedAlloc(size);
+  if (!ptr) throw std::bad_alloc();
+  return ptr;
+}
+
+void* operator new[](size_t size) {
+  return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+  return countedAlloc(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+  return countedAlloc(size);
+}
+
+void operator delete(void* ptr) noexcept {
+  countedFree(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+  countedFree(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+  countedFree(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+  countedFree(ptr);
+}
+
+// --- Strings ---
+static std::atomic<uint32_t> stringCompares{0};
+
+void simCountStringCompare() {
+  stringCompares.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint32_t simStringCompares() {
+  return stringCompares.load(std::memory_order_relaxed);
+}
+
+void simResetStringCompares() {
+  stringCompares = 0;
+}
+
+// --- LEDC ---
+static SimLedcChannel ledcChannels[LEDC_CHANNEL_MAX] = {
+    {-1, false, 0, 0}, {-1, false, 0, 0}, {-1, false, 0, 0}, {-1, false, 0, 0},
+    {-1, false, 0, 0}, {-1, false, 0, 0}, {-1, false, 0, 0}, {-1, false, 0, 0},
+};
+static uint32_t ledcFrequency = 0;
+static uint8_t ledcResolution = 0;
+static uint32_t ledcSetDutyCalls = 0;
+static uint32_t ledcUpdateCalls = 0;
+
+esp_err_t ledc_timer_config(const ledc_timer_config_t* config) {
+  ledcFrequency = config->freq_hz;
+  ledcResolution = (uint8_t)config->duty_resolution;
+  return ESP_OK;
+}
+
+esp_err_t ledc_channel_config(const ledc_channel_config_t* config) {
+  if (config->channel >= LEDC_CHANNEL_MAX) return ESP_ERR_INVALID_ARG;
+  SimLedcChannel& ch = ledcChannels[config->channel];
+  ch.gpio = config->gpio_num;
+  ch.running = true;
+  ch.duty = ch.pending = config->duty;
+  return ESP_OK;
+}
+
+esp_err_t ledc_set_duty(ledc_mode_t, ledc_channel_t channel, uint32_t duty) {
+  if (channel >= LEDC_CHANNEL_MAX) return ESP_ERR_INVALID_ARG;
+  ledcChannels[channel].pending = duty;
+  ledcSetDutyCalls++;
+  return ESP_OK;
+}
+
+esp_err_t ledc_update_duty(ledc_mode_t, ledc_channel_t channel) {
+  if (channel >= LEDC_CHANNEL_MAX) return ESP_ERR_INVALID_ARG;
+  ledcChannels[channel].duty = ledcChannels[channel].pending;
+  ledcUpdateCalls++;
+  return ESP_OK;
+}
+
+esp_err_t ledc_stop(ledc_mode_t, ledc_channel_t channel, uint32_t) {
+  if (channel >= LEDC_CHANNEL_MAX) return ESP_ERR_INVALID_ARG;
+  ledcChannels[channel].running = false;
+  ledcChannels[channel].duty = 0;
+  return ESP_OK;
+}
+
+const SimLedcChannel& simLedcChannel(ledc_channel_t channel) {
+  return ledcChannels[channel];
+}
+
+uint32_t simLedcFrequency() {
+  return ledcFrequency;
+}
+
+uint8_t simLedcResolutionBits() {
+  return ledcResolution;
+}
+
+uint32_t simLedcSetDutyCalls() {
+  return ledcSetDutyCalls;
+}
+
+uint32_t simLedcUpdateCalls() {
+  return ledcUpdateCalls;
+}
+
+void simLedcResetCounts() {
+  ledcSetDutyCalls = 0;
+  ledcUpdateCalls = 0;
+}
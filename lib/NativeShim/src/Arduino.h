@@ -0,0 +1,237 @@
+#ifndef ARDUINO_H
+#define ARDUINO_H
+
+// Host stand-in for the parts of the ESP32 Arduino core (and the FreeRTOS
+// and esp-idf calls that come with it) the firmware uses. Only built for
+// [env:native]; see NativeSim.h for how tests drive it.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <string>
+
+#define PROGMEM
+#define F(s) (s)
+#define pgm_read_byte(p) (*(const uint8_t*)(p))
+#define IRAM_ATTR
+
+typedef uint8_t byte;
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+uint32_t esp_random();
+
+template <typename T, typename L, typename H>
+T constrain(T x, L low, H high) {
+  return x < low ? (T)low : (x > high ? (T)high : x);
+}
+
+// --- String ---
+// Every String comparison is counted (see simStringCompares() in NativeSim.h)
+void simCountStringCompare();
+
+class String {
+public:
+  String() {}
+  String(const char* s) : str(s ? s : "") {}
+  String(const std::string& s) : str(s) {}
+  explicit String(char c) : str(1, c) {}
+  explicit String(int v) : str(std::to_string(v)) {}
+  explicit String(unsigned v) : str(std::to_string(v)) {}
+  explicit String(long v) : str(std::to_string(v)) {}
+  explicit String(unsigned long v) : str(std::to_string(v)) {}
+  explicit String(float v, unsigned decimals = 2) { fromDouble(v, decimals); }
+  explicit String(double v, unsigned decimals = 2) { fromDouble(v, decimals); }
+
+  const char* c_str() const { return str.c_str(); }
+  unsigned length() const { return str.size(); }
+  bool isEmpty() const { return str.empty(); }
+  void reserve(unsigned size) { str.reserve(size); }
+  char operator[](unsigned i) const { return i < str.size() ? str[i] : '\0'; }
+  char charAt(unsigned i) const { return (*this)[i]; }
+
+  long toInt() const { return atol(str.c_str()); }
+  float toFloat() const { return (float)atof(str.c_str()); }
+
+  int indexOf(char c, unsigned from = 0) const { return found(str.find(c, from)); }
+  int indexOf(const char* s, unsigned from = 0) const { return found(str.find(s, from)); }
+  bool startsWith(const char* prefix) const { return str.compare(0, strlen(prefix), prefix) == 0; }
+  bool endsWith(const char* suffix) const {
+    size_t n = strlen(suffix);
+    return str.size() >= n && str.compare(str.size() - n, n, suffix) == 0;
+  }
+  String substring(unsigned from) const { return from < str.size() ? String(str.substr(from)) : String(); }
+  String substring(unsigned from, unsigned to) const {
+    return from < to && from < str.size() ? String(str.substr(from, to - from)) : String();
+  }
+
+  String& operator+=(const String& s) { str += s.str; return *this; }
+  String& operator+=(const char* s) { str += s; return *this; }
+  String& operator+=(char c) { str += c; return *this; }
+  friend String operator+(const String& a, const String& b) { return String(a.str + b.str); }
+  friend String operator+(const String& a, const char* b) { return String(a.str + b); }
+  friend String operator+(const char* a, const String& b) { return String(a + b.str); }
+
+  bool operator==(const String& s) const { simCountStringCompare(); return str == s.str; }
+  bool operator==(const char* s) const { simCountStringCompare(); return str == s; }
+  bool operator!=(const String& s) const { simCountStringCompare(); return str != s.str; }
+  bool operator!=(const char* s) const { simCountStringCompare(); return str != s; }
+
+private:
+  std::string str;
+
+  void fromDouble(double v, unsigned decimals) {
+    char buf[48];
+    snprintf(buf, sizeof(buf), "%.*f", (int)decimals, v);
+    str = buf;
+  }
+  static int found(size_t at) { return at == std::string::npos ? -1 : (int)at; }
+};
+
+// --- Print / Stream ---
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t* data, size_t len) {
+    size_t n = 0;
+    while (n < len && write(data[n])) n++;
+    return n;
+  }
+  size_t write(const char* s) { return write((const uint8_t*)s, strlen(s)); }
+
+  size_t print(const char* s) { return write(s); }
+  size_t print(const String& s) { return write(s.c_str()); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(int v) { return printf("%d", v); }
+  size_t print(unsigned v) { return printf("%u", v); }
+  size_t print(long v) { return printf("%ld", v); }
+  size_t print(unsigned long v) { return printf("%lu", v); }
+  size_t print(double v, int decimals = 2) { return printf("%.*f", decimals, v); }
+  template <typename T>
+  size_t println(const T& v) { return print(v) + println(); }
+  size_t println() { return write((const uint8_t*)"\r\n", 2); }
+  size_t printf(const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+};
+
+class Stream : public Print {
+public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() { return -1; }
+  virtual size_t readBytes(uint8_t* buffer, size_t len) {
+    size_t n = 0;
+    int c;
+    while (n < len && (c = read()) >= 0) buffer[n++] = (uint8_t)c;
+    return n;
+  }
+  size_t readBytes(char* buffer, size_t len) { return readBytes((uint8_t*)buffer, len); }
+  virtual void flush() {}
+};
+
+// Output goes to stdout; input is whatever a test queued with simFeed().
+// simAttach() connects it to a file descriptor instead, such as the master
+// side of a pseudo-terminal, for end-to-end tests with a real host client.
+class HardwareSerial : public Stream {
+public:
+  void begin(unsigned long baud) { (void)baud; }
+  void end() {}
+  operator bool() const { return true; }
+  int available() override {
+    fill();
+    return (int)(rx.size() - rxPos);
+  }
+  int read() override {
+    fill();
+    return rxPos < rx.size() ? (uint8_t)rx[rxPos++] : -1;
+  }
+  int peek() override {
+    fill();
+    return rxPos < rx.size() ? (uint8_t)rx[rxPos] : -1;
+  }
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t* data, size_t len) override;
+  void flush() override;
+  void simFeed(const uint8_t* data, size_t len) { rx.append((const char*)data, len); }
+  // Reads and writes go to `fd` (made non-blocking); -1 goes back to stdout
+  void simAttach(int fd);
+
+private:
+  std::string rx;
+  size_t rxPos = 0;
+  int fd = -1;
+
+  void fill(); // Takes whatever the descriptor has ready
+};
+
+extern HardwareSerial Serial;
+
+// --- Networking types ---
+class IPAddress {
+public:
+  IPAddress() : addr(0) {}
+  IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : addr((uint32_t)a << 24 | b << 16 | c << 8 | d) {}
+  uint8_t operator[](int i) const { return (uint8_t)(addr >> (24 - 8 * i)); }
+  bool operator==(const IPAddress& o) const { return addr == o.addr; }
+  uint32_t toHost() const { return addr; }
+  String toString() const {
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%u.%u.%u.%u", (*this)[0], (*this)[1], (*this)[2], (*this)[3]);
+    return String(buf);
+  }
+
+private:
+  uint32_t addr; // Host byte order
+};
+
+// --- ESP ---
+// Free heap is a nominal ESP32 heap less what operator new has outstanding
+class EspClass {
+public:
+  static const uint32_t HEAP_SIZE = 300 * 1024;
+  uint32_t getHeapSize() { return HEAP_SIZE; }
+  uint32_t getFreeHeap();
+  uint32_t getMinFreeHeap();
+  uint32_t getMaxAllocHeap() { return getFreeHeap(); }
+  void restart() { exit(0); }
+};
+
+extern EspClass ESP;
+
+// --- FreeRTOS ---
+typedef int BaseType_t;
+typedef unsigned UBaseType_t;
+typedef uint32_t TickType_t;
+typedef void* TaskHandle_t;
+typedef void* SemaphoreHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+#define configMAX_PRIORITIES 25
+#define configTICK_RATE_HZ 1000
+#define portTICK_PERIOD_MS 1
+#define portMAX_DELAY 0xffffffffUL
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS 1
+#define pdFAIL 0
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char* name, uint32_t stackSize, void* arg,
+                                   UBaseType_t priority, TaskHandle_t* handle, BaseType_t core);
+void vTaskDelete(TaskHandle_t task);
+void vTaskDelay(TickType_t ticks);
+void vTaskDelayUntil(TickType_t* lastWake, TickType_t period);
+TickType_t xTaskGetTickCount();
+
+SemaphoreHandle_t xSemaphoreCreateMutex();
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem);
+void vSemaphoreDelete(SemaphoreHandle_t sem);
+
+#endif // ARDUINO_H
@@ -0,0 +1,47 @@
+#ifndef ARM_SIM_H
+#define ARM_SIM_H
+
+// What the tests in test/ share: the firmware globals they drive and the
+// helpers that run the simulated arm. Only the tests include this; the
+// stand-ins don't depend on it.
+
+#include <unity.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include "NativeSim.h"
+#include "ESPAsyncWebServer.h"
+#include "ArmController.h"
+#include "MotionTask.h"
+
+// From src/main.cpp
+void setup();
+void networkPoll();
+extern MotionTask motion;
+extern ArmController arm;
+extern AsyncWebServer server;
+
+// A line of output for pio test -v
+inline void report(const char* fmt, ...) {
+  char line[200];
+  va_list args;
+  va_start(args, fmt);
+  vsnprintf(line, sizeof(line), fmt, args);
+  va_end(args);
+  TEST_MESSAGE(line);
+}
+
+// Runs the firmware for ms of simulated time, 1 ms at a time: a motion tick
+// whenever one is due, then the network loop, as the two tasks would
+inline void runMs(uint32_t ms) {
+  for (uint32_t i = 0; i < ms; i++) {
+    simAdvanceMicros(1000);
+    if (simMicros() % MotionEngine::TICK_INTERVAL_US == 0) motion.step(micros());
+    networkPoll();
+  }
+}
+
+inline SimResponse get(const char* url) {
+  return server.simRequest(HTTP_GET, url);
+}
+
+#endif // ARM_SIM_H
@@ -0,0 +1,90 @@
+#include "AsyncUDP.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+static in_addr toInAddr(const IPAddress& ip) {
+  in_addr addr;
+  addr.s_addr = htonl(ip.toHost());
+  return addr;
+}
+
+bool AsyncUDP::listenMulticast(const IPAddress& group, uint16_t port, uint8_t ttl) {
+  close();
+  fd = socket(AF_INET, SOCK_DGRAM, 0);
+  if (fd < 0) return false;
+
+  int on = 1;
+  setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+#ifdef SO_REUSEPORT
+  setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &on, sizeof(on));
+#endif
+  sockaddr_in local = {};
+  local.sin_family = AF_INET;
+  local.sin_addr.s_addr = htonl(INADDR_ANY);
+  local.sin_port = htons(port);
+
+  ip_mreq membership = {};
+  membership.imr_multiaddr = toInAddr(group);
+  membership.imr_interface.s_addr = htonl(INADDR_LOOPBACK);
+  in_addr loopback;
+  loopback.s_addr = htonl(INADDR_LOOPBACK);
+  unsigned char hops = ttl;
+  unsigned char loop = 1;
+
+  if (bind(fd, (sockaddr*)&local, sizeof(local)) < 0 ||
+      setsockopt(fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &membership, sizeof(membership)) < 0 ||
+      setsockopt(fd, IPPROTO_IP, IP_MULTICAST_IF, &loopback, sizeof(loopback)) < 0 ||
+      setsockopt(fd, IPPROTO_IP, IP_MULTICAST_TTL, &hops, sizeof(hops)) < 0 ||
+      setsockopt(fd, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop)) < 0) {
+    ::close(fd);
+    fd = -1;
+    return false;
+  }
+
+  stopping = false;
+  receiver = std::thread(&AsyncUDP::receive, this);
+  return true;
+}
+
+void AsyncUDP::onPacket(AuPacketHandlerFunction fn) {
+  std::lock_guard<std::mutex> guard(handlerLock);
+  handler = fn;
+}
+
+size_t AsyncUDP::writeTo(const uint8_t* data, size_t len, const IPAddress& addr, uint16_t port) {
+  if (fd < 0) return 0;
+  sockaddr_in to = {};
+  to.sin_family = AF_INET;
+  to.sin_addr = toInAddr(addr);
+  to.sin_port = htons(port);
+  ssize_t sent = sendto(fd, data, len, 0, (sockaddr*)&to, sizeof(to));
+  return sent < 0 ? 0 : (size_t)sent;
+}
+
+void AsyncUDP::close() {
+  if (fd < 0) return;
+  stopping = true;
+  if (receiver.joinable()) receiver.join();
+  ::close(fd);
+  fd = -1;
+}
+
+// Polls with a timeout so close() can stop the thread
+void AsyncUDP::receive() {
+  uint8_t buf[1500];
+  while (!stopping) {
+    pollfd p = {fd, POLLIN, 0};
+    if (poll(&p, 1, 20) <= 0) continue;
+    sockaddr_in from = {};
+    socklen_t fromLen = sizeof(from);
+    ssize_t n = recvfrom(fd, buf, sizeof(buf), 0, (sockaddr*)&from, &fromLen);
+    if (n < 0) continue;
+    uint32_t ip = ntohl(from.sin_addr.s_addr);
+    AsyncUDPPacket packet(buf, (size_t)n, IPAddress(ip >> 24, ip >> 16, ip >> 8, ip));
+    std::lock_guard<std::mutex> guard(handlerLock);
+    if (handler) handler(packet);
+  }
+}
@@ -0,0 +1,51 @@
+#ifndef ASYNC_UDP_H
+#define ASYNC_UDP_H
+
+// Host stand-in for AsyncUDP on a real socket. Multicast is joined and sent
+// on the loopback interface, so several instances (in one process or many)
+// on the same host hear each other. Packets are handed to the onPacket
+// callback from a receive thread, as the AsyncUDP task does on the device.
+
+#include <Arduino.h>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+class AsyncUDPPacket {
+public:
+  AsyncUDPPacket(uint8_t* data, size_t len, const IPAddress& from) : buf(data), len(len), from(from) {}
+  uint8_t* data() { return buf; }
+  size_t length() { return len; }
+  IPAddress remoteIP() { return from; }
+
+private:
+  uint8_t* buf;
+  size_t len;
+  IPAddress from;
+};
+
+typedef std::function<void(AsyncUDPPacket& packet)> AuPacketHandlerFunction;
+
+class AsyncUDP {
+public:
+  AsyncUDP() {}
+  ~AsyncUDP() { close(); }
+
+  bool listenMulticast(const IPAddress& group, uint16_t port, uint8_t ttl = 1);
+  void onPacket(AuPacketHandlerFunction handler);
+  size_t writeTo(const uint8_t* data, size_t len, const IPAddress& addr, uint16_t port);
+  void close();
+  bool connected() const { return fd >= 0; }
+
+private:
+  int fd = -1;
+  std::thread receiver;
+  std::atomic<bool> stopping{false};
+  std::mutex handlerLock;
+  AuPacketHandlerFunction handler;
+
+  void receive();
+};
+
+#endif // ASYNC_UDP_H
@@ -0,0 +1,277 @@
+#include "ESPAsyncWebServer.h"
+#include "NativeSim.h"
+#include <strings.h>
+
+static const String emptyString;
+
+static int hexValue(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+static std::string urlDecode(const char* s, size_t len) {
+  std::string out;
+  for (size_t i = 0; i < len; i++) {
+    if (s[i] == '+') {
+      out += ' ';
+    } else if (s[i] == '%' && i + 2 < len && hexValue(s[i + 1]) >= 0 && hexValue(s[i + 2]) >= 0) {
+      out += (char)(hexValue(s[i + 1]) << 4 | hexValue(s[i + 2]));
+      i += 2;
+    } else {
+      out += s[i];
+    }
+  }
+  return out;
+}
+
+// --- AsyncWebServerRequest ---
+AsyncWebServerRequest::AsyncWebServerRequest(WebRequestMethod method, const char* url, size_t contentLength)
+    : requestMethod(method), bodyLength(contentLength) {
+  const char* query = strchr(url, '?');
+  path = String(urlDecode(url, query ? (size_t)(query - url) : strlen(url)));
+  while (query && *query) {
+    const char* start = query + 1;
+    const char* end = strchr(start, '&');
+    if (!end) end = start + strlen(start);
+    const char* eq = (const char*)memchr(start, '=', end - start);
+    if (end > start) {
+      std::string name = urlDecode(start, (eq ? eq : end) - start);
+      std::string value = eq ? urlDecode(eq + 1, end - eq - 1) : std::string();
+      args.emplace_back(String(name), String(value));
+    }
+    query = *end ? end : nullptr;
+  }
+}
+
+AsyncWebServerRequest::~AsyncWebServerRequest() {
+  delete response;
+  free(_tempObject);
+}
+
+bool AsyncWebServerRequest::hasArg(const char* name) const {
+  for (const auto& a : args) {
+    if (strcmp(a.first.c_str(), name) == 0) return true;
+  }
+  return false;
+}
+
+const String& AsyncWebServerRequest::arg(const char* name) const {
+  for (const auto& a : args) {
+    if (strcmp(a.first.c_str(), name) == 0) return a.second;
+  }
+  return emptyString;
+}
+
+bool AsyncWebServerRequest::hasHeader(const char* name) const {
+  for (const auto& h : headers) {
+    if (strcasecmp(h.first.c_str(), name) == 0) return true;
+  }
+  return false;
+}
+
+const String& AsyncWebServerRequest::header(const char* name) const {
+  for (const auto& h : headers) {
+    if (strcasecmp(h.first.c_str(), name) == 0) return h.second;
+  }
+  return emptyString;
+}
+
+void AsyncWebServerRequest::simAddHeader(const char* name, const char* value) {
+  headers.emplace_back(String(name), String(value));
+}
+
+void AsyncWebServerRequest::send(int code, const String& contentType, const String& content) {
+  send(beginResponse(code, contentType, content));
+}
+
+// Only the first response counts, as on the device
+void AsyncWebServerRequest::send(AsyncWebServerResponse* r) {
+  if (response) {
+    delete r;
+    return;
+  }
+  response = r;
+}
+
+AsyncWebServerResponse* AsyncWebServerRequest::beginResponse(int code, const String& contentType,
+                                                             const String& content) {
+  AsyncWebServerResponse* r = new AsyncWebServerResponse(code, contentType);
+  r->content = content.c_str();
+  return r;
+}
+
+AsyncWebServerResponse* AsyncWebServerRequest::beginResponse_P(int code, const String& contentType,
+                                                               const uint8_t* content, size_t len) {
+  AsyncWebServerResponse* r = new AsyncWebServerResponse(code, contentType);
+  r->flashData = content;
+  r->flashLen = len;
+  return r;
+}
+
+AsyncResponseStream* AsyncWebServerRequest::beginResponseStream(const String& contentType, size_t bufferSize) {
+  return new AsyncResponseStream(contentType, bufferSize);
+}
+
+// --- AsyncWebSocket ---
+AsyncWebSocketClient* AsyncWebSocket::simConnect() {
+  clients.emplace_back(new AsyncWebSocketClient(this, nextId++));
+  AsyncWebSocketClient* client = clients.back().get();
+  if (eventHandler) eventHandler(this, client, WS_EVT_CONNECT, nullptr, nullptr, 0);
+  return finishEvent(client) ? client : nullptr;
+}
+
+bool AsyncWebSocket::simFrame(AsyncWebSocketClient* client, AwsFrameType type, const uint8_t* data, size_t len) {
+  AwsFrameInfo info = {};
+  info.message_opcode = info.opcode = type;
+  info.final = 1;
+  info.len = len;
+  info.index = 0;
+  // Handlers get a writable copy, like the library's receive buffer
+  std::vector<uint8_t> copy(data, data + len);
+  if (eventHandler) eventHandler(this, client, WS_EVT_DATA, &info, copy.data(), len);
+  return finishEvent(client);
+}
+
+void AsyncWebSocket::simDisconnect(AsyncWebSocketClient* client) {
+  client->close();
+  finishEvent(client);
+}
+
+// Delivers the disconnect of a client closed by either side
+bool AsyncWebSocket::finishEvent(AsyncWebSocketClient* client) {
+  if (!client->simClosing()) return true;
+  if (eventHandler) eventHandler(this, client, WS_EVT_DISCONNECT, nullptr, nullptr, 0);
+  for (size_t i = 0; i < clients.size(); i++) {
+    if (clients[i].get() == client) {
+      clients.erase(clients.begin() + i);
+      break;
+    }
+  }
+  return false;
+}
+
+// --- AsyncEventSource ---
+static std::string eventMessage(const char* message, const char* event, uint32_t id, uint32_t reconnect) {
+  std::string ev;
+  char line[24];
+  if (reconnect) {
+    snprintf(line, sizeof(line), "retry: %u\r\n", (unsigned)reconnect);
+    ev += line;
+  }
+  if (id) {
+    snprintf(line, sizeof(line), "id: %u\r\n", (unsigned)id);
+    ev += line;
+  }
+  if (event) {
+    ev += "event: ";
+    ev += event;
+    ev += "\r\n";
+  }
+  if (message) {
+    ev += "data: ";
+    ev += message;
+    ev += "\r\n";
+  }
+  ev += "\r\n";
+  return ev;
+}
+
+void AsyncEventSourceClient::send(const char* message, const char* event, uint32_t id, uint32_t reconnect) {
+  std::string ev = eventMessage(message, event, id, reconnect);
+  write(ev.data(), ev.size());
+  if (id) lastEventId = id;
+}
+
+void AsyncEventSourceClient::write(const char* message, size_t len) {
+  messages++;
+  bytes += len;
+  last.assign(message, len);
+}
+
+void AsyncEventSource::send(const char* message, const char* event, uint32_t id, uint32_t reconnect) {
+  std::string ev = eventMessage(message, event, id, reconnect);
+  formatted++;
+  for (auto& client : clients) {
+    client->write(ev.data(), ev.size());
+    if (id) client->lastEventId = id;
+  }
+}
+
+AsyncEventSourceClient* AsyncEventSource::simConnect(uint32_t lastId) {
+  clients.emplace_back(new AsyncEventSourceClient(lastId));
+  AsyncEventSourceClient* client = clients.back().get();
+  if (connectHandler) connectHandler(client);
+  return client;
+}
+
+void AsyncEventSource::simDisconnect(AsyncEventSourceClient* client) {
+  for (size_t i = 0; i < clients.size(); i++) {
+    if (clients[i].get() == client) {
+      clients.erase(clients.begin() + i);
+      return;
+    }
+  }
+}
+
+// --- AsyncWebServer ---
+std::string SimResponse::header(const char* name) const {
+  for (const auto& h : headers) {
+    if (strcasecmp(h.first.c_str(), name) == 0) return h.second;
+  }
+  return "";
+}
+
+AsyncCallbackWebHandler& AsyncWebServer::on(const char* uri, WebRequestMethodComposite method,
+                                            ArRequestHandlerFunction onRequest, ArUploadHandlerFunction,
+                                            ArBodyHandlerFunction onBody) {
+  routes.emplace_back(new AsyncCallbackWebHandler);
+  AsyncCallbackWebHandler& route = *routes.back();
+  route.uri = uri;
+  route.method = method;
+  route.onRequest = onRequest;
+  route.onBody = onBody;
+  return route;
+}
+
+SimResponse AsyncWebServer::simRequest(WebRequestMethod method, const char* url, const char* body,
+                                       const char* const* headers, size_t chunkSize) {
+  size_t bodyLen = body ? strlen(body) : 0;
+  AsyncWebServerRequest request(method, url, bodyLen);
+  for (const char* const* h = headers; h && h[0]; h += 2) request.simAddHeader(h[0], h[1]);
+
+  const AsyncCallbackWebHandler* route = nullptr;
+  for (const auto& r : routes) {
+    if ((r->method & method) && r->uri == request.url().c_str()) {
+      route = r.get();
+      break;
+    }
+  }
+
+  uint32_t allocationsBefore = simHeapStats().allocations;
+  if (route) {
+    if (route->onBody && chunkSize > 0) {
+      for (size_t index = 0; index < bodyLen; index += chunkSize) {
+        size_t len = bodyLen - index < chunkSize ? bodyLen - index : chunkSize;
+        route->onBody(&request, (uint8_t*)body + index, len, index, bodyLen);
+      }
+    }
+    route->onRequest(&request);
+  } else if (notFound) {
+    notFound(&request);
+  }
+  uint32_t allocations = simHeapStats().allocations - allocationsBefore;
+
+  SimResponse result;
+  result.allocations = allocations;
+  AsyncWebServerResponse* r = request.simResponse();
+  if (r) {
+    result.code = r->code;
+    result.contentType = r->contentType;
+    result.headers = r->headers;
+    result.fromFlash = r->flashData != nullptr;
+    result.body = r->flashData ? std::string((const char*)r->flashData, r->flashLen) : r->content;
+  }
+  return result;
+}
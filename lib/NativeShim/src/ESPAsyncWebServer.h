@@ -0,0 +1,262 @@
+#ifndef ESP_ASYNC_WEB_SERVER_H
+#define ESP_ASYNC_WEB_SERVER_H
+
+// Host stand-in for ESPAsyncWebServer: the same handler-facing API, without
+// sockets. AsyncWebServer::simRequest() parses a URL, runs the matching
+// route the way the AsyncTCP task would (body callback first, then the
+// handler) and returns what was sent. WebSocket and event-source clients
+// are made with simConnect() and record what they receive.
+
+#include <Arduino.h>
+#include <functional>
+#include <memory>
+#include <vector>
+
+typedef enum {
+  HTTP_GET = 0b00000001,
+  HTTP_POST = 0b00000010,
+  HTTP_DELETE = 0b00000100,
+  HTTP_PUT = 0b00001000,
+  HTTP_PATCH = 0b00010000,
+  HTTP_HEAD = 0b00100000,
+  HTTP_OPTIONS = 0b01000000,
+  HTTP_ANY = 0b01111111,
+} WebRequestMethod;
+typedef uint8_t WebRequestMethodComposite;
+
+// --- Responses ---
+class AsyncWebServerResponse {
+public:
+  AsyncWebServerResponse(int code, const String& contentType) : code(code), contentType(contentType.c_str()) {}
+  virtual ~AsyncWebServerResponse() {}
+  void addHeader(const String& name, const String& value) {
+    headers.emplace_back(name.c_str(), value.c_str());
+  }
+
+  // Read back by simRequest()
+  int code;
+  std::string contentType;
+  std::vector<std::pair<std::string, std::string>> headers;
+  std::string content;                 // Copied into the response
+  const uint8_t* flashData = nullptr;  // Or sent from flash as-is (beginResponse_P)
+  size_t flashLen = 0;
+};
+
+// Buffers everything written and sends it once the handler returns
+class AsyncResponseStream : public AsyncWebServerResponse, public Print {
+public:
+  AsyncResponseStream(const String& contentType, size_t bufferSize)
+      : AsyncWebServerResponse(200, contentType) {
+    content.reserve(bufferSize);
+  }
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t* data, size_t len) override {
+    content.append((const char*)data, len);
+    return len;
+  }
+};
+
+// --- Requests ---
+class AsyncWebServerRequest {
+public:
+  AsyncWebServerRequest(WebRequestMethod method, const char* url, size_t contentLength);
+  ~AsyncWebServerRequest();
+
+  void* _tempObject = nullptr; // Freed with free() along with the request
+
+  WebRequestMethod method() const { return requestMethod; }
+  const String& url() const { return path; }
+  size_t contentLength() const { return bodyLength; }
+
+  bool hasArg(const char* name) const;
+  const String& arg(const char* name) const;
+  bool hasHeader(const char* name) const;
+  const String& header(const char* name) const;
+  void simAddHeader(const char* name, const char* value);
+
+  void send(int code, const String& contentType = String(), const String& content = String());
+  void send(AsyncWebServerResponse* response);
+  AsyncWebServerResponse* beginResponse(int code, const String& contentType = String(),
+                                        const String& content = String());
+  AsyncWebServerResponse* beginResponse_P(int code, const String& contentType, const uint8_t* content,
+                                          size_t len);
+  AsyncResponseStream* beginResponseStream(const String& contentType, size_t bufferSize = 1460);
+
+  // The response sent, or nullptr; owned by the request
+  AsyncWebServerResponse* simResponse() const { return response; }
+
+private:
+  WebRequestMethod requestMethod;
+  String path;
+  size_t bodyLength;
+  std::vector<std::pair<String, String>> args;
+  std::vector<std::pair<String, String>> headers;
+  AsyncWebServerResponse* response = nullptr;
+};
+
+typedef std::function<void(AsyncWebServerRequest*)> ArRequestHandlerFunction;
+typedef std::function<void(AsyncWebServerRequest*, const String&, size_t, uint8_t*, size_t, bool)>
+    ArUploadHandlerFunction;
+typedef std::function<void(AsyncWebServerRequest*, uint8_t*, size_t, size_t, size_t)> ArBodyHandlerFunction;
+
+class AsyncWebHandler {
+public:
+  virtual ~AsyncWebHandler() {}
+};
+
+class AsyncCallbackWebHandler : public AsyncWebHandler {
+public:
+  std::string uri;
+  WebRequestMethodComposite method;
+  ArRequestHandlerFunction onRequest;
+  ArBodyHandlerFunction onBody;
+};
+
+// --- WebSocket ---
+typedef enum { WS_EVT_CONNECT, WS_EVT_DISCONNECT, WS_EVT_PING, WS_EVT_PONG, WS_EVT_ERROR, WS_EVT_DATA } AwsEventType;
+typedef enum { WS_CONTINUATION, WS_TEXT, WS_BINARY, WS_DISCONNECT = 0x08, WS_PING, WS_PONG } AwsFrameType;
+
+struct AwsFrameInfo {
+  uint8_t message_opcode;
+  uint32_t num;
+  uint8_t final;
+  uint8_t masked;
+  uint8_t opcode;
+  uint64_t len;
+  uint8_t mask[4];
+  uint64_t index;
+};
+
+class AsyncWebSocket;
+
+class AsyncWebSocketClient {
+public:
+  AsyncWebSocketClient(AsyncWebSocket* server, uint32_t id) : server(server), clientId(id) {}
+  uint32_t id() const { return clientId; }
+  AsyncWebSocket* simServer() const { return server; }
+  // The disconnect event follows once the current event has been handled
+  void close(uint16_t code = 0, const char* message = nullptr) {
+    (void)code;
+    (void)message;
+    closing = true;
+  }
+  bool simClosing() const { return closing; }
+
+private:
+  AsyncWebSocket* server;
+  uint32_t clientId;
+  bool closing = false;
+};
+
+class AsyncWebSocket : public AsyncWebHandler {
+public:
+  typedef std::function<void(AsyncWebSocket*, AsyncWebSocketClient*, AwsEventType, void*, uint8_t*, size_t)>
+      AwsEventHandler;
+
+  explicit AsyncWebSocket(const String& url) : path(url) {}
+  void onEvent(AwsEventHandler handler) { eventHandler = handler; }
+  size_t count() const { return clients.size(); }
+  void cleanupClients(uint16_t maxClients = 8) { (void)maxClients; }
+
+  // nullptr if the handler closed the connection straight away
+  AsyncWebSocketClient* simConnect();
+  // One whole frame; false if the client is gone afterwards
+  bool simFrame(AsyncWebSocketClient* client, AwsFrameType type, const uint8_t* data, size_t len);
+  void simDisconnect(AsyncWebSocketClient* client);
+
+private:
+  String path;
+  AwsEventHandler eventHandler;
+  std::vector<std::unique_ptr<AsyncWebSocketClient>> clients;
+  uint32_t nextId = 1;
+
+  bool finishEvent(AsyncWebSocketClient* client);
+};
+
+// --- Server-Sent Events ---
+class AsyncEventSource;
+
+class AsyncEventSourceClient {
+public:
+  explicit AsyncEventSourceClient(uint32_t lastId) : lastEventId(lastId) {}
+  // Formats one message: retry, id, event and data lines, then a blank line
+  void send(const char* message, const char* event = nullptr, uint32_t id = 0, uint32_t reconnect = 0);
+  void write(const char* message, size_t len);
+  uint32_t lastId() const { return lastEventId; }
+  bool connected() const { return true; }
+
+  // What the client has received
+  uint32_t simMessages() const { return messages; }
+  size_t simBytes() const { return bytes; }
+  const std::string& simLastMessage() const { return last; }
+
+private:
+  friend class AsyncEventSource;
+  uint32_t lastEventId;
+  uint32_t messages = 0;
+  size_t bytes = 0;
+  std::string last;
+};
+
+class AsyncEventSource : public AsyncWebHandler {
+public:
+  typedef std::function<void(AsyncEventSourceClient*)> ArEventHandlerFunction;
+
+  explicit AsyncEventSource(const String& url) : path(url) {}
+  void onConnect(ArEventHandlerFunction handler) { connectHandler = handler; }
+  // Formats the message once and queues the same bytes on every client
+  void send(const char* message, const char* event = nullptr, uint32_t id = 0, uint32_t reconnect = 0);
+  size_t count() const { return clients.size(); }
+
+  AsyncEventSourceClient* simConnect(uint32_t lastId = 0);
+  void simDisconnect(AsyncEventSourceClient* client);
+  // Messages formatted by send() (once each, however many clients)
+  uint32_t simFormatted() const { return formatted; }
+
+private:
+  String path;
+  ArEventHandlerFunction connectHandler;
+  std::vector<std::unique_ptr<AsyncEventSourceClient>> clients;
+  uint32_t formatted = 0;
+};
+
+// --- Server ---
+// What a request got back, from AsyncWebServer::simRequest()
+struct SimResponse {
+  int code = 0;             // 0 if the handler sent nothing
+  std::string contentType;
+  std::vector<std::pair<std::string, std::string>> headers;
+  std::string body;
+  bool fromFlash = false;   // Sent from a beginResponse_P() buffer without a copy
+  uint32_t allocations = 0; // operator new calls between the request arriving and its response being sent
+
+  // "" if not sent
+  std::string header(const char* name) const;
+};
+
+class AsyncWebServer {
+public:
+  explicit AsyncWebServer(uint16_t port) : port(port) {}
+  void begin() { started = true; }
+  void end() { started = false; }
+
+  AsyncCallbackWebHandler& on(const char* uri, WebRequestMethodComposite method, ArRequestHandlerFunction onRequest,
+                              ArUploadHandlerFunction onUpload = nullptr, ArBodyHandlerFunction onBody = nullptr);
+  AsyncWebHandler& addHandler(AsyncWebHandler* handler) { return *handler; }
+  void onNotFound(ArRequestHandlerFunction handler) { notFound = handler; }
+
+  // Runs `url` (path plus optional ?query, percent-encoded) through the
+  // routes. A body is handed to the route's body callback in pieces of at
+  // most chunkSize bytes, as it would arrive from the network. headers are
+  // "Name", "value" pairs ending with nullptr.
+  SimResponse simRequest(WebRequestMethod method, const char* url, const char* body = nullptr,
+                         const char* const* headers = nullptr, size_t chunkSize = 1436);
+
+private:
+  uint16_t port;
+  bool started = false;
+  std::vector<std::unique_ptr<AsyncCallbackWebHandler>> routes;
+  ArRequestHandlerFunction notFound;
+};
+
+#endif // ESP_ASYNC_WEB_SERVER_H
@@ -0,0 +1,176 @@
+#include <LittleFS.h>
+
+fs::LittleFSFS LittleFS;
+
+namespace fs {
+
+// --- File ---
+const char* File::name() const {
+  const char* slash = strrchr(fullPath.c_str(), '/');
+  return slash ? slash + 1 : fullPath.c_str();
+}
+
+bool File::seek(uint32_t offset) {
+  if (!node || node->directory || offset > node->data.size()) return false;
+  pos = offset;
+  return true;
+}
+
+void File::close() {
+  node.reset();
+  entries.clear();
+  pos = 0;
+}
+
+size_t File::write(const uint8_t* data, size_t len) {
+  if (!node || node->directory || !writable) return 0;
+  if (volume->capacity) {
+    size_t used = volume->usedBytes();
+    size_t grows = pos + len > node->data.size() ? pos + len - node->data.size() : 0;
+    if (used + grows > volume->capacity) {
+      size_t room = volume->capacity > used ? volume->capacity - used : 0;
+      len = len - (grows - room);
+    }
+  }
+  if (pos + len > node->data.size()) node->data.resize(pos + len);
+  memcpy(&node->data[pos], data, len);
+  pos += len;
+  return len;
+}
+
+int File::read() {
+  uint8_t c;
+  return read(&c, 1) == 1 ? c : -1;
+}
+
+int File::peek() {
+  return node && !node->directory && pos < node->data.size() ? (uint8_t)node->data[pos] : -1;
+}
+
+size_t File::read(uint8_t* buffer, size_t len) {
+  if (!node || node->directory || pos >= node->data.size()) return 0;
+  size_t n = node->data.size() - pos < len ? node->data.size() - pos : len;
+  memcpy(buffer, node->data.data() + pos, n);
+  pos += n;
+  return n;
+}
+
+File File::openNextFile(const char* mode) {
+  while (node && node->directory && nextEntry < entries.size()) {
+    File next = volume->open(entries[nextEntry++].c_str(), mode);
+    if (next) return next;
+  }
+  return File();
+}
+
+// --- SimVolume ---
+std::string SimVolume::normal(const char* path) {
+  std::string p = path && path[0] == '/' ? path : std::string("/") + (path ? path : "");
+  while (p.size() > 1 && p.back() == '/') p.pop_back();
+  return p;
+}
+
+std::string SimVolume::parentOf(const std::string& path) {
+  size_t slash = path.rfind('/');
+  return slash == 0 ? "/" : path.substr(0, slash);
+}
+
+bool SimVolume::parentExists(const std::string& path) const {
+  std::string parent = parentOf(path);
+  if (parent == "/") return true;
+  auto it = nodes.find(parent);
+  return it != nodes.end() && it->second->directory;
+}
+
+File SimVolume::open(const char* path, const char* mode, bool create) {
+  std::string p = normal(path);
+  File file;
+  file.volume = this;
+  file.fullPath = p;
+
+  if (p == "/") {
+    file.node = std::make_shared<SimNode>(SimNode{true, ""});
+  } else {
+    auto it = nodes.find(p);
+    bool writing = mode[0] == 'w' || mode[0] == 'a';
+    if (it == nodes.end()) {
+      if (!writing || !(parentExists(p) || create)) return File();
+      if (create) {
+        // Make the missing directories on the way, like open(path, "w", true)
+        for (size_t slash = p.find('/', 1); slash != std::string::npos; slash = p.find('/', slash + 1)) {
+          mkdir(p.substr(0, slash).c_str());
+        }
+      }
+      it = nodes.emplace(p, std::make_shared<SimNode>(SimNode{false, ""})).first;
+    } else if (writing && it->second->directory) {
+      return File();
+    }
+    file.node = it->second;
+    file.writable = writing || strchr(mode, '+');
+    if (mode[0] == 'w') file.node->data.clear();
+    if (mode[0] == 'a') file.pos = file.node->data.size();
+  }
+
+  if (file.node->directory) {
+    std::string prefix = p == "/" ? "/" : p + "/";
+    for (const auto& entry : nodes) {
+      const std::string& name = entry.first;
+      if (name.compare(0, prefix.size(), prefix) == 0 && name.find('/', prefix.size()) == std::string::npos) {
+        file.entries.push_back(name);
+      }
+    }
+  }
+  return file;
+}
+
+bool SimVolume::remove(const char* path) {
+  auto it = nodes.find(normal(path));
+  if (it == nodes.end() || it->second->directory) return false;
+  nodes.erase(it);
+  return true;
+}
+
+bool SimVolume::rename(const char* from, const char* to) {
+  std::string src = normal(from), dst = normal(to);
+  auto it = nodes.find(src);
+  if (it == nodes.end() || !parentExists(dst)) return false;
+  auto target = nodes.find(dst);
+  if (target != nodes.end() && target->second->directory) return false;
+  std::shared_ptr<SimNode> node = it->second;
+  nodes.erase(it);
+  nodes[dst] = node;
+  return true;
+}
+
+bool SimVolume::mkdir(const char* path) {
+  std::string p = normal(path);
+  if (p == "/") return true;
+  auto it = nodes.find(p);
+  if (it != nodes.end()) return it->second->directory;
+  if (!parentExists(p)) return false;
+  nodes.emplace(p, std::make_shared<SimNode>(SimNode{true, ""}));
+  return true;
+}
+
+bool SimVolume::rmdir(const char* path) {
+  std::string p = normal(path);
+  auto it = nodes.find(p);
+  if (it == nodes.end() || !it->second->directory) return false;
+  std::string prefix = p + "/";
+  auto child = nodes.lower_bound(prefix);
+  if (child != nodes.end() && child->first.compare(0, prefix.size(), prefix) == 0) return false;
+  nodes.erase(it);
+  return true;
+}
+
+size_t SimVolume::usedBytes() const {
+  size_t used = 0;
+  for (const auto& entry : nodes) used += entry.second->data.size();
+  return used;
+}
+
+void SimVolume::simFormat() {
+  nodes.clear();
+}
+
+} // namespace fs
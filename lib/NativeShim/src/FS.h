@@ -0,0 +1,98 @@
+#ifndef FS_H
+#define FS_H
+
+// Host stand-in for the Arduino fs::FS/fs::File API over an in-memory tree.
+// Like LittleFS, rename() replaces an existing target in one step, and a
+// file can't be created in a directory that doesn't exist.
+
+#include <Arduino.h>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace fs {
+
+struct SimNode {
+  bool directory;
+  std::string data;
+};
+
+class SimVolume;
+
+class File : public Stream {
+public:
+  File() {}
+
+  operator bool() const { return node != nullptr; }
+  const char* name() const;
+  const char* path() const { return fullPath.c_str(); }
+  bool isDirectory() const { return node && node->directory; }
+  size_t size() const { return node && !node->directory ? node->data.size() : 0; }
+  size_t position() const { return pos; }
+  bool seek(uint32_t offset);
+  void close();
+
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t* data, size_t len) override;
+  int available() override { return (int)(size() - pos); }
+  int read() override;
+  int peek() override;
+  size_t read(uint8_t* buffer, size_t len);
+  size_t readBytes(uint8_t* buffer, size_t len) override { return read(buffer, len); }
+
+  // Directories only: the next entry, or a false File at the end
+  File openNextFile(const char* mode = "r");
+
+private:
+  friend class SimVolume;
+  SimVolume* volume = nullptr;
+  std::shared_ptr<SimNode> node;
+  std::string fullPath;
+  bool writable = false;
+  size_t pos = 0;
+  std::vector<std::string> entries; // Directory listing taken at open
+  size_t nextEntry = 0;
+};
+
+class SimVolume {
+public:
+  File open(const char* path, const char* mode = "r", bool create = false);
+  bool exists(const char* path) const { return nodes.count(normal(path)) != 0; }
+  bool remove(const char* path);
+  bool rename(const char* from, const char* to);
+  bool mkdir(const char* path);
+  bool rmdir(const char* path);
+
+  size_t totalBytes() const { return capacity; }
+  size_t usedBytes() const;
+  // Writes past this many bytes of file data come up short, like a full
+  // partition; 0 for no limit
+  void simSetCapacity(size_t bytes) { capacity = bytes; }
+  void simFormat();
+
+private:
+  friend class File;
+  std::map<std::string, std::shared_ptr<SimNode>> nodes;
+  size_t capacity = 0;
+
+  static std::string normal(const char* path);
+  static std::string parentOf(const std::string& path);
+  bool parentExists(const std::string& path) const;
+};
+
+class FS : public SimVolume {
+public:
+  File open(const String& path, const char* mode = "r", bool create = false) {
+    return SimVolume::open(path.c_str(), mode, create);
+  }
+  File open(const char* path, const char* mode = "r", bool create = false) {
+    return SimVolume::open(path, mode, create);
+  }
+};
+
+} // namespace fs
+
+using fs::File;
+using fs::FS;
+
+#endif // FS_H
@@ -0,0 +1,28 @@
+#ifndef LITTLEFS_H
+#define LITTLEFS_H
+
+#include <FS.h>
+
+namespace fs {
+
+// Always mounts; the RAM disk starts empty, as after a format
+class LittleFSFS : public FS {
+public:
+  bool begin(bool formatOnFail = false, const char* basePath = "/littlefs", uint8_t maxOpenFiles = 10) {
+    (void)formatOnFail;
+    (void)basePath;
+    (void)maxOpenFiles;
+    return true;
+  }
+  void end() {}
+  bool format() {
+    simFormat();
+    return true;
+  }
+};
+
+} // namespace fs
+
+extern fs::LittleFSFS LittleFS;
+
+#endif // LITTLEFS_H
@@ -0,0 +1,89 @@
+#ifndef NATIVE_SIM_H
+#define NATIVE_SIM_H
+
+// Test-side controls for the host build ([env:native] in platformio.ini).
+//
+// The firmware compiles unchanged against this library's stand-ins for
+// Arduino.h, FreeRTOS, driver/ledc.h, LittleFS, ESPAsyncWebServer and
+// AsyncUDP. What the hardware would do is simulated just far enough for
+// tests and benchmarks:
+//
+//  - Clock: micros()/millis() read a simulated clock that only moves when a
+//    test (or delay(), vTaskDelay(), vTaskDelayUntil()) moves it, so runs are
+//    repeatable. simUseHostClock(true) follows the host's clock instead,
+//    optionally offset so that instances in one test disagree on the time.
+//  - Tasks: xTaskCreatePinnedToCore() records the task instead of starting
+//    it. Tests call the loop bodies themselves (MotionTask::step(),
+//    networkPoll(), logFlush()) or start their own threads.
+//  - Servos: LEDC channels keep the duty last latched by ledc_update_duty().
+//  - Heap: operator new/delete are counted; ESP.getFreeHeap() follows them.
+//    So are String comparisons, the cost of dispatching on names.
+//  - Serial writes to stdout, or to a file descriptor such as a
+//    pseudo-terminal (Serial.simAttach()), which it also reads.
+//  - LittleFS is a RAM disk with an optional capacity limit, and
+//    AsyncWebServer::simRequest() runs a request through the routes without
+//    any sockets (see ESPAsyncWebServer.h). AsyncUDP uses real sockets, so
+//    multicast works over loopback.
+//
+// Tests include ArmSim.h, which adds the firmware globals and the helpers
+// that run them (runMs(), get(), report()).
+
+#include <Arduino.h>
+#include <driver/ledc.h>
+
+// --- Clock ---
+uint64_t simMicros();
+void simSetMicros(uint64_t us);
+void simAdvanceMicros(uint64_t us);
+// offsetUs is added to the host's clock, as if the board had booted that
+// much earlier
+void simUseHostClock(bool host, uint64_t offsetUs = 0);
+
+// --- Tasks ---
+struct SimTask {
+  TaskFunction_t fn;
+  const char* name;
+  void* arg;
+  uint32_t stackSize;
+  UBaseType_t priority;
+  BaseType_t core;
+};
+
+size_t simTaskCount();
+// nullptr if no task of that name was created
+const SimTask* simFindTask(const char* name);
+
+// --- Heap ---
+struct SimHeapStats {
+  uint32_t allocations; // operator new calls
+  uint32_t frees;
+  size_t liveBytes;
+  size_t peakBytes;
+};
+
+SimHeapStats simHeapStats();
+// Starts peakBytes over from what is allocated now
+void simResetHeapPeak();
+
+// --- Strings ---
+// String ==/!= calls made by the firmware (the stand-ins' own lookups use
+// strcmp and are not counted)
+uint32_t simStringCompares();
+void simResetStringCompares();
+
+// --- LEDC ---
+struct SimLedcChannel {
+  int gpio;         // -1 until configured
+  bool running;     // False after ledc_stop()
+  uint32_t duty;    // Latched by ledc_update_duty()
+  uint32_t pending; // Set by ledc_set_duty(), not yet latched
+};
+
+const SimLedcChannel& simLedcChannel(ledc_channel_t channel);
+uint32_t simLedcFrequency();
+uint8_t simLedcResolutionBits();
+uint32_t simLedcSetDutyCalls();
+uint32_t simLedcUpdateCalls();
+void simLedcResetCounts();
+
+#endif // NATIVE_SIM_H
@@ -0,0 +1,39 @@
+#ifndef WIFI_H
+#define WIFI_H
+
+// Host stand-in for the ESP32 WiFi class: the access point is up at once
+// and the station never connects
+
+#include <Arduino.h>
+
+typedef enum { WIFI_OFF = 0, WIFI_STA, WIFI_AP, WIFI_AP_STA } wifi_mode_t;
+typedef enum { WL_IDLE_STATUS = 0, WL_NO_SSID_AVAIL, WL_SCAN_COMPLETED, WL_CONNECTED, WL_CONNECT_FAILED,
+               WL_CONNECTION_LOST, WL_DISCONNECTED } wl_status_t;
+
+class WiFiClass {
+public:
+  bool mode(wifi_mode_t m) {
+    currentMode = m;
+    return true;
+  }
+  wl_status_t begin(const char* ssid, const char* password = nullptr) {
+    (void)ssid;
+    (void)password;
+    return WL_DISCONNECTED;
+  }
+  wl_status_t status() { return WL_DISCONNECTED; }
+  bool softAP(const char* ssid, const char* password = nullptr) {
+    (void)ssid;
+    (void)password;
+    return true;
+  }
+  IPAddress softAPIP() { return IPAddress(192, 168, 4, 1); }
+  IPAddress localIP() { return IPAddress(); }
+
+private:
+  wifi_mode_t currentMode = WIFI_AP;
+};
+
+extern WiFiClass WiFi;
+
+#endif // WIFI_H
@@ -0,0 +1,599 @@
+#include "ArmController.h"
+#include "Envelope.h"
+#include "Log.h"
+
+// Slider and home moves follow their target at 1 deg every 3 ms, as before
+static const float servoSpeed = 1000.0f / 3; // deg/s
+static const unsigned long playDwellMs = 100; // Pause after each played pose
+
+ArmController::ArmController(MotionTask& motion, SequenceStore& store)
+    : motion(motion), store(store), isRecording(false), jogMask(0), isPlaying(false), playIndex(0),
+      playDwelling(false), playDwellStart(0), playProgram(false), playPaused(false), playLoops(1),
+      playLoop(0), playSpeedScale(1), playDetour(false), corrections(0) {
+  // Base, shoulder, elbow, gripper
+  const float tolerance[JOINT_COUNT] = {2, 2, 2, 1};
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+    pos[i] = 90;
+    homePos[i] = 90;
+    jointEnabled[i] = false;
+    tempEnabled[i] = false;
+    playTargets[i] = 90;
+    playVia[i] = 90;
+    keyframeTolerance[i] = tolerance[i];
+  }
+}
+
+void ArmController::begin() {
+  int saved[JOINT_COUNT];
+  if (store.loadHome(saved)) {
+    for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+      homePos[i] = saved[i];
+    }
+    LOG_INFO("Home positions loaded from flash.");
+  }
+}
+
+// --- Manual Control ---
+ArmStatus ArmController::setJoint(JointId joint, int targetPos) {
+  if (isPlaying) return ARM_BUSY;
+
+  // Apply hardcoded safety limit for all servos
+  targetPos = constrain(targetPos, 0, 180);
+  if (joint == JOINT_SHOULDER || joint == JOINT_ELBOW) {
+    int limited = limitToEnvelope(joint, targetPos);
+    if (limited != targetPos) corrections++;
+    targetPos = limited;
+  }
+  if (jointEnabled[joint]) {
+    if (!motion.setTarget(joint, targetPos, servoSpeed)) return ARM_QUEUE_FULL;
+    pos[joint] = targetPos;
+    jogMask &= ~(1 << joint);
+  }
+
+  if (isRecording) {
+    recordPose();
+  }
+  return ARM_OK;
+}
+
+ArmStatus ArmController::track(const int targets[JOINT_COUNT], uint8_t mask, float periodSec) {
+  if (isPlaying) return ARM_BUSY;
+
+  int goal[JOINT_COUNT];
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+    goal[i] = (mask & (1 << i)) ? constrain(targets[i], 0, 180) : pos[i];
+  }
+  projectToEnvelope(goal);
+
+  // Speeds from where the servos actually are, so a joint that fell behind
+  // catches up; never faster than a slider move
+  MotionSnapshot snap;
+  motion.snapshot(snap);
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+    if (!jointEnabled[i] || goal[i] == pos[i]) continue;
+    float speed = constrain(abs(goal[i] - snap.position[i]) / periodSec, 0.0f, servoSpeed);
+    if (!motion.setTarget((JointId)i, goal[i], speed)) return ARM_QUEUE_FULL;
+    pos[i] = goal[i];
+    jogMask &= ~(1 << i);
+  }
+
+  if (isRecording) {
+    recordPose();
+  }
+  return ARM_OK;
+}
+
+ArmStatus ArmController::jog(const float velocities[JOINT_COUNT]) {
+  if (isPlaying) return ARM_BUSY;
+
+  float v[JOINT_COUNT];
+  uint8_t moving = 0;
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+    v[i] = jointEnabled[i] ? constrain(velocities[i], -servoSpeed, servoSpeed) : 0;
+    if (v[i] != 0) moving |= 1 << i;
+  }
+  if (!motion.jog(v, JOG_DEADMAN_MS / 1000.0f)) return ARM_QUEUE_FULL;
+  jogMask |= moving;
+
+  syncJog();
+  if (isRecording) {
+    recordPose();
+  }
+  return ARM_OK;
+}
+
+// Jogged joints go wherever the velocities take them, so the commanded
+// positions are read back from the motion task
+void ArmController::syncJog() {
+  MotionSnapshot snap;
+  motion.snapshot(snap);
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+    if (jogMask & (1 << i)) pos[i] = snap.target[i];
+  }
+  if (jogMask && motion.isIdle()) {
+    jogMask = 0;
+    if (isRecording) recordPose(); // Where it came to rest
+  }
+}
+
+// Walks a shoulder or elbow move from the current position towards target,
+// the other joint held, and stops at the last pose inside the envelope. From
+// a pose already outside (the joint was moved by hand while limp), only a
+// target inside is let through.
+int ArmController::limitToEnvelope(JointId joint, int target) const {
+  int pair[2] = {pos[JOINT_SHOULDER], pos[JOINT_ELBOW]};
+  int& moving = pair[joint == JOINT_SHOULDER ? 0 : 1];
+  int from = moving;
+  if (!envelopeAllows(pair[0], pair[1])) {
+    moving = target;
+    return envelopeAllows(pair[0], pair[1]) ? target : from;
+  }
+
+  int step = target > from ? 1 : -1;
+  int reached = from;
+  while (reached != target) {
+    moving = reached + step;
+    if (!envelopeAllows(pair[0], pair[1])) break;
+    reached = moving;
+  }
+  return reached;
+}
+
+// Whether a coordinated move from where the arm is now to `targets` stays
+// inside the envelope all the way. From a pose already outside, as with a
+// slider, the target alone decides.
+bool ArmController::lineAllowed(const int targets[JOINT_COUNT]) const {
+  MotionSnapshot snap;
+  motion.snapshot(snap);
+  int s = snap.position[JOINT_SHOULDER], e = snap.position[JOINT_ELBOW];
+  if (!envelopeAllows(s, e)) return envelopeAllows(targets[JOINT_SHOULDER], targets[JOINT_ELBOW]);
+  return envelopeAllowsLine(s, e, targets[JOINT_SHOULDER], targets[JOINT_ELBOW]);
+}
+
+// Moves the shoulder/elbow of a whole-arm pose to the nearest allowed pair
+bool ArmController::projectToEnvelope(int targets[JOINT_COUNT]) {
+  if (!envelopeProject(targets[JOINT_SHOULDER], targets[JOINT_ELBOW])) return false;
+  corrections++;
+  return true;
+}
+
+// Adds the current state of ALL servos as a new pose, unless it is the same
+// as the last recorded one
+void ArmController::recordPose() {
+  uint8_t currentPose[JOINT_COUNT];
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+    currentPose[i] = (uint8_t)pos[i];
+  }
+  if (!recorded.empty() && memcmp(recorded.back().joints, currentPose, JOINT_COUNT) == 0) {
+    return;
+  }
+
+  if (recorded.append(currentPose, millis())) {
+    LOG_DEBUG("Pose recorded. Sequence size: %u", (unsigned)recorded.size());
+  } else {
+    isRecording = false;
+    LOG_WARN("Recording buffer full. Recording stopped.");
+  }
+}
+
+ArmStatus ArmController::toggleJoint(JointId joint, bool& nowEnabled) {
+  // Playback owns the attach/detach state until it finishes
+  if (isPlaying) return ARM_BUSY;
+
+  if (!motion.setEnabled(joint, !jointEnabled[joint])) return ARM_QUEUE_FULL;
+  jointEnabled[joint] = !jointEnabled[joint];
+  nowEnabled = jointEnabled[joint];
+  jogMask &= ~(1 << joint);
+  return ARM_OK;
+}
+
+ArmStatus ArmController::goHome() {
+  if (isPlaying) return ARM_BUSY;
+
+  // A home saved before the envelope existed may lie outside it
+  int targets[JOINT_COUNT];
+  memcpy(targets, homePos, sizeof(targets));
+  projectToEnvelope(targets);
+  // All of it or nothing
+  size_t moves = 0;
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) moves += jointEnabled[i];
+  if (!motion.hasRoom(moves)) return ARM_QUEUE_FULL;
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+    if (jointEnabled[i]) {
+      motion.setTarget((JointId)i, targets[i], servoSpeed);
+      pos[i] = targets[i];
+    }
+  }
+  jogMask = 0;
+  return ARM_OK;
+}
+
+ArmStatus ArmController::saveHome(const int newHome[JOINT_COUNT]) {
+  if (!envelopeAllows(newHome[JOINT_SHOULDER], newHome[JOINT_ELBOW])) return ARM_UNSAFE;
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+    homePos[i] = constrain(newHome[i], 0, 180);
+  }
+  if (!store.saveHome(homePos)) return ARM_STORAGE_ERROR;
+
+  LOG_INFO("Home settings saved: base %d, shoulder %d, elbow %d, gripper %d",
+           homePos[JOINT_BASE], homePos[JOINT_SHOULDER], homePos[JOINT_ELBOW], homePos[JOINT_GRIPPER]);
+  return ARM_OK;
+}
+
+ArmStatus ArmController::moveXYZ(const ArmPoint& target, int out[JOINT_COUNT]) {
+  if (isPlaying) return ARM_BUSY;
+  if (!jointEnabled[JOINT_BASE] || !jointEnabled[JOINT_SHOULDER] || !jointEnabled[JOINT_ELBOW]) {
+    return ARM_NOT_ENABLED;
+  }
+
+  ArmAngles angles;
+  if (!solveIK(target, angles)) return ARM_OUT_OF_REACH;
+
+  int targets[JOINT_COUNT] = {(angles.base + 50) / 100, (angles.shoulder + 50) / 100,
+                              (angles.elbow + 50) / 100, pos[JOINT_GRIPPER]};
+  // The joints move in proportion, so the whole line has to be clear, not
+  // just its end
+  if (!lineAllowed(targets)) return ARM_UNSAFE;
+  if (!motion.moveTo(targets)) return ARM_QUEUE_FULL;
+  jogMask = 0;
+
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+    pos[i] = targets[i];
+    out[i] = targets[i];
+  }
+  return ARM_OK;
+}
+// --- End Manual Control ---
+
+// --- Recording ---
+RecordEvent ArmController::toggleRecording() {
+  if (!isRecording) {
+    if (!recorded.empty()) {
+      LOG_WARN("Attempt to record over existing seq. Must delete first.");
+      return RECORD_MUST_DELETE_FIRST;
+    }
+    isRecording = true;
+    LOG_INFO("Recording started.");
+    return RECORD_STARTED;
+  }
+
+  isRecording = false;
+  KeyframeStats stats = compressKeyframes(recorded, keyframeTolerance);
+  LOG_INFO("Recording stopped. Poses: %u -> %u keyframes (%.1fx)",
+           (unsigned)stats.before, (unsigned)stats.after, stats.ratio());
+  return RECORD_STOPPED;
+}
+
+bool ArmController::deleteRecording() {
+  if (isPlaying) {
+    stopPlayback();
+  }
+  recorded.clear();
+  bool wasRecording = isRecording;
+  isRecording = false;
+  LOG_INFO("Recorded sequence deleted.");
+  return wasRecording;
+}
+
+ArmStatus ArmController::compressRecording(const float* tolerance, KeyframeStats& stats) {
+  if (isRecording || isPlaying) return ARM_BUSY;
+
+  if (tolerance) {
+    for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+      keyframeTolerance[i] = tolerance[i];
+    }
+  }
+  stats = compressKeyframes(recorded, keyframeTolerance);
+  return ARM_OK;
+}
+// --- End Recording ---
+
+// --- Playback ---
+ArmStatus ArmController::play(const char* name, uint16_t loops, float speed) {
+  if (isPlaying) return ARM_BUSY;
+  if (!(speed > 0)) return ARM_INVALID;
+
+  if (name) {
+    if (!playReader.open(store.filesystem(), name)) return ARM_NOT_FOUND;
+  } else if (recorded.empty()) {
+    LOG_WARN("Playback attempt: No sequence.");
+    return ARM_EMPTY;
+  }
+  if (!startPlayback(0)) {
+    playReader.close();
+    return ARM_QUEUE_FULL;
+  }
+  if (name) {
+    LOG_INFO("Streaming sequence '%s' (%u poses)...", name, (unsigned)playReader.size());
+  } else {
+    LOG_INFO("Playing sequence of %u poses...", (unsigned)recorded.size());
+  }
+  playLoops = loops;
+  setPlaySpeed(speed);
+  return ARM_OK;
+}
+
+ArmStatus ArmController::pause() {
+  if (!isPlaying) return ARM_NOT_FOUND;
+  if (playProgram) return ARM_INVALID;
+  if (!playPaused) {
+    motion.stopAll();
+    playPaused = true;
+    playDwelling = false;
+    LOG_INFO("Playback paused.");
+  }
+  return ARM_OK;
+}
+
+ArmStatus ArmController::resume() {
+  if (!isPlaying) return ARM_NOT_FOUND;
+  if (!playPaused) return ARM_OK;
+  // Before the first pose there is no interrupted move to finish
+  if (playIndex > 0 && !motion.moveTo(playDetour ? playVia : playTargets, playSpeedScale)) return ARM_QUEUE_FULL;
+  playPaused = false;
+  LOG_INFO("Playback resumed.");
+  return ARM_OK;
+}
+
+ArmStatus ArmController::stop() {
+  if (!isPlaying) return ARM_NOT_FOUND;
+  stopPlayback();
+  LOG_INFO("Playback stopped.");
+  return ARM_OK;
+}
+
+ArmStatus ArmController::setPlaySpeed(float speed) {
+  if (!(speed > 0)) return ARM_INVALID; // Also catches NaN
+  playSpeedScale = constrain(speed, MIN_PLAY_SPEED, MAX_PLAY_SPEED);
+  return ARM_OK;
+}
+
+// Stops the arm where it is and ends playback of either kind
+void ArmController::stopPlayback() {
+  motion.stopAll();
+  finishPlayback(true);
+}
+
+// Temporarily enables every disabled joint. False, changing nothing, unless
+// the queue has room for that and `commands` more.
+bool ArmController::startPlayback(size_t commands) {
+  size_t enables = 0;
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) enables += !jointEnabled[i];
+  if (!motion.hasRoom(enables + commands)) return false;
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+    tempEnabled[i] = !jointEnabled[i]; // True if we need to temp enable
+    if (tempEnabled[i]) motion.setEnabled((JointId)i, true);
+  }
+  playIndex = 0;
+  playDwelling = false;
+  playDetour = false;
+  playPaused = false;
+  playLoops = 1;
+  playLoop = 0;
+  isPlaying = true;
+  return true;
+}
+
+// Ends playback, leaving the servos where they are (or, if interrupted,
+// where they were when the hold was requested)
+void ArmController::finishPlayback(bool interrupted) {
+  isPlaying = false;
+  playProgram = false;
+  playPaused = false;
+  playReader.close();
+
+  MotionSnapshot snap;
+  motion.snapshot(snap);
+  const int16_t* where = interrupted ? snap.position : snap.target;
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+    pos[i] = where[i];
+    if (tempEnabled[i]) motion.setEnabled((JointId)i, false);
+  }
+}
+
+// Hands the next pose to the motion task once the previous one has been
+// reached and its dwell time has passed
+void ArmController::update() {
+  if (jogMask) {
+    if (isPlaying) {
+      jogMask = 0; // Playback took over
+    } else {
+      syncJog();
+    }
+  }
+  if (isPlaying && playProgram) {
+    if (!motion.programBusy()) {
+      finishPlayback(false);
+      LOG_INFO("Program finished.");
+    }
+    return;
+  }
+  if (!isPlaying || playPaused || !motion.isIdle()) {
+    return;
+  }
+  if (playDetour) { // At the corner: on to the pose itself
+    playDetour = false;
+    motion.moveTo(playTargets, playSpeedScale);
+    return;
+  }
+
+  if (playIndex > 0 && !playDwelling) {
+    playDwelling = true;
+    playDwellStart = millis();
+  }
+  if (playDwelling) {
+    if (millis() - playDwellStart < playDwellMs / playSpeedScale) {
+      return;
+    }
+    playDwelling = false;
+  }
+
+  PackedPose pose;
+  bool havePose = readPlayPose(pose);
+  if (!havePose && (playLoops == 0 || playLoop + 1 < playLoops) &&
+      (!playReader.isOpen() || playReader.rewind())) {
+    playLoop++;
+    playIndex = 0;
+    havePose = readPlayPose(pose);
+  }
+  if (!havePose) {
+    finishPlayback(false);
+    LOG_INFO("Playback finished.");
+    return;
+  }
+  playIndex++;
+
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+    playTargets[i] = pose.joints[i];
+  }
+  // Sequences from flash may come from another arm or an older envelope
+  projectToEnvelope(playTargets);
+  // Two allowed poses can have a collision between them. Go round it one
+  // joint at a time, or stop if neither order is clear.
+  if (!lineAllowed(playTargets)) {
+    MotionSnapshot snap;
+    motion.snapshot(snap);
+    memcpy(playVia, playTargets, sizeof(playVia));
+    corrections++;
+    if (!envelopeDetour(snap.position[JOINT_SHOULDER], snap.position[JOINT_ELBOW], playTargets[JOINT_SHOULDER],
+                        playTargets[JOINT_ELBOW], playVia[JOINT_SHOULDER], playVia[JOINT_ELBOW])) {
+      finishPlayback(false);
+      LOG_WARN("Playback stopped: no clear path to pose %u", (unsigned)playIndex);
+      return;
+    }
+    playDetour = true;
+    motion.moveTo(playVia, playSpeedScale);
+    return;
+  }
+  motion.moveTo(playTargets, playSpeedScale);
+}
+
+bool ArmController::readPlayPose(PackedPose& pose) {
+  if (playReader.isOpen()) return playReader.next(pose);
+  if (playIndex >= recorded.size()) return false;
+  pose = recorded[playIndex];
+  return true;
+}
+ArmStatus ArmController::runProgram(const char* text, ProgramError& error) {
+  if (isPlaying || isRecording || motion.programBusy()) return ARM_BUSY;
+
+  MotionProgram& program = motion.program();
+  if (!program.parse(text, pos, error)) {
+    program.clear();
+    return ARM_INVALID;
+  }
+  if (program.size() == 0) return ARM_EMPTY;
+  // Rounded corners, from where the arm actually is
+  MotionSnapshot snap;
+  motion.snapshot(snap);
+  float start[JOINT_COUNT];
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) start[i] = snap.position[i];
+  if (!motion.checkProgram(start, error)) {
+    program.clear();
+    return ARM_INVALID;
+  }
+
+  if (!startPlayback(1)) {
+    program.clear();
+    return ARM_QUEUE_FULL;
+  }
+  playProgram = true;
+  motion.runProgram(); // Room checked above
+  LOG_INFO("Running program of %u moves...", (unsigned)program.size());
+  return ARM_OK;
+}
+
+ArmStatus ArmController::stopProgram() {
+  if (!isPlaying || !playProgram) return ARM_NOT_FOUND;
+  stopPlayback();
+  LOG_INFO("Program stopped.");
+  return ARM_OK;
+}
+// --- End Playback ---
+
+// --- Sequence Library ---
+ArmStatus ArmController::saveSequence(const char* name) {
+  if (!SequenceStore::validName(name)) return ARM_INVALID;
+  if (isRecording) return ARM_BUSY;
+  if (recorded.empty()) return ARM_EMPTY;
+  if (!store.save(name, recorded)) return ARM_STORAGE_ERROR;
+
+  LOG_INFO("Saved sequence '%s' (%u poses)", name, (unsigned)recorded.size());
+  return ARM_OK;
+}
+
+// Loads a stored sequence into RAM so it can be played or re-saved
+ArmStatus ArmController::loadSequence(const char* name) {
+  if (isPlaying || isRecording) return ARM_BUSY;
+  if (!store.exists(name)) return ARM_NOT_FOUND;
+  if (!store.load(name, recorded)) {
+    recorded.clear();
+    return ARM_TOO_LARGE;
+  }
+  return ARM_OK;
+}
+
+ArmStatus ArmController::deleteSequence(const char* name) {
+  if (isPlaying && playReader.isOpen()) return ARM_BUSY;
+  return store.remove(name) ? ARM_OK : ARM_NOT_FOUND;
+}
+
+ArmStatus ArmController::beginUpload() {
+  if (isPlaying || isRecording) return ARM_BUSY;
+  recorded.clear();
+  return ARM_OK;
+}
+
+ArmStatus ArmController::uploadPose(const PackedPose& pose) {
+  if (isPlaying || isRecording) return ARM_BUSY;
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+    if (pose.joints[i] > 180) return ARM_INVALID;
+  }
+  if (!envelopeAllows(pose.joints[JOINT_SHOULDER], pose.joints[JOINT_ELBOW])) return ARM_UNSAFE;
+  return recorded.appendPacked(pose) ? ARM_OK : ARM_TOO_LARGE;
+}
+// --- End Sequence Library ---
+
+// Poses (or program moves) handed to the motion task so far, and how many
+// there are in total; 0/0 when not playing
+void ArmController::playProgress(uint32_t& done, uint32_t& total) const {
+  done = total = 0;
+  if (!isPlaying) return;
+  if (playProgram) {
+    MotionSnapshot snap;
+    motion.snapshot(snap);
+    done = snap.programBlock;
+    total = motion.program().size();
+  } else {
+    done = playIndex;
+    total = playReader.isOpen() ? playReader.size() : recorded.size();
+  }
+}
+
+size_t ArmController::stateJson(char* json, size_t len) const {
+  ArmAngles angles = {pos[JOINT_BASE] * 100, pos[JOINT_SHOULDER] * 100, pos[JOINT_ELBOW] * 100};
+  ArmPoint tip;
+  forwardKinematics(angles, tip);
+  // Where the servos actually are, which differs from `pos` mid-move and
+  // during playback
+  MotionSnapshot snap;
+  motion.snapshot(snap);
+  uint32_t done, total;
+  playProgress(done, total);
+
+  int n = snprintf(json, len,
+                   "{\"pos\":[%d,%d,%d,%d],\"actual\":[%d,%d,%d,%d],\"enabled\":[%d,%d,%d,%d],"
+                   "\"home\":[%d,%d,%d,%d],\"xyz\":[%.1f,%.1f,%.1f],"
+                   "\"recording\":%s,\"playing\":%s,\"paused\":%s,\"progress\":[%u,%u],"
+                   "\"loop\":[%u,%u],\"speed\":%.2f,\"poses\":%u,\"capacity\":%u}",
+                   pos[0], pos[1], pos[2], pos[3],
+                   snap.position[0], snap.position[1], snap.position[2], snap.position[3],
+                   jointEnabled[0], jointEnabled[1], jointEnabled[2], jointEnabled[3],
+                   homePos[0], homePos[1], homePos[2], homePos[3],
+                   tip.x / 10.0f, tip.y / 10.0f, tip.z / 10.0f,
+                   isRecording ? "true" : "false", isPlaying ? "true" : "false", playPaused ? "true" : "false",
+                   (unsigned)done, (unsigned)total, (unsigned)playLoop + (isPlaying ? 1 : 0), (unsigned)playLoops,
+                   playSpeedScale,
+                   (unsigned)recorded.size(), (unsigned)recorded.capacity());
+  return n < 0 ? 0 : ((size_t)n < len ? (size_t)n : len - 1);
+}
@@ -0,0 +1,143 @@
+#include "BlendPath.h"
+
+BlendPath::BlendPath() : count(0), segments(0), total(0), cursor(0) {}
+
+void BlendPath::clear() {
+  count = 0;
+  segments = 0;
+  total = 0;
+  cursor = 0;
+}
+
+bool BlendPath::addPoint(const int16_t target[JOINT_COUNT], float speedCap) {
+  if (count >= MAX_POINTS) return false;
+  count++;
+  for (uint8_t j = 0; j < JOINT_COUNT; j++) {
+    point[count][j] = constrain(target[j], 0, 180);
+  }
+  cap[count - 1] = speedCap;
+  return true;
+}
+
+// Velocity of segment k; zero before the first and after the last segment,
+// where the arm is at rest
+float BlendPath::segmentVelocity(int k, uint8_t joint) const {
+  if (k < 0 || k >= segments) return 0;
+  return velocity[k][joint];
+}
+
+// Each blend is as short as the most accel-limited joint allows; the other
+// joints blend over the same time with less acceleration
+void BlendPath::computeBlends(const float maxAccel[JOINT_COUNT]) {
+  for (uint8_t k = 0; k < segments; k++) {
+    for (uint8_t j = 0; j < JOINT_COUNT; j++) {
+      velocity[k][j] = (point[k + 1][j] - point[k][j]) / segTime[k];
+    }
+  }
+  for (uint8_t i = 0; i <= segments; i++) {
+    float longest = 0;
+    for (uint8_t j = 0; j < JOINT_COUNT; j++) {
+      float dv = fabsf(segmentVelocity(i, j) - segmentVelocity(i - 1, j));
+      float t = maxAccel[j] > 0 ? dv / maxAccel[j] : 0;
+      if (t > longest) longest = t;
+    }
+    blendTime[i] = longest;
+  }
+}
+
+float BlendPath::plan(const float start[JOINT_COUNT], const float maxSpeed[JOINT_COUNT],
+                      const float maxAccel[JOINT_COUNT]) {
+  // Drop waypoints the arm is already at; they would only force a stop
+  for (uint8_t j = 0; j < JOINT_COUNT; j++) point[0][j] = start[j];
+  segments = 0;
+  for (uint8_t i = 1; i <= count; i++) {
+    bool moves = false;
+    for (uint8_t j = 0; j < JOINT_COUNT; j++) {
+      if (fabsf(point[i][j] - point[segments][j]) > 0.01f) moves = true;
+    }
+    if (!moves) continue;
+    if (i != segments + 1) {
+      for (uint8_t j = 0; j < JOINT_COUNT; j++) point[segments + 1][j] = point[i][j];
+    }
+    cap[segments] = cap[i - 1];
+    segments++;
+  }
+  count = segments;
+
+  // Fastest time for each segment on its own, at the slowest joint's speed
+  for (uint8_t k = 0; k < segments; k++) {
+    float t = 0;
+    for (uint8_t j = 0; j < JOINT_COUNT; j++) {
+      float vMax = maxSpeed[j];
+      if (cap[k] > 0 && cap[k] < vMax) vMax = cap[k];
+      if (vMax <= 0) continue;
+      float tj = fabsf(point[k + 1][j] - point[k][j]) / vMax;
+      if (tj > t) t = tj;
+    }
+    segTime[k] = t > 0.001f ? t : 0.001f;
+  }
+
+  // Look-ahead: a segment must be long enough to hold half of the blend at
+  // each end. Lengthening it lowers its speed, which shortens those blends,
+  // so a few passes settle it. If they don't, slow everything down and retry.
+  for (uint8_t outer = 0; outer < 8; outer++) {
+    bool settled = false;
+    for (uint8_t pass = 0; pass < 16 && !settled; pass++) {
+      computeBlends(maxAccel);
+      settled = true;
+      for (uint8_t k = 0; k < segments; k++) {
+        float needed = (blendTime[k] + blendTime[k + 1]) / 2;
+        if (needed > segTime[k] * 1.0001f) {
+          segTime[k] = needed;
+          settled = false;
+        }
+      }
+    }
+    if (settled) break;
+    for (uint8_t k = 0; k < segments; k++) segTime[k] *= 1.5f;
+  }
+  computeBlends(maxAccel);
+
+  // The clock starts when the first blend (leaving the start) does
+  viaTime[0] = blendTime[0] / 2;
+  for (uint8_t k = 0; k < segments; k++) {
+    viaTime[k + 1] = viaTime[k] + segTime[k];
+  }
+  total = segments ? viaTime[segments] + blendTime[segments] / 2 : 0;
+  cursor = 0;
+  return total;
+}
+
+void BlendPath::positionAt(float t, float out[JOINT_COUNT]) const {
+  if (segments == 0 || t <= 0) {
+    for (uint8_t j = 0; j < JOINT_COUNT; j++) out[j] = point[0][j];
+    return;
+  }
+  if (t >= total) {
+    end(out);
+    return;
+  }
+
+  // cursor = the last point whose blend has started by time t
+  while (cursor < segments && t >= viaTime[cursor + 1] - blendTime[cursor + 1] / 2) cursor++;
+  while (cursor > 0 && t < viaTime[cursor] - blendTime[cursor] / 2) cursor--;
+
+  uint8_t i = cursor;
+  float blendStart = viaTime[i] - blendTime[i] / 2;
+  bool inBlend = blendTime[i] > 0 && t < viaTime[i] + blendTime[i] / 2;
+  for (uint8_t j = 0; j < JOINT_COUNT; j++) {
+    if (inBlend) {
+      // Incoming segment's line, bent towards the outgoing one
+      float vIn = segmentVelocity(i - 1, j);
+      float vOut = segmentVelocity(i, j);
+      float tau = t - blendStart;
+      out[j] = point[i][j] + vIn * (t - viaTime[i]) + 0.5f * (vOut - vIn) / blendTime[i] * tau * tau;
+    } else {
+      out[j] = point[i][j] + segmentVelocity(i, j) * (t - viaTime[i]);
+    }
+  }
+}
+
+void BlendPath::end(float out[JOINT_COUNT]) const {
+  for (uint8_t j = 0; j < JOINT_COUNT; j++) out[j] = point[segments][j];
+}
@@ -0,0 +1,108 @@
+#include "ControlChannel.h"
+
+ControlChannel::ControlChannel() : hasJogPending(false), jogSlot(-1), accepted(0), dropped(0) {
+  for (uint8_t c = 0; c < MAX_CLIENTS; c++) {
+    used[c] = false;
+    clientIds[c] = 0;
+  }
+  for (uint8_t j = 0; j < JOINT_COUNT; j++) {
+    pending[j] = 0;
+    hasPending[j] = false;
+    jogPending[j] = 0;
+  }
+}
+
+int ControlChannel::slotFor(uint32_t client) const {
+  for (uint8_t c = 0; c < MAX_CLIENTS; c++) {
+    if (used[c] && clientIds[c] == client) return c;
+  }
+  return -1;
+}
+
+bool ControlChannel::connect(uint32_t client) {
+  int slot = slotFor(client);
+  for (uint8_t c = 0; slot < 0 && c < MAX_CLIENTS; c++) {
+    if (!used[c]) slot = c;
+  }
+  if (slot < 0) return false;
+  used[slot] = true;
+  clientIds[slot] = client;
+  for (uint8_t j = 0; j < JOINT_COUNT; j++) {
+    lastSeq[slot][j] = 0;
+    haveSeq[slot][j] = false;
+  }
+  haveJogSeq[slot] = false;
+  return true;
+}
+
+void ControlChannel::disconnect(uint32_t client) {
+  int slot = slotFor(client);
+  if (slot < 0) return;
+  used[slot] = false;
+  if (slot == jogSlot) {
+    // Don't leave the arm moving until the dead-man timeout
+    for (uint8_t j = 0; j < JOINT_COUNT; j++) jogPending[j] = 0;
+    hasJogPending = true;
+    jogSlot = -1;
+  }
+}
+
+bool ControlChannel::accept(uint32_t client, const uint8_t* frame, size_t length) {
+  int slot = slotFor(client);
+  if (slot >= 0 && length == JOG_FRAME_SIZE && frame[0] == JOG_FRAME_TAG) {
+    return acceptJog(slot, frame);
+  }
+  if (slot < 0 || length != CONTROL_FRAME_SIZE || frame[0] >= JOINT_COUNT) {
+    dropped++;
+    return false;
+  }
+
+  uint8_t joint = frame[0];
+  uint16_t tenths = frame[1] | (frame[2] << 8);
+  uint16_t seq = frame[3] | (frame[4] << 8);
+
+  // Serial number arithmetic so the 16-bit counter can wrap
+  if (haveSeq[slot][joint] && (int16_t)(seq - lastSeq[slot][joint]) <= 0) {
+    dropped++;
+    return false;
+  }
+  lastSeq[slot][joint] = seq;
+  haveSeq[slot][joint] = true;
+
+  pending[joint] = constrain((tenths + 5) / 10, 0, 180);
+  hasPending[joint] = true;
+  accepted++;
+  return true;
+}
+
+bool ControlChannel::takePending(JointId joint, int& position) {
+  if (!hasPending[joint]) return false;
+  hasPending[joint] = false;
+  position = pending[joint];
+  return true;
+}
+
+bool ControlChannel::acceptJog(int slot, const uint8_t* frame) {
+  uint16_t seq = frame[9] | (frame[10] << 8);
+  if (haveJogSeq[slot] && (int16_t)(seq - lastJogSeq[slot]) <= 0) {
+    dropped++;
+    return false;
+  }
+  lastJogSeq[slot] = seq;
+  haveJogSeq[slot] = true;
+
+  for (uint8_t j = 0; j < JOINT_COUNT; j++) {
+    jogPending[j] = (int16_t)(frame[1 + 2 * j] | (frame[2 + 2 * j] << 8));
+  }
+  hasJogPending = true;
+  jogSlot = slot;
+  accepted++;
+  return true;
+}
+
+bool ControlChannel::takeJog(float velocities[JOINT_COUNT]) {
+  if (!hasJogPending) return false;
+  hasJogPending = false;
+  for (uint8_t j = 0; j < JOINT_COUNT; j++) velocities[j] = jogPending[j] / 10.0f;
+  return true;
+}
@@ -0,0 +1,77 @@
+#include "Envelope.h"
+#include "EnvelopeTable.h"
+
+bool envelopeAllows(int shoulder, int elbow) {
+  if (shoulder < 0 || shoulder >= ENVELOPE_DEGREES || elbow < 0 || elbow >= ENVELOPE_DEGREES) return false;
+  uint32_t i = (uint32_t)shoulder * ENVELOPE_DEGREES + elbow;
+  return pgm_read_byte(&ENVELOPE_BITS[i >> 3]) & (1 << (i & 7));
+}
+
+// The line crosses into a new cell wherever either coordinate passes a
+// half degree: crossing k of a joint that moves n degrees is at
+// t = (2k + 1) / 2n. Walks those crossings in order, merging the two
+// joints' by comparing the fractions exactly, and checks each cell entered.
+bool envelopeAllowsLine(int fromShoulder, int fromElbow, int toShoulder, int toElbow) {
+  if (!envelopeAllows(fromShoulder, fromElbow)) return false;
+  int ds = toShoulder - fromShoulder, de = toElbow - fromElbow;
+  int ns = abs(ds), ne = abs(de);
+  int ks = 0, ke = 0;
+  while (ks < ns || ke < ne) {
+    // Whichever joint crosses next; both at once through a cell corner
+    bool stepS = ke >= ne, stepE = ks >= ns;
+    if (!stepS && !stepE) {
+      int32_t s = (2 * ks + 1) * ne, e = (2 * ke + 1) * ns;
+      stepS = s <= e;
+      stepE = e <= s;
+    }
+    if (stepS) ks++;
+    if (stepE) ke++;
+    if (!envelopeAllows(fromShoulder + (ds > 0 ? ks : -ks), fromElbow + (de > 0 ? ke : -ke))) return false;
+  }
+  return true;
+}
+
+bool envelopeDetour(int fromShoulder, int fromElbow, int toShoulder, int toElbow, int& viaShoulder, int& viaElbow) {
+  // Shoulder first, then elbow first
+  const int corners[2][2] = {{toShoulder, fromElbow}, {fromShoulder, toElbow}};
+  for (uint8_t i = 0; i < 2; i++) {
+    if (envelopeAllowsLine(fromShoulder, fromElbow, corners[i][0], corners[i][1]) &&
+        envelopeAllowsLine(corners[i][0], corners[i][1], toShoulder, toElbow)) {
+      viaShoulder = corners[i][0];
+      viaElbow = corners[i][1];
+      return true;
+    }
+  }
+  return false;
+}
+
+// Searches square rings of growing radius around the pair. A hit on ring k
+// is at most k*sqrt(2) away, so rings keep being searched until they can't
+// hold anything closer.
+bool envelopeProject(int& shoulder, int& elbow) {
+  shoulder = constrain(shoulder, 0, ENVELOPE_DEGREES - 1);
+  elbow = constrain(elbow, 0, ENVELOPE_DEGREES - 1);
+  if (envelopeAllows(shoulder, elbow)) return false;
+
+  int bestS = shoulder, bestE = elbow;
+  int bestDist2 = -1;
+  for (int k = 1; k < ENVELOPE_DEGREES; k++) {
+    if (bestDist2 >= 0 && k * k > bestDist2) break;
+    for (int ds = -k; ds <= k; ds++) {
+      // Whole top and bottom rows, only the ends of the rows in between
+      int step = (ds == -k || ds == k) ? 1 : 2 * k;
+      for (int de = -k; de <= k; de += step) {
+        int dist2 = ds * ds + de * de;
+        if (bestDist2 >= 0 && dist2 >= bestDist2) continue;
+        if (envelopeAllows(shoulder + ds, elbow + de)) {
+          bestS = shoulder + ds;
+          bestE = elbow + de;
+          bestDist2 = dist2;
+        }
+      }
+    }
+  }
+  shoulder = bestS;
+  elbow = bestE;
+  return true;
+}
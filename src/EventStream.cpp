@@ -0,0 +1,34 @@
+#include "EventStream.h"
+
+EventStream::EventStream(const char* url, uint16_t rateHz)
+    : src(url), lastPublishMs(0), lastSendMs(0), lastEvent(nullptr), frames(0) {
+  lastData[0] = '\0';
+  setRate(rateHz);
+}
+
+void EventStream::setRate(uint16_t rateHz) {
+  intervalMs = 1000 / constrain(rateHz, 1, 50);
+}
+
+bool EventStream::due(uint32_t nowMs) const {
+  return src.count() > 0 && nowMs - lastPublishMs >= intervalMs;
+}
+
+void EventStream::publish(const char* event, const char* data, uint32_t nowMs) {
+  lastPublishMs = nowMs;
+  size_t len = strlen(data);
+  if (len >= sizeof(lastData)) return; // Would be cut mid-JSON
+
+  bool same = lastEvent == event && strcmp(lastData, data) == 0;
+  if (same && nowMs - lastSendMs < HEARTBEAT_MS) return;
+
+  memcpy(lastData, data, len + 1);
+  lastEvent = event;
+  src.send(lastData, lastEvent, ++frames);
+  lastSendMs = nowMs;
+}
+
+void EventStream::replay(AsyncEventSourceClient* client) {
+  if (!lastEvent) return;
+  client->send(lastData, lastEvent, frames, RETRY_MS);
+}
@@ -0,0 +1,85 @@
+#include "Keyframes.h"
+
+// End indices still to be checked. Only one side of each split is pending at
+// a time, so this never holds more than one entry per pose.
+static uint16_t pendingEnds[PoseBuffer::CAPACITY];
+
+// Squared distance from p to the segment a-b, with every joint divided by
+// its tolerance so that <= 1 means "within tolerance"
+static float scaledDistanceSq(const PackedPose& p, const PackedPose& a, const PackedPose& b,
+                              const float invTolerance[JOINT_COUNT]) {
+  float v[JOINT_COUNT], w[JOINT_COUNT];
+  float vv = 0, wv = 0;
+  for (uint8_t j = 0; j < JOINT_COUNT; j++) {
+    v[j] = (b.joints[j] - a.joints[j]) * invTolerance[j];
+    w[j] = (p.joints[j] - a.joints[j]) * invTolerance[j];
+    vv += v[j] * v[j];
+    wv += w[j] * v[j];
+  }
+
+  float t = (vv > 0) ? wv / vv : 0;
+  if (t < 0) t = 0;
+  if (t > 1) t = 1;
+
+  float d = 0;
+  for (uint8_t j = 0; j < JOINT_COUNT; j++) {
+    float e = w[j] - t * v[j];
+    d += e * e;
+  }
+  return d;
+}
+
+KeyframeStats compressKeyframes(PoseBuffer& poses, const float tolerance[JOINT_COUNT]) {
+  KeyframeStats stats = {poses.size(), poses.size()};
+  if (poses.size() < 3) return stats;
+
+  float invTolerance[JOINT_COUNT];
+  for (uint8_t j = 0; j < JOINT_COUNT; j++) {
+    // Poses are whole degrees, so anything under half a degree means "exact"
+    invTolerance[j] = 1.0f / (tolerance[j] > 0.5f ? tolerance[j] : 0.5f);
+  }
+
+  // Walk left to right: split [start, end] at the farthest pose until it
+  // fits, then emit `end` as a keyframe. Keyframes come out in order and
+  // never ahead of the pose being read, so they are written back in place.
+  size_t out = 1; // poses[0] stays where it is
+  size_t start = 0;
+  size_t depth = 0;
+  pendingEnds[depth++] = poses.size() - 1;
+
+  while (depth > 0) {
+    size_t end = pendingEnds[depth - 1];
+    const PackedPose& a = poses[start];
+    const PackedPose& b = poses[end];
+
+    float worst = 1.0f;
+    size_t split = 0;
+    for (size_t i = start + 1; i < end; i++) {
+      float d = scaledDistanceSq(poses[i], a, b, invTolerance);
+      if (d > worst) {
+        worst = d;
+        split = i;
+      }
+    }
+
+    if (split != 0) {
+      pendingEnds[depth++] = split;
+      continue;
+    }
+
+    uint32_t dt = 0;
+    for (size_t i = start + 1; i <= end; i++) {
+      dt += poses[i].dtMs;
+    }
+    PackedPose keyframe = poses[end];
+    keyframe.dtMs = (dt > 0xFFFF) ? 0xFFFF : (uint16_t)dt;
+    poses.at(out++) = keyframe;
+
+    start = end;
+    depth--;
+  }
+
+  poses.truncate(out);
+  stats.after = out;
+  return stats;
+}
@@ -0,0 +1,132 @@
+#include "Kinematics.h"
+
+// sin(k degrees) in Q16, k = 0..90
+static const int32_t SIN_TABLE[91] = {
+  0, 1144, 2287, 3430, 4572, 5712, 6850, 7987, 9121, 10252,
+  11380, 12505, 13626, 14742, 15855, 16962, 18064, 19161, 20252, 21336,
+  22415, 23486, 24550, 25607, 26656, 27697, 28729, 29753, 30767, 31772,
+  32768, 33754, 34729, 35693, 36647, 37590, 38521, 39441, 40348, 41243,
+  42126, 42995, 43852, 44695, 45525, 46341, 47143, 47930, 48703, 49461,
+  50203, 50931, 51643, 52339, 53020, 53684, 54332, 54963, 55578, 56175,
+  56756, 57319, 57865, 58393, 58903, 59396, 59870, 60326, 60764, 61183,
+  61584, 61966, 62328, 62672, 62997, 63303, 63589, 63856, 64104, 64332,
+  64540, 64729, 64898, 65048, 65177, 65287, 65376, 65446, 65496, 65526,
+  65536,
+};
+
+// atan(k / 64) in centidegrees, k = 0..64
+static const int32_t ATAN_TABLE[65] = {
+  0, 90, 179, 268, 358, 447, 536, 624, 713, 800, 888, 975, 1062,
+  1148, 1234, 1319, 1404, 1488, 1571, 1653, 1735, 1817, 1897, 1977, 2056, 2134,
+  2211, 2287, 2363, 2438, 2511, 2584, 2657, 2728, 2798, 2867, 2936, 3003, 3070,
+  3136, 3201, 3264, 3327, 3390, 3451, 3511, 3571, 3629, 3687, 3744, 3800, 3855,
+  3909, 3963, 4016, 4067, 4119, 4169, 4218, 4267, 4315, 4363, 4409, 4455, 4500,
+};
+
+int32_t sinQ16(int32_t centideg) {
+  int32_t a = centideg % 36000;
+  if (a < 0) a += 36000;
+  bool negative = a >= 18000;
+  if (negative) a -= 18000;
+  if (a > 9000) a = 18000 - a;
+
+  int32_t idx = a / 100;
+  int32_t frac = a % 100;
+  int32_t v = SIN_TABLE[idx];
+  if (frac) v += (SIN_TABLE[idx + 1] - v) * frac / 100;
+  return negative ? -v : v;
+}
+
+int32_t cosQ16(int32_t centideg) {
+  return sinQ16(centideg + 9000);
+}
+
+int32_t atan2Centideg(int32_t y, int32_t x) {
+  if (x == 0 && y == 0) return 0;
+
+  // Fold into the first octant, look up, then unfold
+  uint32_t ax = (x < 0) ? -(int64_t)x : x;
+  uint32_t ay = (y < 0) ? -(int64_t)y : y;
+  bool steep = ay > ax;
+  uint32_t num = steep ? ax : ay;
+  uint32_t den = steep ? ay : ax;
+
+  uint32_t ratio = ((uint64_t)num << 16) / den; // Q16, 0..65536
+  uint32_t idx = ratio >> 10;                   // 64 table steps
+  int32_t frac = ratio & 0x3FF;
+  int32_t a = ATAN_TABLE[idx];
+  if (frac) a += ((ATAN_TABLE[idx + 1] - a) * frac) >> 10;
+
+  if (steep) a = 9000 - a;
+  if (x < 0) a = 18000 - a;
+  return (y < 0) ? -a : a;
+}
+
+int32_t acosCentideg(int32_t c) {
+  c = constrain(c, -65536, 65536);
+  // sin = sqrt(1 - cos^2), still Q16
+  uint32_t s = isqrt64(((uint64_t)1 << 32) - (int64_t)c * c);
+  return atan2Centideg(s, c);
+}
+
+uint32_t isqrt64(uint64_t v) {
+  uint64_t result = 0;
+  uint64_t bit = (uint64_t)1 << 62;
+  while (bit > v) bit >>= 2;
+  while (bit) {
+    if (v >= result + bit) {
+      v -= result + bit;
+      result = (result >> 1) + bit;
+    } else {
+      result >>= 1;
+    }
+    bit >>= 2;
+  }
+  return (uint32_t)result;
+}
+
+bool solveIK(const ArmPoint& target, ArmAngles& out) {
+  // Base yaw straight from the target's bearing
+  int32_t base = atan2Centideg(target.y, target.x);
+  if (base < 0 || base > 18000) return false;
+
+  // Work in the arm's vertical plane, on the wrist rather than the tip
+  int32_t r = (int32_t)isqrt64((int64_t)target.x * target.x + (int64_t)target.y * target.y) - ARM_GRIPPER_LENGTH;
+  int32_t h = target.z - ARM_SHOULDER_HEIGHT;
+  int64_t d2 = (int64_t)r * r + (int64_t)h * h;
+  int32_t d = isqrt64(d2);
+
+  const int32_t l1 = ARM_UPPER_LENGTH, l2 = ARM_FOREARM_LENGTH;
+  if (d > l1 + l2 || d < abs(l1 - l2) || d == 0) return false;
+
+  // Law of cosines for the angle at the shoulder between the upper arm and
+  // the shoulder-wrist line (elbow-up solution)
+  int64_t num = (int64_t)l1 * l1 + d2 - (int64_t)l2 * l2;
+  int32_t cosShoulder = (num << 16) / (2 * (int64_t)l1 * d);
+  int32_t shoulder = atan2Centideg(h, r) + acosCentideg(cosShoulder);
+
+  // Forearm's absolute angle, from the elbow to the wrist
+  int32_t ex = ((int64_t)l1 * cosQ16(shoulder)) >> 16;
+  int32_t ez = ((int64_t)l1 * sinQ16(shoulder)) >> 16;
+  int32_t forearm = atan2Centideg(h - ez, r - ex);
+  int32_t elbow = forearm + ARM_ELBOW_LEVEL;
+
+  if (shoulder < 0 || shoulder > 18000 || elbow < 0 || elbow > 18000) return false;
+
+  out.base = base;
+  out.shoulder = shoulder;
+  out.elbow = elbow;
+  return true;
+}
+
+void forwardKinematics(const ArmAngles& angles, ArmPoint& out) {
+  int32_t forearm = angles.elbow - ARM_ELBOW_LEVEL;
+  int64_t r = (((int64_t)ARM_UPPER_LENGTH * cosQ16(angles.shoulder) +
+                (int64_t)ARM_FOREARM_LENGTH * cosQ16(forearm)) >> 16) + ARM_GRIPPER_LENGTH;
+  int64_t z = (((int64_t)ARM_UPPER_LENGTH * sinQ16(angles.shoulder) +
+                (int64_t)ARM_FOREARM_LENGTH * sinQ16(forearm)) >> 16) + ARM_SHOULDER_HEIGHT;
+
+  out.x = (r * cosQ16(angles.base)) >> 16;
+  out.y = (r * sinQ16(angles.base)) >> 16;
+  out.z = z;
+}
@@ -0,0 +1,234 @@
+#include "Log.h"
+#include <atomic>
+#include <stdarg.h>
+
+static_assert((LOG_RING_SIZE & (LOG_RING_SIZE - 1)) == 0, "LOG_RING_SIZE must be a power of two");
+
+static const uint32_t drainStackSize = 3072;
+static const UBaseType_t drainPriority = 1;
+static const BaseType_t drainCore = 0;
+// The ring holds LOG_RING_SIZE records per pass, a few thousand a second
+static const TickType_t drainIdleTicks = pdMS_TO_TICKS(10);
+
+// Bounded multi-producer ring (Vyukov): each slot carries a sequence
+// number saying whose turn it is, so producers on either core claim slots
+// with one compare-and-swap and never wait for each other. There is a
+// single consumer, the drain task.
+class LogRing {
+public:
+  LogRing() : enqueuePos(0), dequeuePos(0) {
+    for (size_t i = 0; i < LOG_RING_SIZE; i++) slots[i].seq.store(i, std::memory_order_relaxed);
+  }
+
+  bool push(const LogRecord& rec) {
+    uint32_t pos = enqueuePos.load(std::memory_order_relaxed);
+    Slot* slot;
+    for (;;) {
+      slot = &slots[pos & (LOG_RING_SIZE - 1)];
+      int32_t diff = (int32_t)(slot->seq.load(std::memory_order_acquire) - pos);
+      if (diff == 0) {
+        if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+      } else if (diff < 0) {
+        return false; // Full
+      } else {
+        pos = enqueuePos.load(std::memory_order_relaxed);
+      }
+    }
+    slot->rec = rec;
+    slot->seq.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool pop(LogRecord& rec) {
+    Slot& slot = slots[dequeuePos & (LOG_RING_SIZE - 1)];
+    if (slot.seq.load(std::memory_order_acquire) != dequeuePos + 1) return false;
+    rec = slot.rec;
+    slot.seq.store(dequeuePos + LOG_RING_SIZE, std::memory_order_release);
+    dequeuePos++;
+    return true;
+  }
+
+private:
+  struct Slot {
+    std::atomic<uint32_t> seq;
+    LogRecord rec;
+  };
+  Slot slots[LOG_RING_SIZE];
+  std::atomic<uint32_t> enqueuePos;
+  uint32_t dequeuePos; // Drain task only
+};
+
+static LogRing ring;
+static std::atomic<uint32_t> written(0);
+static std::atomic<uint32_t> dropped(0);
+static std::atomic<uint32_t> rateLimited(0);
+static volatile LogLevel minLevel = (LogLevel)MEARM_LOG_LEVEL;
+static volatile LogSink sink = nullptr;
+
+static const char levelLetters[] = {'D', 'I', 'W', 'E'};
+
+void logSetLevel(LogLevel level) {
+  minLevel = level;
+}
+
+void logSetSink(LogSink newSink) {
+  sink = newSink;
+}
+
+uint32_t logRecordsWritten() {
+  return written.load(std::memory_order_relaxed);
+}
+
+uint32_t logRecordsDropped() {
+  return dropped.load(std::memory_order_relaxed);
+}
+
+uint32_t logRecordsRateLimited() {
+  return rateLimited.load(std::memory_order_relaxed);
+}
+
+// The window update races between tasks sharing a call site; at worst a
+// few extra records get through
+bool logAdmit(LogSite& site, LogLevel level, uint32_t nowMs) {
+  if (level < minLevel) return false;
+  if (nowMs - site.windowStartMs >= 1000) {
+    site.windowStartMs = nowMs;
+    site.count = 0;
+  }
+  if (site.count >= LOG_SITE_RATE) {
+    rateLimited.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  site.count++;
+  return true;
+}
+
+void logPush(const LogRecord& rec) {
+  if (!ring.push(rec)) dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Strings that don't fit in what's left of the record are cut short
+void logArg(LogRecord& rec, const char* s) {
+  uint8_t offset = rec.textUsed;
+  size_t room = LOG_TEXT_SIZE - offset;
+  if (room == 0) {
+    offset = LOG_TEXT_SIZE - 1; // Points at the terminator of the last string
+  } else {
+    size_t n = s ? strnlen(s, room - 1) : 0;
+    if (n) memcpy(rec.text + offset, s, n);
+    rec.text[offset + n] = '\0';
+    rec.textUsed = offset + n + 1;
+  }
+  logPackArg(rec, LOG_ARG_STR, offset);
+}
+
+// Appends printf-style output, keeping `used` within the buffer
+static void appendf(char* out, size_t len, size_t& used, const char* fmt, ...) {
+  if (used + 1 >= len) return;
+  va_list ap;
+  va_start(ap, fmt);
+  int n = vsnprintf(out + used, len - used, fmt, ap);
+  va_end(ap);
+  if (n > 0) used += ((size_t)n < len - used) ? (size_t)n : len - used - 1;
+}
+
+size_t logFormat(const LogRecord& rec, char* out, size_t len) {
+  size_t used = 0;
+  out[0] = '\0';
+  appendf(out, len, used, "[%6u.%03u] %c ", (unsigned)(rec.timeMs / 1000), (unsigned)(rec.timeMs % 1000),
+          levelLetters[rec.level & 3]);
+
+  uint8_t arg = 0;
+  const char* p = rec.fmt;
+  while (*p && used + 1 < len) {
+    if (*p != '%') {
+      out[used++] = *p++;
+      continue;
+    }
+    if (p[1] == '%') {
+      out[used++] = '%';
+      p += 2;
+      continue;
+    }
+
+    // One conversion: copy flags, width and precision, drop length modifiers
+    char spec[16];
+    size_t s = 0;
+    spec[s++] = *p++;
+    while (*p && strchr("-+ #0123456789.", *p) && s < sizeof(spec) - 3) spec[s++] = *p++;
+    while (*p && strchr("hlLqjzt", *p)) p++;
+    char conv = *p ? *p++ : 's';
+
+    if (arg >= rec.argCount) {
+      appendf(out, len, used, "?");
+      continue;
+    }
+    LogArgType type = (LogArgType)((rec.argTypes >> (2 * arg)) & 3);
+    uint32_t value = rec.args[arg++];
+    float f;
+    memcpy(&f, &value, sizeof(f));
+
+    if (strchr("fFeEgG", conv)) {
+      spec[s++] = conv;
+      spec[s] = '\0';
+      double d = type == LOG_ARG_FLOAT ? f : (type == LOG_ARG_INT ? (double)(int32_t)value : (double)value);
+      appendf(out, len, used, spec, d);
+    } else if (conv == 's' || type == LOG_ARG_STR) {
+      spec[s++] = 's';
+      spec[s] = '\0';
+      appendf(out, len, used, spec, type == LOG_ARG_STR ? rec.text + value : "?");
+    } else {
+      spec[s++] = strchr("diouxXc", conv) ? conv : 'd';
+      spec[s] = '\0';
+      if (type == LOG_ARG_FLOAT) value = (uint32_t)(int32_t)f;
+      appendf(out, len, used, spec, value);
+    }
+  }
+  if (used + 1 >= len) used = len - 2;
+  out[used++] = '\n';
+  out[used] = '\0';
+  return used;
+}
+
+static void writeLine(const char* line, size_t len) {
+  LogSink current = sink;
+  if (current) {
+    current(line, len);
+  } else {
+    Serial.write((const uint8_t*)line, len);
+  }
+}
+
+// Drain task state
+static uint32_t reportedDrops = 0;
+static uint32_t reportedLimited = 0;
+
+void logFlush() {
+  char line[160];
+  LogRecord rec;
+  while (ring.pop(rec)) {
+    writeLine(line, logFormat(rec, line, sizeof(line)));
+    written.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  uint32_t drops = logRecordsDropped();
+  uint32_t limited = logRecordsRateLimited();
+  if (drops != reportedDrops || limited != reportedLimited) {
+    int n = snprintf(line, sizeof(line), "[log] %u dropped (ring full), %u rate limited\n",
+                     (unsigned)(drops - reportedDrops), (unsigned)(limited - reportedLimited));
+    writeLine(line, n);
+    reportedDrops = drops;
+    reportedLimited = limited;
+  }
+}
+
+static void drainTask(void*) {
+  for (;;) {
+    logFlush();
+    vTaskDelay(drainIdleTicks);
+  }
+}
+
+void logBegin() {
+  xTaskCreatePinnedToCore(drainTask, "log", drainStackSize, nullptr, drainPriority, nullptr, drainCore);
+}
@@ -0,0 +1,123 @@
+#include "Metrics.h"
+#include <stdarg.h>
+
+// Roughly 1-2.5-5 per decade, from a fast handler up to a stalled one
+const uint32_t LatencyHistogram::BOUNDS_US[BUCKETS - 1] = {
+    100, 250, 500, 1000, 2500, 5000, 10000, 25000, 100000};
+
+LatencyHistogram::LatencyHistogram() : total(0), sum(0), largest(0) {
+  for (uint8_t i = 0; i < BUCKETS; i++) counts[i] = 0;
+}
+
+void LatencyHistogram::observe(uint32_t us) {
+  uint8_t bucket = 0;
+  while (bucket < BUCKETS - 1 && us > BOUNDS_US[bucket]) bucket++;
+  counts[bucket]++;
+  total++;
+  sum += us;
+  if (us > largest) largest = us;
+}
+
+float RateMeter::sample(uint32_t total, uint32_t nowMs) {
+  uint32_t elapsedMs = nowMs - lastMs;
+  if (started && elapsedMs > 0) {
+    rate = (total - lastTotal) * 1000.0f / elapsedMs;
+  }
+  lastTotal = total;
+  lastMs = nowMs;
+  started = true;
+  return rate;
+}
+
+// --- MetricsWriter ---
+void MetricsWriter::printf(const char* fmt, ...) {
+  char line[200];
+  va_list args;
+  va_start(args, fmt);
+  int n = vsnprintf(line, sizeof(line), fmt, args);
+  va_end(args);
+  if (n <= 0) return;
+  if ((size_t)n >= sizeof(line)) n = sizeof(line) - 1;
+
+  if (used + n > sizeof(buf)) flush();
+  memcpy(buf + used, line, n);
+  used += n;
+}
+
+void MetricsWriter::flush() {
+  if (used == 0) return;
+  flushFn(buf, used, ctx);
+  used = 0;
+}
+
+void MetricsWriter::gauge(const char* name, const char* help, float value) {
+  printf("# HELP %s %s\n", name, help);
+  printf("# TYPE %s gauge\n%s %.10g\n", name, name, value);
+}
+
+void MetricsWriter::counter(const char* name, const char* help, uint32_t value) {
+  printf("# HELP %s %s\n", name, help);
+  printf("# TYPE %s counter\n%s %u\n", name, name, (unsigned)value);
+}
+
+void MetricsWriter::histogram(const char* name, const char* help, const char* labels,
+                              const LatencyHistogram& hist, bool writeHeader) {
+  if (writeHeader) {
+    printf("# HELP %s %s\n", name, help);
+    printf("# TYPE %s histogram\n", name);
+  }
+  const char* sep = labels ? "," : "";
+  if (!labels) labels = "";
+
+  uint32_t cumulative = 0;
+  for (uint8_t i = 0; i < LatencyHistogram::BUCKETS - 1; i++) {
+    cumulative += hist.bucketCount(i);
+    printf("%s_bucket{%s%sle=\"%u\"} %u\n", name, labels, sep,
+           (unsigned)LatencyHistogram::BOUNDS_US[i], (unsigned)cumulative);
+  }
+  // Summed from the buckets so the series stays monotonic even if the
+  // writer is mid-observe()
+  cumulative += hist.bucketCount(LatencyHistogram::BUCKETS - 1);
+  printf("%s_bucket{%s%sle=\"+Inf\"} %u\n", name, labels, sep, (unsigned)cumulative);
+  const char* open = *labels ? "{" : "";
+  const char* close = *labels ? "}" : "";
+  printf("%s_sum%s%s%s %llu\n", name, open, labels, close, (unsigned long long)hist.sumUs());
+  printf("%s_count%s%s%s %u\n", name, open, labels, close, (unsigned)cumulative);
+}
+// --- End MetricsWriter ---
+
+Metrics::Metrics() : routeCount(0), lastLoopUs(0), loopStarted(false) {}
+
+int Metrics::addRoute(const char* path) {
+  if (routeCount >= MAX_ROUTES) return -1;
+  routePaths[routeCount] = path;
+  return routeCount++;
+}
+
+void Metrics::observeRoute(int id, uint32_t us) {
+  if (id < 0 || id >= routeCount) return;
+  routeLatency[id].observe(us);
+}
+
+void Metrics::loopPass(uint32_t nowUs) {
+  if (loopStarted) {
+    loopPeriod.observe(nowUs - lastLoopUs);
+  }
+  lastLoopUs = nowUs;
+  loopStarted = true;
+}
+
+void Metrics::write(MetricsWriter& out) const {
+  char labels[48];
+  for (uint8_t i = 0; i < routeCount; i++) {
+    snprintf(labels, sizeof(labels), "route=\"%s\"", routePaths[i]);
+    out.histogram("mearm_http_handler_duration_microseconds",
+                  "Time spent in each route's handler. The reply is only queued here; AsyncTCP sends it afterwards.",
+                  labels, routeLatency[i], i == 0);
+  }
+
+  out.histogram("mearm_network_loop_period_microseconds",
+                "Time between passes of the network task's loop.", nullptr, loopPeriod);
+  out.gauge("mearm_network_loop_period_max_microseconds",
+            "Longest gap between network loop passes since boot.", loopPeriod.maxUs());
+}
@@ -0,0 +1,169 @@
+#include "Mirror.h"
+
+static void putU32(uint8_t* p, uint32_t v) {
+  for (uint8_t i = 0; i < 4; i++) p[i] = v >> (8 * i);
+}
+
+static uint32_t getU32(const uint8_t* p) {
+  return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+Mirror::Mirror(uint16_t rateHz)
+    : currentMode(MIRROR_OFF), lastDueUs(0), ownId(0), nextSeq(0), offsetBase(0), windowMin(0), previousMin(0),
+      windowStartUs(0), sent(0), accepted(0), stale(0), lost(0), invalid(0), extrapolated(0), jitterUs(0) {
+  setRate(rateHz);
+  resetFollower();
+}
+
+void Mirror::setRate(uint16_t rate) {
+  rateHz = constrain(rate, 1, 100);
+  intervalUs = 1000000UL / rateHz;
+}
+
+void Mirror::setMode(MirrorMode mode, uint32_t leaderId) {
+  currentMode = mode;
+  ownId = leaderId;
+  resetFollower();
+}
+
+void Mirror::resetFollower() {
+  haveLeader = false;
+  leaderId = 0;
+  newestSeq = 0;
+  lastHeardUs = 0;
+  leaderEnabled = 0;
+  leaderPeriodUs = intervalUs;
+  oldest = 0;
+  count = 0;
+}
+
+bool Mirror::due(uint32_t nowUs) {
+  if (currentMode == MIRROR_OFF || nowUs - lastDueUs < intervalUs) return false;
+  // Keep the cadence, unless we fell more than a period behind
+  lastDueUs = nowUs - lastDueUs < 2 * intervalUs ? lastDueUs + intervalUs : nowUs;
+  return true;
+}
+
+size_t Mirror::encode(const int positions[JOINT_COUNT], uint8_t enabled, uint32_t nowUs, uint8_t* out) {
+  out[0] = 'M';
+  out[1] = 'R';
+  out[2] = MIRROR_VERSION;
+  out[3] = enabled;
+  putU32(out + 4, ownId);
+  putU32(out + 8, nextSeq++);
+  putU32(out + 12, nowUs);
+  for (uint8_t j = 0; j < JOINT_COUNT; j++) {
+    out[16 + j] = constrain(positions[j], 0, 180);
+  }
+  sent++;
+  return MIRROR_PACKET_SIZE;
+}
+
+bool Mirror::receive(const uint8_t* data, size_t len, uint32_t nowUs) {
+  if (currentMode != MIRROR_FOLLOWER) return false;
+  if (len != MIRROR_PACKET_SIZE || data[0] != 'M' || data[1] != 'R' || data[2] != MIRROR_VERSION) {
+    invalid++;
+    return false;
+  }
+  uint32_t id = getU32(data + 4);
+  uint32_t seq = getU32(data + 8);
+  uint32_t stamp = getU32(data + 12);
+
+  if (haveLeader && nowUs - lastHeardUs >= LEADER_TIMEOUT_US) {
+    resetFollower(); // Gone quiet: start over with whoever speaks next
+  }
+  if (haveLeader && id != leaderId) {
+    invalid++; // A second leader; ours is still talking
+    return false;
+  }
+  if (!haveLeader) {
+    haveLeader = true;
+    leaderId = id;
+    newestSeq = seq - 1;
+    offsetBase = nowUs - stamp;
+    windowMin = INT32_MAX;
+    previousMin = INT32_MAX;
+    windowStartUs = nowUs;
+  }
+
+  // Serial number arithmetic so the counter can wrap
+  if ((int32_t)(seq - newestSeq) <= 0) {
+    stale++;
+    return false;
+  }
+  // The leader's own rate sets the playout delay, whatever ours is
+  if (seq == newestSeq + 1 && count) {
+    leaderPeriodUs = constrain(stamp - sample(count - 1).timeUs, 1000UL, 1000000UL);
+  }
+  lost += seq - newestSeq - 1;
+  newestSeq = seq;
+  lastHeardUs = nowUs;
+  leaderEnabled = data[3];
+
+  // The fastest packet in the last two windows stands for the clock offset
+  // plus the minimum network delay; anything slower arrived late by the
+  // difference
+  int32_t delay = (int32_t)((nowUs - stamp) - offsetBase);
+  if (nowUs - windowStartUs >= OFFSET_WINDOW_US) {
+    previousMin = windowMin;
+    windowMin = INT32_MAX;
+    windowStartUs = nowUs;
+  }
+  if (delay < windowMin) windowMin = delay;
+  int32_t fastest = windowMin < previousMin ? windowMin : previousMin;
+  jitterUs = delay - fastest;
+
+  if (count == HISTORY) {
+    oldest = (oldest + 1) % HISTORY;
+    count--;
+  }
+  Sample& s = history[(oldest + count) % HISTORY];
+  s.timeUs = stamp;
+  memcpy(s.pos, data + 16, JOINT_COUNT);
+  count++;
+  accepted++;
+  return true;
+}
+
+bool Mirror::target(uint32_t nowUs, int out[JOINT_COUNT], uint8_t& enabled) {
+  if (currentMode != MIRROR_FOLLOWER || !haveLeader) return false;
+  if (nowUs - lastHeardUs >= LEADER_TIMEOUT_US) {
+    resetFollower();
+    return false;
+  }
+
+  // The point on the leader's timeline to be at one period from now
+  int32_t fastest = windowMin < previousMin ? windowMin : previousMin;
+  uint32_t renderUs = nowUs + intervalUs - (offsetBase + fastest) - playoutUs();
+
+  // Between samples a and b, at fraction f (beyond b when extrapolating)
+  uint8_t a = 0;
+  uint8_t b = 0;
+  float f = 0;
+  const Sample& newest = sample(count - 1);
+  int32_t ahead = (int32_t)(renderUs - newest.timeUs);
+  if (count >= 2 && ahead > 0) {
+    a = count - 2;
+    b = count - 1;
+    uint32_t span = newest.timeUs - sample(a).timeUs;
+    uint32_t over = (uint32_t)ahead < MAX_EXTRAPOLATE_US ? ahead : MAX_EXTRAPOLATE_US;
+    f = span ? 1 + (float)over / span : 1;
+    extrapolated++;
+  } else if (count >= 2 && (int32_t)(renderUs - sample(0).timeUs) > 0) {
+    b = 1;
+    while ((int32_t)(renderUs - sample(b).timeUs) > 0) b++;
+    a = b - 1;
+    uint32_t span = sample(b).timeUs - sample(a).timeUs;
+    f = span ? (float)(renderUs - sample(a).timeUs) / span : 1;
+  } else {
+    a = b = 0; // One sample, or before the oldest
+  }
+
+  for (uint8_t j = 0; j < JOINT_COUNT; j++) {
+    float from = sample(a).pos[j];
+    float to = sample(b).pos[j];
+    out[j] = constrain((int)lroundf(from + (to - from) * f), 0, 180);
+  }
+  enabled = leaderEnabled;
+  return true;
+}
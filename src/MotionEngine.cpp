@@ -0,0 +1,311 @@
+#include "MotionEngine.h"
+#include "BlendPath.h"
+#include "ServoDriver.h"
+
+MotionEngine::MotionEngine()
+    : driver(nullptr), segmentTime(0), path(nullptr), jogGuard(nullptr), jogTimeLeft(0), lastTickUs(0), started(false),
+      ticks(0), servoWrites(0) {
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+    joints[i].position = 90;
+    joints[i].target = 90;
+    joints[i].speed = 0;
+    joints[i].maxSpeed = 100;
+    joints[i].maxAccel = 600;
+    joints[i].inSegment = false;
+    joints[i].segmentStart = 90;
+    joints[i].jogging = false;
+    joints[i].jogCommand = 0;
+    joints[i].velocity = 0;
+  }
+}
+
+void MotionEngine::setDriver(ServoDriver* newDriver) {
+  driver = newDriver;
+}
+
+void MotionEngine::setStartPosition(JointId joint, int position) {
+  Joint& j = joints[joint];
+  j.position = constrain(position, 0, 180);
+  j.target = j.position;
+  j.inSegment = false;
+  stopJog(j);
+}
+
+void MotionEngine::setEnabled(JointId joint, bool enabled) {
+  if (!enabled) stopJog(joints[joint]); // Limp joints don't move
+  if (driver == nullptr) return;
+  driver->setEnabled(joint, enabled);
+  if (enabled) {
+    // Start pulsing at the current position rather than waiting for a move
+    driver->stage(joint, joints[joint].position);
+    driver->commit();
+  }
+}
+
+void MotionEngine::setTarget(JointId joint, int target, float speedDegPerSec) {
+  Joint& j = joints[joint];
+  if (path) stopPath();
+  j.target = constrain(target, 0, 180);
+  j.speed = speedDegPerSec;
+  j.inSegment = false;
+  stopJog(j);
+}
+
+void MotionEngine::hold(JointId joint) {
+  if (path) stopPath();
+  joints[joint].target = joints[joint].position;
+  joints[joint].inSegment = false;
+  stopJog(joints[joint]);
+}
+
+void MotionEngine::setLimits(JointId joint, float maxSpeedDegPerSec, float maxAccelDegPerSec2) {
+  joints[joint].maxSpeed = maxSpeedDegPerSec;
+  joints[joint].maxAccel = maxAccelDegPerSec2;
+}
+
+float MotionEngine::moveTo(const int targets[JOINT_COUNT], float speedScale) {
+  // One profile over a unit distance, within every joint's limits once
+  // scaled to that joint's distance, so the joints move in proportion:
+  // they arrive together and the pose follows a straight line in joint
+  // space, which is what the collision envelope check walks
+  path = nullptr;
+  float vUnit = 0, aUnit = 0;
+  bool moving = false;
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+    Joint& j = joints[i];
+    j.target = constrain(targets[i], 0, 180);
+    j.segmentStart = j.position;
+    stopJog(j);
+    float d = fabsf(j.target - j.position);
+    if (d == 0) continue;
+    float v = j.maxSpeed * speedScale / d;
+    float a = j.maxAccel * speedScale * speedScale / d;
+    if (!moving || v < vUnit) vUnit = v;
+    if (!moving || a < aUnit) aUnit = a;
+    moving = true;
+  }
+  TrapezoidProfile unit;
+  unit.plan(moving ? 1 : 0, vUnit, aUnit);
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+    joints[i].profile = unit.scaled(joints[i].target - joints[i].position);
+    joints[i].inSegment = true;
+  }
+  segmentTime = 0;
+  return unit.duration;
+}
+
+float MotionEngine::followPath(BlendPath& newPath) {
+  float start[JOINT_COUNT], maxSpeed[JOINT_COUNT], maxAccel[JOINT_COUNT], end[JOINT_COUNT];
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+    start[i] = joints[i].position;
+    maxSpeed[i] = joints[i].maxSpeed;
+    maxAccel[i] = joints[i].maxAccel;
+  }
+  float duration = newPath.plan(start, maxSpeed, maxAccel);
+  newPath.end(end);
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+    joints[i].target = end[i];
+    joints[i].inSegment = false;
+    stopJog(joints[i]);
+  }
+  path = &newPath;
+  segmentTime = 0;
+  return duration;
+}
+
+// Leaves every joint where the path has got it to
+void MotionEngine::stopPath() {
+  path = nullptr;
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+    joints[i].target = joints[i].position;
+  }
+}
+
+void MotionEngine::stopJog(Joint& j) {
+  j.jogging = false;
+  j.jogCommand = 0;
+  j.velocity = 0;
+}
+
+void MotionEngine::jog(const float velocities[JOINT_COUNT], float deadmanSec) {
+  bool moving = false;
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+    if (velocities[i] != 0) moving = true;
+  }
+  if (path && moving) stopPath();
+
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+    Joint& j = joints[i];
+    if (velocities[i] == 0) {
+      j.jogCommand = 0; // A jogging joint ramps down; others carry on
+      continue;
+    }
+    if (!j.jogging) {
+      j.jogging = true;
+      j.velocity = 0;
+      j.inSegment = false;
+    }
+    j.jogCommand = constrain(velocities[i], -j.maxSpeed, j.maxSpeed);
+  }
+  jogTimeLeft = deadmanSec;
+}
+
+void MotionEngine::setJogGuard(JogGuard guard) {
+  jogGuard = guard;
+}
+
+// Moves `v` towards `want` by at most `step`
+static float approach(float v, float want, float step) {
+  if (want > v) return v + step < want ? v + step : want;
+  return v - step > want ? v - step : want;
+}
+
+// One tick of velocity mode. Each jogging joint ramps towards its command,
+// no faster than lets it stop by 0 or 180 degrees. If the guard rejects
+// the pose one tick on, or the pose all the jogging joints would come to
+// rest in from there, they all brake instead; the rest pose from the tick
+// before was accepted, so braking normally stays inside.
+void MotionEngine::stepJog(float dtSec) {
+  if (jogTimeLeft > 0) {
+    jogTimeLeft -= dtSec;
+    if (jogTimeLeft <= 0) {
+      for (uint8_t i = 0; i < JOINT_COUNT; i++) joints[i].jogCommand = 0;
+    }
+  }
+
+  float v[JOINT_COUNT], next[JOINT_COUNT], rest[JOINT_COUNT];
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+    Joint& j = joints[i];
+    v[i] = 0;
+    next[i] = rest[i] = j.position;
+    if (!j.jogging) continue;
+    // Stepping a tick at a time, braking from v covers v^2/2a + v*dt/2
+    float room = j.jogCommand > 0 ? 180 - j.position : j.position;
+    float half = j.maxAccel * dtSec / 2;
+    float reachable = sqrtf(half * half + 2 * j.maxAccel * (room > 0 ? room : 0)) - half;
+    v[i] = approach(j.velocity, constrain(j.jogCommand, -reachable, reachable), j.maxAccel * dtSec);
+    next[i] = constrain(j.position + v[i] * dtSec, 0.0f, 180.0f);
+    rest[i] = constrain(next[i] + v[i] * fabsf(v[i]) / (2 * j.maxAccel), 0.0f, 180.0f);
+  }
+
+  if (jogGuard && !(jogGuard(next) && jogGuard(rest))) {
+    for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+      Joint& j = joints[i];
+      if (!j.jogging) continue;
+      v[i] = approach(j.velocity, 0, j.maxAccel * dtSec);
+      next[i] = constrain(j.position + v[i] * dtSec, 0.0f, 180.0f);
+    }
+    if (!jogGuard(next)) {
+      // Braking curves aren't straight lines, so a slide along a jagged
+      // edge can still clip a corner; or we started outside. Stop dead.
+      for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+        v[i] = 0;
+        next[i] = joints[i].position;
+      }
+    }
+  }
+
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+    Joint& j = joints[i];
+    if (!j.jogging) continue;
+    j.position = next[i];
+    j.target = next[i];
+    j.velocity = v[i];
+    if (v[i] == 0 && j.jogCommand == 0) j.jogging = false;
+  }
+}
+
+bool MotionEngine::update(uint32_t nowUs) {
+  if (!started) {
+    started = true;
+    lastTickUs = nowUs;
+    return false;
+  }
+
+  uint32_t elapsed = nowUs - lastTickUs;
+  if (elapsed < TICK_INTERVAL_US) {
+    return false;
+  }
+
+  uint32_t due = elapsed / TICK_INTERVAL_US;
+  if (due > MAX_CATCH_UP_TICKS) {
+    // We were starved for a long time (e.g. Wi-Fi work); don't jump the arm,
+    // just carry on from now.
+    due = 1;
+    lastTickUs = nowUs;
+  } else {
+    lastTickUs += due * TICK_INTERVAL_US;
+  }
+
+  const float dt = TICK_INTERVAL_US / 1000000.0f;
+  while (due--) {
+    tick(dt);
+  }
+  return true;
+}
+
+void MotionEngine::tick(float dtSec) {
+  ticks++;
+  segmentTime += dtSec;
+  if (path) {
+    float q[JOINT_COUNT];
+    path->positionAt(segmentTime, q);
+    if (segmentTime >= path->duration()) path = nullptr; // q is the end point
+    for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+      joints[i].position = q[i];
+    }
+    writeOutputs();
+    return;
+  }
+  stepJog(dtSec);
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+    Joint& j = joints[i];
+    if (j.jogging) continue;
+    if (j.inSegment) {
+      if (segmentTime >= j.profile.duration) {
+        j.position = j.target;
+        j.inSegment = false;
+      } else {
+        j.position = j.segmentStart + j.profile.positionAt(segmentTime);
+      }
+    } else if (j.position != j.target) {
+      float maxStep = j.speed * dtSec;
+      float delta = j.target - j.position;
+      if (maxStep <= 0 || fabsf(delta) <= maxStep) {
+        j.position = j.target;
+      } else {
+        j.position += (delta > 0) ? maxStep : -maxStep;
+      }
+    }
+  }
+  writeOutputs();
+}
+
+// Stages every joint, then latches them together
+void MotionEngine::writeOutputs() {
+  if (driver == nullptr) return;
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+    if (driver->stage((JointId)i, joints[i].position)) servoWrites++;
+  }
+  driver->commit();
+}
+
+int MotionEngine::position(JointId joint) const {
+  return (int)lroundf(joints[joint].position);
+}
+
+int MotionEngine::target(JointId joint) const {
+  return (int)lroundf(joints[joint].target);
+}
+
+bool MotionEngine::isMoving(JointId joint) const {
+  if (path) return true;
+  return joints[joint].inSegment || joints[joint].jogging || joints[joint].position != joints[joint].target;
+}
+
+bool MotionEngine::isIdle() const {
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+    if (isMoving((JointId)i)) return false;
+  }
+  return true;
+}
@@ -0,0 +1,216 @@
+#include "MotionProgram.h"
+#include "Envelope.h"
+
+// Joint letters, in JointId order
+static const char jointLetters[JOINT_COUNT] = {'B', 'S', 'E', 'C'};
+
+static int jointForLetter(char letter) {
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+    if (jointLetters[i] == letter) return i;
+  }
+  return -1;
+}
+
+// A number as G-code writes it: optional sign, digits, optional fraction.
+// No exponent, so a joint letter right after a number (G1 S100E60) starts
+// the next word. Returns the end of the number, or nullptr if there is none.
+static const char* scanNumber(const char* p, float& value) {
+  bool negative = *p == '-';
+  if (*p == '-' || *p == '+') p++;
+  bool digits = false;
+  float v = 0;
+  while (isdigit((unsigned char)*p)) {
+    v = v * 10 + (*p++ - '0');
+    digits = true;
+  }
+  if (*p == '.') {
+    p++;
+    float scale = 0.1f;
+    while (isdigit((unsigned char)*p)) {
+      v += (*p++ - '0') * scale;
+      scale *= 0.1f;
+      digits = true;
+    }
+  }
+  if (!digits) return nullptr;
+  value = negative ? -v : v;
+  return p;
+}
+
+bool MotionProgram::parse(const char* text, const int start[JOINT_COUNT], ProgramError& error) {
+  count = 0;
+  int16_t last[JOINT_COUNT];
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) last[i] = constrain(start[i], 0, 180);
+  float feed = 0;
+  int motionMode = 1; // G0 or G1, modal
+
+  error.line = 0;
+  error.message = nullptr;
+  const char* p = text;
+  while (*p) {
+    error.line++;
+    int code = -1;              // G word on this line, if any
+    bool haveAxis = false;
+    long dwell = -1;
+    int16_t targets[JOINT_COUNT];
+    memcpy(targets, last, sizeof(targets));
+    float lineFeed = feed;
+
+    // One line, word by word
+    while (*p && *p != '\n') {
+      char c = toupper((unsigned char)*p);
+      if (c == ';') {
+        while (*p && *p != '\n') p++;
+        break;
+      }
+      if (c == ' ' || c == '\t' || c == '\r') {
+        p++;
+        continue;
+      }
+
+      float value;
+      const char* end = isalpha((unsigned char)c) ? scanNumber(p + 1, value) : nullptr;
+      if (!end) {
+        error.message = "Expected a letter followed by a number";
+        return false;
+      }
+      if (!isfinite(value)) { // Dozens of digits overflow the float
+        error.message = "Number out of range";
+        return false;
+      }
+      p = end;
+
+      int joint = jointForLetter(c);
+      if (c == 'G') {
+        code = (int)value;
+        if (value != code || (code != 0 && code != 1 && code != 4)) {
+          error.message = "Only G0, G1 and G4 are supported";
+          return false;
+        }
+      } else if (joint >= 0) {
+        if (value < 0 || value > 180) {
+          error.message = "Joint angle out of range (0-180)";
+          return false;
+        }
+        targets[joint] = (int16_t)lroundf(value);
+        haveAxis = true;
+      } else if (c == 'F') {
+        if (value <= 0) {
+          error.message = "F must be positive";
+          return false;
+        }
+        lineFeed = value;
+      } else if (c == 'P') {
+        if (value < 0 || value > 60000) {
+          error.message = "P must be 0-60000 ms";
+          return false;
+        }
+        dwell = lroundf(value);
+      } else {
+        error.message = "Unknown word";
+        return false;
+      }
+    }
+    if (*p == '\n') p++;
+
+    if (code == 4) {
+      if (haveAxis) {
+        error.message = "G4 takes no joint angles";
+        return false;
+      }
+      if (count > 0) { // A dwell before the first move has nothing to hold
+        ProgramBlock& held = blocks[count - 1];
+        // Consecutive G4s add up, within the same limit as one
+        if (dwell > 0 && held.dwellMs + dwell > 60000) {
+          error.message = "Dwell adds up to more than 60000 ms";
+          return false;
+        }
+        held.stop = true;
+        held.dwellMs += dwell > 0 ? dwell : 0;
+      }
+      continue;
+    }
+    if (code == 0 || code == 1) motionMode = code;
+    feed = lineFeed;
+    if (!haveAxis) continue; // Blank line, comment, or a bare G/F word
+
+    if (!envelopeAllows(targets[JOINT_SHOULDER], targets[JOINT_ELBOW])) {
+      error.message = "Shoulder/elbow pose would hit the table or base";
+      return false;
+    }
+    // Each move runs straight in joint space, apart from its rounded corners
+    // (checkPath). From a pose already outside, only the end counts.
+    if (envelopeAllows(last[JOINT_SHOULDER], last[JOINT_ELBOW]) &&
+        !envelopeAllowsLine(last[JOINT_SHOULDER], last[JOINT_ELBOW], targets[JOINT_SHOULDER], targets[JOINT_ELBOW])) {
+      error.message = "Move would pass through the table or base";
+      return false;
+    }
+    if (count >= MAX_BLOCKS) {
+      error.message = "Too many moves";
+      return false;
+    }
+    ProgramBlock& block = blocks[count++];
+    memcpy(block.targets, targets, sizeof(targets));
+    block.speed = motionMode == 0 ? 0 : feed;
+    block.dwellMs = 0;
+    block.stop = false;
+    block.line = error.line;
+    memcpy(last, targets, sizeof(last));
+  }
+  return true;
+}
+
+bool MotionProgram::checkPath(const float start[JOINT_COUNT], const float maxSpeed[JOINT_COUNT],
+                              const float maxAccel[JOINT_COUNT], BlendPath& scratch, ProgramError& error) const {
+  float fastest = 0;
+  for (uint8_t j = 0; j < JOINT_COUNT; j++) {
+    if (maxSpeed[j] > fastest) fastest = maxSpeed[j];
+  }
+  if (fastest <= 0) return true;
+  const float dt = 0.25f / fastest;
+
+  float from[JOINT_COUNT];
+  memcpy(from, start, sizeof(from));
+  bool inside = envelopeAllows(lroundf(from[JOINT_SHOULDER]), lroundf(from[JOINT_ELBOW]));
+  uint8_t first = 0;
+  while (first < count) {
+    // One run, up to and including the next stop, as MotionTask::stepProgram plans it
+    scratch.clear();
+    uint8_t last = first;
+    for (; last < count; last++) {
+      scratch.addPoint(blocks[last].targets, blocks[last].speed);
+      if (blocks[last].stop) break;
+    }
+    if (last == count) last--;
+    float duration = scratch.plan(from, maxSpeed, maxAccel);
+
+    float q[JOINT_COUNT];
+    for (float t = 0; t < duration + dt; t += dt) {
+      scratch.positionAt(t, q);
+      bool allowed = envelopeAllows(lroundf(q[JOINT_SHOULDER]), lroundf(q[JOINT_ELBOW]));
+      if (!inside) { // Started outside: only checked once it gets in
+        inside = allowed;
+        continue;
+      }
+      if (allowed) continue;
+
+      // Blame the waypoint nearest to where it goes out
+      uint8_t nearest = first;
+      float best = -1;
+      for (uint8_t b = first; b <= last; b++) {
+        float ds = blocks[b].targets[JOINT_SHOULDER] - q[JOINT_SHOULDER];
+        float de = blocks[b].targets[JOINT_ELBOW] - q[JOINT_ELBOW];
+        if (best < 0 || ds * ds + de * de < best) {
+          best = ds * ds + de * de;
+          nearest = b;
+        }
+      }
+      error.line = blocks[nearest].line;
+      error.message = "Path near this move would hit the table or base";
+      return false;
+    }
+    scratch.end(from);
+    first = last + 1;
+  }
+  return true;
+}
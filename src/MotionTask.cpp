@@ -0,0 +1,243 @@
+#include "MotionTask.h"
+
+void MotionTask::begin() {
+  nextTickUs = micros();
+  publish();
+  xTaskCreatePinnedToCore(taskEntry, "motion", STACK_SIZE, this, PRIORITY, nullptr, CORE);
+}
+
+void MotionTask::taskEntry(void* self) {
+  static_cast<MotionTask*>(self)->run();
+}
+
+void MotionTask::run() {
+  const TickType_t period = pdMS_TO_TICKS(MotionEngine::TICK_INTERVAL_US / 1000);
+  TickType_t lastWake = xTaskGetTickCount();
+
+  for (;;) {
+    vTaskDelayUntil(&lastWake, period);
+    step(micros());
+  }
+}
+
+void MotionTask::step(uint32_t nowUs) {
+  nextTickUs += MotionEngine::TICK_INTERVAL_US;
+  uint32_t lateUs = nowUs - nextTickUs;
+  if ((int32_t)lateUs < 0) lateUs = 0; // Early wakes count as on time
+  if (lateUs > local.maxTickJitterUs) local.maxTickJitterUs = lateUs;
+#if MEARM_METRICS
+  tickJitter.observe(lateUs);
+#endif
+  if ((int32_t)(nowUs - nextTickUs) > (int32_t)MotionEngine::TICK_INTERVAL_US) {
+    nextTickUs = nowUs; // Resynced after a long stall, like the engine does
+  }
+
+  drainQueue();
+  if (programActive && eng.isIdle()) {
+    stepProgram(nowUs);
+  }
+  eng.update(nowUs);
+  publish();
+}
+
+// Applies every queued command, slotting in a requested stop after the
+// commands that were sent before it
+void MotionTask::drainQueue() {
+  bool stopPending = stopRequests.load(std::memory_order_acquire) != stopsSeen;
+  uint32_t stopAt = stopAfter.load(std::memory_order_relaxed);
+  MotionCommand cmd;
+  for (;;) {
+    if (stopPending && (int32_t)(local.commandsApplied - stopAt) >= 0) {
+      stopNow();
+      stopPending = false;
+    }
+    if (!queue.pop(cmd)) break;
+    apply(cmd);
+  }
+  if (stopPending) stopNow(); // Not reachable unless the counts disagree; stop anyway
+}
+
+void MotionTask::stopNow() {
+  stopsSeen = stopRequests.load(std::memory_order_relaxed);
+  if (programActive) endProgram();
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) eng.hold((JointId)i);
+}
+
+void MotionTask::apply(const MotionCommand& cmd) {
+  switch (cmd.type) {
+    case MOTION_SET_TARGET:
+      eng.setTarget((JointId)cmd.joint, cmd.values[0], cmd.speed);
+      break;
+    case MOTION_MOVE_TO: {
+      int targets[JOINT_COUNT];
+      for (uint8_t i = 0; i < JOINT_COUNT; i++) targets[i] = cmd.values[i];
+      eng.moveTo(targets, cmd.speed);
+      break;
+    }
+    case MOTION_HOLD:
+      eng.hold((JointId)cmd.joint);
+      break;
+    case MOTION_SET_ENABLED:
+      eng.setEnabled((JointId)cmd.joint, cmd.values[0] != 0);
+      break;
+    case MOTION_JOG: {
+      float velocities[JOINT_COUNT];
+      for (uint8_t i = 0; i < JOINT_COUNT; i++) velocities[i] = cmd.values[i] / 10.0f;
+      eng.jog(velocities, cmd.speed);
+      break;
+    }
+    case MOTION_RUN_PROGRAM:
+      programActive = true;
+      programNext = 0;
+      dwellMs = 0;
+      dwelling = false;
+      break;
+  }
+
+  local.commandsApplied++;
+  local.lastCommandLatencyUs = micros() - cmd.queuedUs;
+  if (local.lastCommandLatencyUs > local.maxCommandLatencyUs) {
+    local.maxCommandLatencyUs = local.lastCommandLatencyUs;
+  }
+}
+
+// Called whenever the engine is idle while a program runs: finishes any G4
+// dwell, then plans the moves up to the next stop as one blended path
+void MotionTask::stepProgram(uint32_t nowUs) {
+  if (dwellMs > 0) {
+    if (!dwelling) {
+      dwelling = true;
+      dwellStartUs = nowUs;
+    }
+    if (nowUs - dwellStartUs < dwellMs * 1000UL) return;
+    dwelling = false;
+    dwellMs = 0;
+  }
+
+  if (programNext >= prog.size()) {
+    endProgram();
+    return;
+  }
+  path.clear();
+  while (programNext < prog.size()) {
+    const ProgramBlock& block = prog[programNext++];
+    path.addPoint(block.targets, block.speed);
+    if (block.stop) {
+      dwellMs = block.dwellMs;
+      break;
+    }
+  }
+  eng.followPath(path);
+}
+
+void MotionTask::endProgram() {
+  programActive = false;
+  dwelling = false;
+  dwellMs = 0;
+  local.programsDone++;
+}
+
+void MotionTask::publish() {
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+    local.position[i] = eng.position((JointId)i);
+    local.target[i] = eng.target((JointId)i);
+  }
+  local.idle = eng.isIdle();
+  local.ticks = eng.tickCount();
+  local.servoWrites = eng.servoWriteCount();
+  local.programBlock = programNext;
+
+  uint32_t seq = snapshotSeq.load(std::memory_order_relaxed);
+  snapshotSeq.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  published = local;
+  std::atomic_thread_fence(std::memory_order_release);
+  snapshotSeq.store(seq + 2, std::memory_order_release);
+}
+
+void MotionTask::snapshot(MotionSnapshot& out) const {
+  for (;;) {
+    uint32_t before = snapshotSeq.load(std::memory_order_acquire);
+    if (before & 1) continue; // Mid-write on the other core; it's only a few words
+    out = published;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (snapshotSeq.load(std::memory_order_relaxed) == before) return;
+  }
+}
+
+bool MotionTask::send(MotionCommand& cmd) {
+  cmd.queuedUs = micros();
+  if (!queue.push(cmd)) return false;
+  commandsSent++;
+  size_t depth = queue.size();
+  if (depth > maxQueueDepth) maxQueueDepth = depth;
+  return true;
+}
+
+bool MotionTask::setTarget(JointId joint, int target, float speedDegPerSec) {
+  MotionCommand cmd = {MOTION_SET_TARGET, joint, {(int16_t)target}, speedDegPerSec, 0};
+  return send(cmd);
+}
+
+bool MotionTask::moveTo(const int targets[JOINT_COUNT], float speedScale) {
+  MotionCommand cmd = {MOTION_MOVE_TO, 0, {}, speedScale, 0};
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) cmd.values[i] = targets[i];
+  return send(cmd);
+}
+
+bool MotionTask::hold(JointId joint) {
+  MotionCommand cmd = {MOTION_HOLD, joint, {}, 0, 0};
+  return send(cmd);
+}
+
+bool MotionTask::setEnabled(JointId joint, bool enabled) {
+  MotionCommand cmd = {MOTION_SET_ENABLED, joint, {(int16_t)enabled}, 0, 0};
+  return send(cmd);
+}
+
+bool MotionTask::jog(const float velocities[JOINT_COUNT], float deadmanSec) {
+  MotionCommand cmd = {MOTION_JOG, 0, {}, deadmanSec, 0};
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) cmd.values[i] = (int16_t)lroundf(velocities[i] * 10);
+  return send(cmd);
+}
+
+// Plans in the motion task's own path, which is free while no program runs;
+// the limits don't change after begin()
+bool MotionTask::checkProgram(const float start[JOINT_COUNT], ProgramError& error) {
+  float maxSpeed[JOINT_COUNT], maxAccel[JOINT_COUNT];
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+    maxSpeed[i] = eng.maxSpeed((JointId)i);
+    maxAccel[i] = eng.maxAccel((JointId)i);
+  }
+  return prog.checkPath(start, maxSpeed, maxAccel, path, error);
+}
+
+bool MotionTask::runProgram() {
+  MotionCommand cmd = {MOTION_RUN_PROGRAM, 0, {}, 0, 0};
+  if (!send(cmd)) return false;
+  programsSent++;
+  return true;
+}
+
+void MotionTask::stopAll() {
+  stopAfter.store(commandsSent, std::memory_order_relaxed);
+  stopRequests.fetch_add(1, std::memory_order_release);
+}
+
+bool MotionTask::programBusy() const {
+  MotionSnapshot s;
+  snapshot(s);
+  return s.programsDone != programsSent;
+}
+
+bool MotionTask::isIdle() const {
+  MotionSnapshot s;
+  snapshot(s);
+  return s.idle && s.commandsApplied == commandsSent;
+}
+
+int MotionTask::target(JointId joint) const {
+  MotionSnapshot s;
+  snapshot(s);
+  return s.target[joint];
+}
@@ -0,0 +1,33 @@
+#include "PoseBuffer.h"
+
+PoseBuffer::PoseBuffer() : count(0), lastMs(0) {}
+
+bool PoseBuffer::append(const uint8_t joints[JOINT_COUNT], uint32_t nowMs) {
+  if (count == CAPACITY) {
+    return false;
+  }
+
+  PackedPose& p = poses[count];
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+    p.joints[i] = joints[i];
+  }
+  uint32_t dt = (count == 0) ? 0 : nowMs - lastMs;
+  p.dtMs = (dt > 0xFFFF) ? 0xFFFF : (uint16_t)dt;
+  lastMs = nowMs;
+  count++;
+  return true;
+}
+
+bool PoseBuffer::appendPacked(const PackedPose& pose) {
+  if (count == CAPACITY) {
+    return false;
+  }
+  poses[count++] = pose;
+  lastMs += pose.dtMs;
+  return true;
+}
+
+void PoseBuffer::clear() {
+  count = 0;
+  lastMs = 0;
+}
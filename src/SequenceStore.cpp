@@ -0,0 +1,233 @@
+#include "SequenceStore.h"
+
+static const char SEQUENCE_DIR[] = "/seq";
+static const char SEQUENCE_EXT[] = ".seq";
+static const char HOME_PATH[] = "/home.bin";
+static const uint8_t SEQUENCE_MAGIC[4] = {'M', 'A', 'R', 'M'};
+static const uint8_t HOME_MAGIC[4] = {'M', 'A', 'R', 'H'};
+
+static_assert(sizeof(PackedPose) == 6, "PackedPose is written to flash as-is");
+
+static void putU32(uint8_t* p, uint32_t v) {
+  p[0] = v;
+  p[1] = v >> 8;
+  p[2] = v >> 16;
+  p[3] = v >> 24;
+}
+
+static uint32_t getU32(const uint8_t* p) {
+  return p[0] | (p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+bool readSequenceHeader(File& file, uint32_t& poses) {
+  uint8_t header[SEQUENCE_HEADER_SIZE];
+  if (file.read(header, sizeof(header)) != sizeof(header)) return false;
+  if (memcmp(header, SEQUENCE_MAGIC, 4) != 0) return false;
+  if (header[4] != SEQUENCE_FILE_VERSION || header[5] != JOINT_COUNT) return false;
+  poses = getU32(header + 8);
+  // Divided rather than multiplied: a corrupt count times 6 can wrap
+  size_t size = file.size();
+  return size >= SEQUENCE_HEADER_SIZE && poses <= (size - SEQUENCE_HEADER_SIZE) / sizeof(PackedPose);
+}
+
+SequenceStore::SequenceStore(fs::FS& fs) : fs(fs) {}
+
+bool SequenceStore::validName(const char* name) {
+  size_t len = strlen(name);
+  if (len == 0 || len > SEQUENCE_NAME_MAX) return false;
+  for (size_t i = 0; i < len; i++) {
+    char c = name[i];
+    if (!isalnum((unsigned char)c) && c != '_' && c != '-') return false;
+  }
+  return true;
+}
+
+void SequenceStore::pathFor(const char* name, char* path, size_t len) {
+  snprintf(path, len, "%s/%s%s", SEQUENCE_DIR, name, SEQUENCE_EXT);
+}
+
+bool SequenceStore::save(const char* name, const PoseBuffer& poses) {
+  if (!validName(name)) return false;
+  fs.mkdir(SEQUENCE_DIR);
+
+  // Write to a temporary file and rename it over the old one (LittleFS
+  // replaces the target in one step), so a power cut leaves either the old
+  // sequence or the new one under the real name
+  char path[48], tmpPath[52];
+  pathFor(name, path, sizeof(path));
+  snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", path);
+
+  File file = fs.open(tmpPath, "w");
+  if (!file) return false;
+
+  uint8_t header[SEQUENCE_HEADER_SIZE] = {0};
+  memcpy(header, SEQUENCE_MAGIC, 4);
+  header[4] = SEQUENCE_FILE_VERSION;
+  header[5] = JOINT_COUNT;
+  putU32(header + 8, poses.size());
+  bool ok = file.write(header, sizeof(header)) == sizeof(header);
+  if (ok && !poses.empty()) {
+    size_t bytes = poses.bytesUsed();
+    ok = file.write((const uint8_t*)&poses[0], bytes) == bytes;
+  }
+  file.close();
+
+  if (!ok) {
+    fs.remove(tmpPath);
+    return false;
+  }
+  return fs.rename(tmpPath, path);
+}
+
+bool SequenceStore::load(const char* name, PoseBuffer& poses) {
+  SequenceReader reader;
+  if (!reader.open(fs, name)) return false;
+  if (reader.size() > poses.capacity()) {
+    reader.close();
+    return false;
+  }
+
+  uint32_t expected = reader.size();
+  poses.clear();
+  PackedPose pose;
+  while (reader.next(pose)) {
+    poses.appendPacked(pose);
+  }
+  reader.close();
+  return poses.size() == expected;
+}
+
+bool SequenceStore::remove(const char* name) {
+  if (!validName(name)) return false;
+  char path[48];
+  pathFor(name, path, sizeof(path));
+  return fs.remove(path);
+}
+
+bool SequenceStore::exists(const char* name) {
+  if (!validName(name)) return false;
+  char path[48];
+  pathFor(name, path, sizeof(path));
+  return fs.exists(path);
+}
+
+size_t SequenceStore::list(ListCallback fn, void* ctx) {
+  File dir = fs.open(SEQUENCE_DIR);
+  if (!dir || !dir.isDirectory()) return 0;
+
+  size_t found = 0;
+  const size_t extLen = strlen(SEQUENCE_EXT);
+  for (File file = dir.openNextFile(); file; file = dir.openNextFile()) {
+    // name() is the bare file name on the ESP32 core 2.x
+    const char* fileName = file.name();
+    const char* slash = strrchr(fileName, '/');
+    if (slash) fileName = slash + 1;
+
+    size_t len = strlen(fileName);
+    uint32_t poses;
+    if (!file.isDirectory() && len > extLen && len - extLen <= SEQUENCE_NAME_MAX &&
+        strcmp(fileName + len - extLen, SEQUENCE_EXT) == 0 && readSequenceHeader(file, poses)) {
+      char name[SEQUENCE_NAME_MAX + 1];
+      memcpy(name, fileName, len - extLen);
+      name[len - extLen] = '\0';
+      fn(name, poses, ctx);
+      found++;
+    }
+    file.close();
+  }
+  dir.close();
+  return found;
+}
+
+bool SequenceStore::saveHome(const int home[JOINT_COUNT]) {
+  uint8_t data[5 + JOINT_COUNT];
+  memcpy(data, HOME_MAGIC, 4);
+  data[4] = SEQUENCE_FILE_VERSION;
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+    data[5 + i] = constrain(home[i], 0, 180);
+  }
+
+  File file = fs.open(HOME_PATH, "w");
+  if (!file) return false;
+  bool ok = file.write(data, sizeof(data)) == sizeof(data);
+  file.close();
+  return ok;
+}
+
+bool SequenceStore::loadHome(int home[JOINT_COUNT]) {
+  if (!fs.exists(HOME_PATH)) return false;
+  File file = fs.open(HOME_PATH, "r");
+  if (!file) return false;
+
+  uint8_t data[5 + JOINT_COUNT];
+  bool ok = file.read(data, sizeof(data)) == sizeof(data) &&
+            memcmp(data, HOME_MAGIC, 4) == 0 && data[4] == SEQUENCE_FILE_VERSION;
+  file.close();
+  if (!ok) return false;
+
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+    home[i] = data[5 + i];
+  }
+  return true;
+}
+
+SequenceReader::SequenceReader() : opened(false), chunkLen(0), chunkPos(0), remaining(0), total(0) {}
+
+bool SequenceReader::open(fs::FS& fs, const char* name) {
+  close();
+  if (!SequenceStore::validName(name)) return false;
+
+  char path[48];
+  SequenceStore::pathFor(name, path, sizeof(path));
+  if (!fs.exists(path)) return false;
+  file = fs.open(path, "r");
+  if (!file) return false;
+
+  if (!readSequenceHeader(file, total)) {
+    file.close();
+    return false;
+  }
+  remaining = total;
+  chunkLen = 0;
+  chunkPos = 0;
+  opened = true;
+  return true;
+}
+
+bool SequenceReader::rewind() {
+  if (!opened || !file.seek(SEQUENCE_HEADER_SIZE)) return false;
+  remaining = total;
+  chunkLen = 0;
+  chunkPos = 0;
+  return true;
+}
+
+bool SequenceReader::fillChunk() {
+  uint8_t n = (remaining < CHUNK_POSES) ? remaining : CHUNK_POSES;
+  if (n == 0) return false;
+  size_t bytes = n * sizeof(PackedPose);
+  if (file.read((uint8_t*)chunk, bytes) != bytes) {
+    remaining = 0;
+    return false;
+  }
+  remaining -= n;
+  chunkLen = n;
+  chunkPos = 0;
+  return true;
+}
+
+bool SequenceReader::next(PackedPose& pose) {
+  if (!opened) return false;
+  if (chunkPos == chunkLen && !fillChunk()) return false;
+  pose = chunk[chunkPos++];
+  return true;
+}
+
+void SequenceReader::close() {
+  if (opened) {
+    file.close();
+    opened = false;
+  }
+  total = 0;
+  remaining = 0;
+}
@@ -0,0 +1,189 @@
+#include "SerialLink.h"
+#include "Log.h"
+
+static_assert(SERIAL_JOINTS == JOINT_COUNT, "SerialProtocol.h joint count");
+static_assert(SERIAL_POSE_SIZE == sizeof(PackedPose), "PackedPose layout");
+
+SerialLink* SerialLink::logTarget = nullptr;
+
+SerialLink::SerialLink(Stream& port, ArmController& arm, MotionTask& motion)
+    : port(port), arm(arm), motion(motion), txMutex(nullptr), isActive(false), lastFrameMs(0), received(0),
+      droppedSetpoints(0) {}
+
+void SerialLink::begin() {
+  txMutex = xSemaphoreCreateMutex();
+  logTarget = this;
+  logSetSink(logSink);
+}
+
+// Runs in the log task. Text while nobody speaks the protocol, LOG frames
+// after; either way under the same lock as the replies.
+void SerialLink::logSink(const char* line, size_t len) {
+  SerialLink* link = logTarget;
+  if (link->isActive) {
+    if (len && line[len - 1] == '\n') len--;
+    link->send(SERIAL_LOG, 0, (const uint8_t*)line, len < SERIAL_MAX_PAYLOAD ? len : SERIAL_MAX_PAYLOAD);
+    return;
+  }
+  xSemaphoreTake(link->txMutex, portMAX_DELAY);
+  link->port.write((const uint8_t*)line, len);
+  xSemaphoreGive(link->txMutex);
+}
+
+void SerialLink::setActive(bool active) {
+  if (active == isActive) return;
+  xSemaphoreTake(txMutex, portMAX_DELAY);
+  // Ends whatever text the host has buffered, so the first reply decodes
+  if (active) port.write((uint8_t)0);
+  isActive = active;
+  xSemaphoreGive(txMutex);
+  LOG_INFO("Serial protocol %s", active ? "active" : "closed; text log resumed");
+}
+
+void SerialLink::send(uint8_t type, uint8_t seq, const uint8_t* payload, size_t len) {
+  uint8_t frame[SERIAL_MAX_FRAME];
+  size_t n = serialEncodeFrame(type, seq, payload, len, frame);
+  if (n == 0) return;
+  xSemaphoreTake(txMutex, portMAX_DELAY);
+  port.write(frame, n);
+  xSemaphoreGive(txMutex);
+}
+
+void SerialLink::ack(uint8_t seq, uint8_t request, ArmStatus status) {
+  uint8_t payload[2] = {request, status};
+  send(SERIAL_ACK, seq, payload, sizeof(payload));
+}
+
+void SerialLink::ack(uint8_t seq, uint8_t request, ArmStatus status, uint16_t count) {
+  uint8_t payload[4] = {request, status};
+  serialPutU16(payload + 2, count);
+  send(SERIAL_ACK, seq, payload, sizeof(payload));
+}
+
+void SerialLink::poll() {
+  uint8_t chunk[64];
+  int available;
+  while ((available = port.available()) > 0) {
+    size_t n = port.readBytes(chunk, (size_t)available < sizeof(chunk) ? available : sizeof(chunk));
+    if (n == 0) break;
+    for (size_t i = 0; i < n; i++) {
+      if (decoder.push(chunk[i])) handleFrame();
+    }
+  }
+  if (isActive && millis() - lastFrameMs > IDLE_MS) setActive(false);
+}
+
+// Positions in tenths for every joint in the mask; the first failure is
+// reported, the other joints still move. Unlike the sliders, a target for a
+// detached joint is an error rather than ignored.
+ArmStatus SerialLink::applyTargets(const uint8_t* payload, size_t len) {
+  if (len != SERIAL_TARGETS_SIZE) return ARM_INVALID;
+  if (arm.playing()) return ARM_BUSY;
+  ArmStatus result = ARM_OK;
+  for (uint8_t j = 0; j < JOINT_COUNT; j++) {
+    if (!(payload[0] & (1 << j))) continue;
+    uint16_t tenths = serialGetU16(payload + 1 + 2 * j);
+    ArmStatus status = arm.enabled((JointId)j) ? arm.setJoint((JointId)j, (tenths + 5) / 10) : ARM_NOT_ENABLED;
+    if (result == ARM_OK) result = status;
+  }
+  return result;
+}
+
+// Payload: joints to change, then which of them end up attached
+ArmStatus SerialLink::applyEnable(const uint8_t* payload, size_t len) {
+  if (len != 2) return ARM_INVALID;
+  for (uint8_t j = 0; j < JOINT_COUNT; j++) {
+    bool want = payload[1] & (1 << j);
+    if (!(payload[0] & (1 << j)) || arm.enabled((JointId)j) == want) continue;
+    bool nowEnabled;
+    ArmStatus status = arm.toggleJoint((JointId)j, nowEnabled);
+    if (status != ARM_OK) return status;
+  }
+  return ARM_OK;
+}
+
+void SerialLink::sendState(uint8_t seq) {
+  SerialState state;
+  MotionSnapshot snap;
+  motion.snapshot(snap);
+  state.flags = (arm.recording() ? SERIAL_STATE_RECORDING : 0) | (arm.playing() ? SERIAL_STATE_PLAYING : 0) |
+                (arm.paused() ? SERIAL_STATE_PAUSED : 0);
+  state.enabled = 0;
+  for (uint8_t j = 0; j < JOINT_COUNT; j++) {
+    if (arm.enabled((JointId)j)) state.enabled |= 1 << j;
+    state.target[j] = arm.position((JointId)j);
+    state.actual[j] = snap.position[j];
+  }
+  state.poses = arm.recordedSequence().size();
+  uint32_t done, total;
+  arm.playProgress(done, total);
+  state.playDone = constrain(done, 0u, 0xFFFFu);
+  state.playTotal = constrain(total, 0u, 0xFFFFu);
+
+  uint8_t payload[SERIAL_STATE_SIZE];
+  serialEncodeState(state, payload);
+  send(SERIAL_STATE, seq, payload, sizeof(payload));
+}
+
+void SerialLink::handleFrame() {
+  received++;
+  lastFrameMs = millis();
+  setActive(decoder.type() != SERIAL_CLOSE);
+
+  uint8_t type = decoder.type();
+  uint8_t seq = decoder.seq();
+  const uint8_t* payload = decoder.payload();
+  size_t len = decoder.payloadLength();
+
+  switch (type) {
+    case SERIAL_PING:
+      send(SERIAL_PONG, seq, payload, len);
+      break;
+    case SERIAL_SET_TARGETS:
+      ack(seq, type, applyTargets(payload, len));
+      break;
+    case SERIAL_SETPOINT:
+      // Streamed: no reply, a lost one is superseded by the next
+      if (applyTargets(payload, len) != ARM_OK) droppedSetpoints++;
+      break;
+    case SERIAL_ENABLE:
+      ack(seq, type, applyEnable(payload, len));
+      break;
+    case SERIAL_GET_STATE:
+      sendState(seq);
+      break;
+    case SERIAL_UPLOAD_BEGIN:
+      ack(seq, type, arm.beginUpload());
+      break;
+    case SERIAL_UPLOAD_POSES: {
+      ArmStatus status = len % SERIAL_POSE_SIZE ? ARM_INVALID : ARM_OK;
+      for (size_t i = 0; status == ARM_OK && i < len; i += SERIAL_POSE_SIZE) {
+        PackedPose pose;
+        memcpy(pose.joints, payload + i, JOINT_COUNT);
+        pose.dtMs = serialGetU16(payload + i + JOINT_COUNT);
+        status = arm.uploadPose(pose);
+      }
+      ack(seq, type, status, arm.recordedSequence().size());
+      break;
+    }
+    case SERIAL_UPLOAD_END: {
+      // An empty name leaves the poses in RAM as the recording
+      ArmStatus status = ARM_OK;
+      if (len > SEQUENCE_NAME_MAX) {
+        status = ARM_INVALID;
+      } else if (len) {
+        char name[SEQUENCE_NAME_MAX + 1];
+        memcpy(name, payload, len);
+        name[len] = '\0';
+        status = arm.saveSequence(name);
+      }
+      ack(seq, type, status, arm.recordedSequence().size());
+      break;
+    }
+    case SERIAL_CLOSE:
+      break;
+    default:
+      ack(seq, type, ARM_INVALID);
+      break;
+  }
+}
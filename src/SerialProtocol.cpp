@@ -0,0 +1,129 @@
+#include "SerialProtocol.h"
+#include <string.h>
+
+// CRC-16/CCITT-FALSE (poly 0x1021), a nibble at a time: 32 bytes of table
+static const uint16_t crcNibble[16] = {
+  0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+  0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+};
+
+uint16_t crc16(const uint8_t* data, size_t len, uint16_t crc) {
+  for (size_t i = 0; i < len; i++) {
+    crc = (crc << 4) ^ crcNibble[(crc >> 12) ^ (data[i] >> 4)];
+    crc = (crc << 4) ^ crcNibble[(crc >> 12) ^ (data[i] & 0x0F)];
+  }
+  return crc;
+}
+
+size_t cobsEncode(const uint8_t* in, size_t len, uint8_t* out) {
+  size_t code = 0; // Where the current block's length byte goes
+  size_t o = 1;
+  uint8_t run = 1;
+  for (size_t i = 0; i < len; i++) {
+    if (in[i] == 0) {
+      out[code] = run;
+      code = o++;
+      run = 1;
+      continue;
+    }
+    out[o++] = in[i];
+    if (++run == 0xFF) {
+      out[code] = run;
+      code = o++;
+      run = 1;
+    }
+  }
+  out[code] = run;
+  return o;
+}
+
+bool cobsDecode(const uint8_t* in, size_t len, uint8_t* out, size_t& outLen) {
+  size_t i = 0;
+  size_t o = 0;
+  while (i < len) {
+    uint8_t code = in[i++];
+    if (code == 0 || i + code - 1 > len) return false;
+    for (uint8_t k = 1; k < code; k++) {
+      if (in[i] == 0) return false;
+      out[o++] = in[i++];
+    }
+    // A short block stands for a zero, except at the very end
+    if (code != 0xFF && i < len) out[o++] = 0;
+  }
+  outLen = o;
+  return true;
+}
+
+size_t serialEncodeFrame(uint8_t type, uint8_t seq, const uint8_t* payload, size_t len, uint8_t* out) {
+  if (len > SERIAL_MAX_PAYLOAD) return 0;
+  uint8_t raw[SERIAL_MAX_RAW];
+  raw[0] = type;
+  raw[1] = seq;
+  if (len) memcpy(raw + 2, payload, len);
+  serialPutU16(raw + 2 + len, crc16(raw, 2 + len));
+  size_t n = cobsEncode(raw, len + 4, out);
+  out[n++] = 0;
+  return n;
+}
+
+void serialPutU16(uint8_t* p, uint16_t v) {
+  p[0] = v & 0xFF;
+  p[1] = v >> 8;
+}
+
+uint16_t serialGetU16(const uint8_t* p) {
+  return p[0] | (p[1] << 8);
+}
+
+void serialEncodeState(const SerialState& state, uint8_t* out) {
+  out[0] = state.flags;
+  out[1] = state.enabled;
+  memcpy(out + 2, state.target, SERIAL_JOINTS);
+  for (uint8_t j = 0; j < SERIAL_JOINTS; j++) {
+    serialPutU16(out + 6 + 2 * j, (uint16_t)state.actual[j]);
+  }
+  serialPutU16(out + 14, state.poses);
+  serialPutU16(out + 16, state.playDone);
+  serialPutU16(out + 18, state.playTotal);
+  serialPutU16(out + 20, 0); // Reserved
+}
+
+bool serialDecodeState(const uint8_t* in, size_t len, SerialState& state) {
+  if (len < SERIAL_STATE_SIZE) return false;
+  state.flags = in[0];
+  state.enabled = in[1];
+  memcpy(state.target, in + 2, SERIAL_JOINTS);
+  for (uint8_t j = 0; j < SERIAL_JOINTS; j++) {
+    state.actual[j] = (int16_t)serialGetU16(in + 6 + 2 * j);
+  }
+  state.poses = serialGetU16(in + 14);
+  state.playDone = serialGetU16(in + 16);
+  state.playTotal = serialGetU16(in + 18);
+  return true;
+}
+
+bool SerialFrameDecoder::push(uint8_t b) {
+  if (b != 0) {
+    if (used < sizeof(buf)) {
+      buf[used++] = b;
+    } else {
+      overflow = true;
+    }
+    return false;
+  }
+
+  size_t n = used;
+  bool tooLong = overflow;
+  used = 0;
+  overflow = false;
+  if (n == 0) return false; // Back-to-back delimiters
+
+  size_t rawLen = 0;
+  if (tooLong || !cobsDecode(buf, n, frame, rawLen) || rawLen < 4 || rawLen > SERIAL_MAX_RAW ||
+      crc16(frame, rawLen - 2) != serialGetU16(frame + rawLen - 2)) {
+    badFrames++;
+    return false;
+  }
+  frameLen = rawLen - 4;
+  return true;
+}
@@ -0,0 +1,86 @@
+#include "ServoDriver.h"
+#include <driver/ledc.h>
+
+// One timer for every joint keeps their periods in phase
+static const ledc_mode_t ledcMode = LEDC_HIGH_SPEED_MODE;
+static const ledc_timer_t ledcTimer = LEDC_TIMER_0;
+
+static ledc_channel_t channelFor(JointId joint) {
+  return (ledc_channel_t)(LEDC_CHANNEL_0 + joint);
+}
+
+ServoDriver::ServoDriver(const JointConfig* table) : table(table) {
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+    channels[i].enabled = false;
+    channels[i].dirty = false;
+    channels[i].duty = 0;
+  }
+}
+
+void ServoDriver::begin() {
+  ledc_timer_config_t timer = {};
+  timer.speed_mode = ledcMode;
+  timer.duty_resolution = (ledc_timer_bit_t)RESOLUTION_BITS;
+  timer.timer_num = ledcTimer;
+  timer.freq_hz = FREQUENCY_HZ;
+  timer.clk_cfg = LEDC_AUTO_CLK;
+  ledc_timer_config(&timer);
+}
+
+void ServoDriver::setEnabled(JointId joint, bool enabled) {
+  Channel& ch = channels[joint];
+  if (enabled == ch.enabled) return;
+  ch.enabled = enabled;
+  ch.dirty = false;
+
+  if (enabled) {
+    // No pulses until the engine stages a position
+    ch.duty = 0;
+    ledc_channel_config_t config = {};
+    config.gpio_num = table[joint].pin;
+    config.speed_mode = ledcMode;
+    config.channel = channelFor(joint);
+    config.intr_type = LEDC_INTR_DISABLE;
+    config.timer_sel = ledcTimer;
+    config.duty = 0;
+    config.hpoint = 0;
+    ledc_channel_config(&config);
+  } else {
+    ledc_stop(ledcMode, channelFor(joint), 0);
+    ch.duty = 0;
+  }
+}
+
+float ServoDriver::pulseUs(const JointConfig& cfg, float degrees) {
+  float angle = (cfg.direction < 0 ? 180 - degrees : degrees) + cfg.offsetDeg;
+  angle = constrain(angle, 0.0f, 180.0f);
+  return cfg.minUs + (cfg.maxUs - cfg.minUs) * angle / 180;
+}
+
+uint32_t ServoDriver::dutyFor(float pulseUs) {
+  return (uint32_t)lroundf(pulseUs * (1UL << RESOLUTION_BITS) / PERIOD_US);
+}
+
+bool ServoDriver::stage(JointId joint, float degrees) {
+  Channel& ch = channels[joint];
+  if (!ch.enabled) return false;
+  uint32_t duty = dutyFor(pulseUs(table[joint], degrees));
+  if (duty == ch.duty) return false;
+  ch.duty = duty;
+  ch.dirty = true;
+  return true;
+}
+
+// Setting the duty only loads a shadow register; the update flags make each
+// channel pick it up at the start of its next period. Both loops run well
+// inside one 20 ms period, so all joints change on the same pulse.
+void ServoDriver::commit() {
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+    if (channels[i].dirty) ledc_set_duty(ledcMode, channelFor((JointId)i), channels[i].duty);
+  }
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+    if (!channels[i].dirty) continue;
+    ledc_update_duty(ledcMode, channelFor((JointId)i));
+    channels[i].dirty = false;
+  }
+}
@@ -0,0 +1,50 @@
+#include "Trajectory.h"
+
+void TrapezoidProfile::plan(float dist, float vMax, float aMax) {
+  distance = dist;
+  accel = aMax;
+  float d = fabsf(dist);
+  if (d == 0 || vMax <= 0 || aMax <= 0) {
+    vPeak = 0;
+    tAccel = 0;
+    duration = 0;
+    return;
+  }
+
+  if (d >= vMax * vMax / aMax) {
+    // Reaches cruise speed
+    vPeak = vMax;
+    tAccel = vMax / aMax;
+    duration = 2 * tAccel + (d - vMax * tAccel) / vMax;
+  } else {
+    // Triangular: accelerate to the midpoint, then brake
+    tAccel = sqrtf(d / aMax);
+    vPeak = aMax * tAccel;
+    duration = 2 * tAccel;
+  }
+}
+
+TrapezoidProfile TrapezoidProfile::scaled(float newDistance) const {
+  float k = fabsf(newDistance / distance);
+  TrapezoidProfile p = *this;
+  p.distance = newDistance;
+  p.vPeak = distance != 0 ? vPeak * k : 0;
+  p.accel = distance != 0 ? accel * k : 0;
+  return p;
+}
+
+float TrapezoidProfile::positionAt(float t) const {
+  if (t <= 0 || vPeak == 0) return 0;
+  if (t >= duration) return distance;
+
+  float s;
+  if (t < tAccel) {
+    s = 0.5f * accel * t * t;
+  } else if (t < duration - tAccel) {
+    s = 0.5f * vPeak * tAccel + vPeak * (t - tAccel);
+  } else {
+    float tLeft = duration - t;
+    s = fabsf(distance) - 0.5f * accel * tLeft * tLeft;
+  }
+  return (distance < 0) ? -s : s;
+}
@@ -1,544 +1,867 @@
 #include <WiFi.h>
-#include <WebServer.h>
-#include <ESP32Servo.h>
-#include <vector> // Required for std::vector
+#include <AsyncUDP.h>
+#include <ESPAsyncWebServer.h>
+#include <LittleFS.h>
+#include "MotionTask.h"
+#include "ServoDriver.h"
+#include "ControlChannel.h"
+#include "SequenceStore.h"
+#include "ArmController.h"
+#include "Metrics.h"
+#include "EventStream.h"
+#include "SerialLink.h"
+#include "Mirror.h"
+#include "Envelope.h"
+#include "Log.h"
+#include "WebAssets.h"
 
 // Wi-Fi AP credentials
 const char* apSSID = "MeArm_Control";
 const char* apPassword = "password"; // Consider a stronger password
-
-// MeArm Pin Definitions
-const int basePin = 13;
-const int shoulderPin = 12;
-const int elbowPin = 14;
-const int gripperPin = 27;
-
-// Servo objects
-Servo baseServo;
-Servo shoulderServo;
-Servo elbowServo;
-Servo gripperServo;
-
-// Current servo positions
-volatile int basePos = 90;
-volatile int shoulderPos = 90;
-volatile int elbowPos = 90;
-volatile int gripperPos = 90;
-
-// Home positions
-int baseHome = 90;
-int shoulderHome = 90;
-int elbowHome = 90;
-int gripperHome = 90;
-
-// Servo enable flags
-bool baseEnabled = false;
-bool shoulderEnabled = false;
-bool elbowEnabled = false;
-bool gripperEnabled = false;
-
-// --- Record & Playback Globals ---
-// Structure to hold the position of all servos for one pose
-struct Pose {
-  int base;
-  int shoulder;
-  int elbow;
-  int gripper;
+// Optional network to join as well, e.g. a router shared by the arms of a
+// cell (or the leader's AP), so they can mirror each other; "" for none
+const char* cellSSID = "";
+const char* cellPassword = "";
+
+// MeArm joint table, in JointId order: name, pin, pulse at 0 and 180
+// degrees (us), direction, trim (degrees). Calibrate each servo here.
+const JointConfig jointTable[JOINT_COUNT] = {
+  {"base", 13, 544, 2400, 1, 0},
+  {"shoulder", 12, 544, 2400, 1, 0},
+  {"elbow", 14, 544, 2400, 1, 0},
+  {"gripper", 27, 544, 2400, 1, 0},
+};
+ServoDriver servoDriver(jointTable);
+
+// Playback moves all joints together on trapezoidal profiles within these
+// per-joint limits (base, shoulder, elbow, gripper)
+const float jointMaxSpeed[JOINT_COUNT] = {120, 100, 100, 180}; // deg/s
+const float jointMaxAccel[JOINT_COUNT] = {600, 400, 400, 900}; // deg/s^2
+
+// Servo motion runs in its own task on the other core, see MotionTask.h
+MotionTask motion;
+// Named sequences and home positions on flash
+SequenceStore sequenceStore(LittleFS);
+// Arm state, recording and playback; the handlers below only translate
+// HTTP and WebSocket requests into calls on it (see ArmController.h)
+ArmController arm(motion, sequenceStore);
+const BaseType_t networkCore = 0;
+const uint32_t networkStackSize = 8192;
+
+// Event-driven server: requests are parsed and answered from the AsyncTCP
+// task as their data arrives, so connections are served concurrently
+AsyncWebServer server(80);
+AsyncWebSocket webSocket("/ws"); // Binary slider frames, see ControlChannel.h
+ControlChannel controlChannel;
+// State pushed to every open page, see EventStream.h
+const uint16_t eventRateHz = 10;
+EventStream events("/events", eventRateHz);
+const size_t maxProgramBytes = 4096;
+// Binary protocol on the USB UART, see SerialLink.h
+SerialLink serialLink(Serial, arm, motion);
+// Leader/follower mirroring over UDP multicast, see Mirror.h
+const IPAddress mirrorGroup(239, 77, 65, 1);
+const uint16_t mirrorPort = 4210;
+const uint16_t mirrorRateHz = 50;
+AsyncUDP mirrorUdp;
+Mirror mirror(mirrorRateHz);
+
+// Handlers and WebSocket events run in the AsyncTCP task, playback
+// sequencing and state pushes in the network task. Both drive the arm (and
+// through it the motion queue, which takes one producer at a time), so each
+// holds this lock while it does.
+SemaphoreHandle_t armMutex;
+
+struct ArmLock {
+  ArmLock() { xSemaphoreTake(armMutex, portMAX_DELAY); }
+  ~ArmLock() { xSemaphoreGive(armMutex); }
 };
 
-// Global vector to store the recorded sequence of poses
-std::vector<Pose> recordedSequence;
-
-// Flag to indicate if recording is active
-bool isRecording = false;
-// --- End Record & Playback Globals ---
-
-WebServer server(80);
-
-// --- FORWARD DECLARATION ---
-void moveServoSmoothly(Servo& servo, int currentPos, int targetPos, int step, int delayTime);
-
-// Function to handle web requests
-void handleRoot() {
-  String html = "<!DOCTYPE html><html lang='en'><head><meta charset='UTF-8'><meta name='viewport' content='width=device-width, initial-scale=1.0'><title>MeArm Control</title>";
-  html += "<style>";
-  html += "body { font-family: sans-serif; background-color: #222; color: #eee; display: flex; flex-direction: column; align-items: center; }";
-  html += "h1 { color: #ffd700; margin-bottom: 20px; }";
-  html += ".servo-control { margin-bottom: 20px; text-align: center; background-color: #303030; padding: 15px; border-radius: 8px; width: 250px;}";
-  html += "h2 { color: #bbb; margin-top: 0; }";
-  html += "label { display: block; margin-bottom: 5px; }";
-  html += "input[type='range'], input[type='number'] { width: 180px; padding: 5px; margin-bottom: 10px; }";
-  html += "button { background-color: #4CAF50; color: white; border: none; padding: 10px 18px; border-radius: 5px; cursor: pointer; margin-right: 5px; transition: background-color 0.3s;}";
-  html += "button:hover { background-color: #45a049; }";
-  html += "button.disable { background-color: #f44336;}";
-  html += "button.disable:hover { background-color: #da190b;}";
-  html += "button.recording { background-color: #f44336; }"; // Red when recording
-  html += "button.recording:hover { background-color: #da190b; }";
-  html += ".controls-container { display: flex; flex-wrap: wrap; justify-content: center; gap: 20px; margin-bottom: 20px;}";
-  html += ".record-play-controls { margin-bottom: 20px; text-align: center; background-color: #303030; padding: 15px; border-radius: 8px; width: auto; min-width:300px;}"; // Adjusted width
-  html += ".settings { margin-top: 30px; border-top: 1px solid #555; padding-top: 20px; text-align: center; background-color: #303030; padding: 20px; border-radius: 8px;}";
-  html += "#statusMessage { color: #ccc; margin-top: 10px; min-height: 1.2em; }"; // For feedback
-  html += "</style>";
-  html += "</head><body>";
-  html += "<h1>MeArm Control Interface</h1>";
-
-  html += "<div class='controls-container'>"; // Start of servo controls container
-  html += "<div class='servo-control'>";
-  html += "<h2>Base</h2>";
-  // Sliders now use fixed 0-180 min/max
-  html += "<p><label for='baseSlider'>Position: <span id='baseValue'>" + String(basePos) + "</span></label> <input type='range' id='baseSlider' min='0' max='180' value='" + String(basePos) + "' oninput='updateServo(this.id, this.value); document.getElementById(\"baseValue\").textContent = this.value;'></p>";
-  html += "<p><button onclick='toggleServo(\"base\")' id='baseButton'>" + String(baseEnabled ? "Disable" : "Enable") + "</button></p>";
-  html += "</div>";
-
-  html += "<div class='servo-control'>";
-  html += "<h2>Shoulder</h2>";
-  html += "<p><label for='shoulderSlider'>Position: <span id='shoulderValue'>" + String(shoulderPos) + "</span></label> <input type='range' id='shoulderSlider' min='0' max='180' value='" + String(shoulderPos) + "' oninput='updateServo(this.id, this.value); document.getElementById(\"shoulderValue\").textContent = this.value;'></p>";
-  html += "<p><button onclick='toggleServo(\"shoulder\")' id='shoulderButton'>" + String(shoulderEnabled ? "Disable" : "Enable") + "</button></p>";
-  html += "</div>";
-
-  html += "<div class='servo-control'>";
-  html += "<h2>Elbow</h2>";
-  html += "<p><label for='elbowSlider'>Position: <span id='elbowValue'>" + String(elbowPos) + "</span></label> <input type='range' id='elbowSlider' min='0' max='180' value='" + String(elbowPos) + "' oninput='updateServo(this.id, this.value); document.getElementById(\"elbowValue\").textContent = this.value;'></p>";
-  html += "<p><button onclick='toggleServo(\"elbow\")' id='elbowButton'>" + String(elbowEnabled ? "Disable" : "Enable") + "</button></p>";
-  html += "</div>";
-
-  html += "<div class='servo-control'>";
-  html += "<h2>Gripper</h2>";
-  html += "<p><label for='gripperSlider'>Position: <span id='gripperValue'>" + String(gripperPos) + "</span></label> <input type='range' id='gripperSlider' min='0' max='180' value='" + String(gripperPos) + "' oninput='updateServo(this.id, this.value); document.getElementById(\"gripperValue\").textContent = this.value;'></p>"; // Gripper also 0-180, adjust if your gripper has a smaller range physically
-  html += "<p><button onclick='toggleServo(\"gripper\")' id='gripperButton'>" + String(gripperEnabled ? "Disable" : "Enable") + "</button></p>";
-  html += "</div>";
-  html += "</div>"; // End of servo controls container
-
-  // --- Record & Play Controls ---
-  html += "<div class='record-play-controls'>";
-  html += "<h2>Record & Play</h2>";
-  html += "<button id='recordButton' onclick='toggleRecording()'>Start Record</button>";
-  html += "<button onclick='playSequence()'>Play Sequence</button>";
-  html += "<button onclick='deleteSequence()'>Delete Sequence</button>";
-  html += "<p id='statusMessage'></p>"; // For feedback
-  html += "</div>";
-  // --- End Record & Play Controls ---
-
-  // Settings (Home Positions Only)
-  html += "<div class='settings'>";
-  html += "<h2>Settings</h2>";
-  html += "<h3>Home Positions</h3>";
-  html += "<p>Base: <input type='number' id='baseHome' value='" + String(baseHome) + "'> Shoulder: <input type='number' id='shoulderHome' value='" + String(shoulderHome) + "'></p>";
-  html += "<p>Elbow: <input type='number' id='elbowHome' value='" + String(elbowHome) + "'> Gripper: <input type='number' id='gripperHome' value='" + String(gripperHome) + "'></p>";
-  // Limits section removed
-  html += "<button onclick='saveAllSettings()'>Save Home Settings</button>"; // Button text changed
-  html += "<button onclick='goHome()'>Go Home</button>";
-  html += "</div>";
-
-  html += "<script>";
-  html += "function updateServo(sliderId, value) {";
-  html += "  var servoName = sliderId.replace('Slider', '');";
-  html += "  var xhr = new XMLHttpRequest();";
-  html += "  xhr.open('GET', '/set_servo?servo=' + servoName + '&pos=' + value, true);";
-  html += "  xhr.send();";
-  html += "}";
-
-  html += "function toggleServo(servoName) {";
-  html += "  var button = document.getElementById(servoName + 'Button');";
-  html += "  var xhr = new XMLHttpRequest();";
-  html += "  xhr.open('GET', '/toggle_servo?servo=' + servoName, true);";
-  html += "  xhr.onload = function() {";
-  html += "    if (xhr.status === 200) {";
-  html += "      if (xhr.responseText === 'enabled') {";
-  html += "        button.textContent = 'Disable';";
-  html += "        button.classList.add('disable');";
-  html += "      } else if (xhr.responseText === 'disabled') {";
-  html += "        button.textContent = 'Enable';";
-  html += "        button.classList.remove('disable');";
-  html += "      }";
-  html += "    }";
-  html += "  };";
-  html += "  xhr.send();";
-  html += "}";
-
-  html += "function saveAllSettings() {"; // Only saves home positions now
-  html += "  var params = 'baseHome=' + document.getElementById('baseHome').value;";
-  html += "  params += '&shoulderHome=' + document.getElementById('shoulderHome').value;";
-  html += "  params += '&elbowHome=' + document.getElementById('elbowHome').value;";
-  html += "  params += '&gripperHome=' + document.getElementById('gripperHome').value;";
-  // Limit parameters removed
-  html += "  var xhr = new XMLHttpRequest();";
-  html += "  xhr.open('GET', '/save_settings?' + params, true);";
-  html += "  var statusMsg = document.getElementById('statusMessage');";
-  html += "  xhr.onload = function() { if(xhr.status === 200) statusMsg.textContent = 'Home settings saved!'; else statusMsg.textContent = 'Error saving settings.'; };";
-  html += "  xhr.send();";
-  html += "}";
-
-  html += "function goHome() {";
-  html += "  var xhr = new XMLHttpRequest();";
-  html += "  xhr.open('GET', '/go_home', true);";
-  html += "  var statusMsg = document.getElementById('statusMessage');";
-  html += "  xhr.onload = function() {";
-  html += "    if (xhr.status === 200) {";
-  html += "      var parts = xhr.responseText.split(',');";
-  html += "      if (parts.length === 8) {";
-  html += "        var homePositions = { base: parts[0], shoulder: parts[1], elbow: parts[2], gripper: parts[3] };";
-  html += "        var enabledStates = { base: parts[4] === '1', shoulder: parts[5] === '1', elbow: parts[6] === '1', gripper: parts[7] === '1' };";
-  html += "        if(enabledStates.base) { document.getElementById('baseSlider').value = homePositions.base; document.getElementById('baseValue').textContent = homePositions.base; }";
-  html += "        if(enabledStates.shoulder) { document.getElementById('shoulderSlider').value = homePositions.shoulder; document.getElementById('shoulderValue').textContent = homePositions.shoulder; }";
-  html += "        if(enabledStates.elbow) { document.getElementById('elbowSlider').value = homePositions.elbow; document.getElementById('elbowValue').textContent = homePositions.elbow; }";
-  html += "        if(enabledStates.gripper) { document.getElementById('gripperSlider').value = homePositions.gripper; document.getElementById('gripperValue').textContent = homePositions.gripper; }";
-  html += "        statusMsg.textContent = 'Moving to home positions!';";
-  html += "      }";
-  html += "    } else { statusMsg.textContent = 'Error going home.'; }";
-  html += "  };";
-  html += "  xhr.send();";
-  html += "}";
-
-  // --- JavaScript for Record & Play ---
-  html += "function toggleRecording() {";
-  html += "  var xhr = new XMLHttpRequest();";
-  html += "  xhr.open('GET', '/toggle_record', true);";
-  html += "  var statusMsg = document.getElementById('statusMessage');";
-  html += "  xhr.onload = function() {";
-  html += "    if (xhr.status === 200) {";
-  html += "      var recordButton = document.getElementById('recordButton');";
-  html += "      if (xhr.responseText === 'RECORDING_STARTED') {";
-  html += "        recordButton.textContent = 'Stop Recording';";
-  html += "        recordButton.classList.add('recording');";
-  html += "        statusMsg.textContent = 'Recording started...';";
-  html += "      } else if (xhr.responseText === 'RECORDING_STOPPED') {";
-  html += "        recordButton.textContent = 'Start Record';";
-  html += "        recordButton.classList.remove('recording');";
-  html += "        statusMsg.textContent = 'Recording stopped.';";
-  html += "      } else if (xhr.responseText === 'MUST_DELETE_FIRST') {";
-  html += "        statusMsg.textContent = 'A recording already exists. Delete it to start a new one.';";
-  html += "      } else { statusMsg.textContent = xhr.responseText; }";
-  html += "    } else { statusMsg.textContent = 'Error: ' + xhr.status; }";
-  html += "  };";
-  html += "  xhr.send();";
-  html += "}";
-
-  html += "function playSequence() {";
-  html += "  var xhr = new XMLHttpRequest();";
-  html += "  xhr.open('GET', '/play_sequence', true);";
-  html += "  var statusMsg = document.getElementById('statusMessage');";
-  html += "  statusMsg.textContent = 'Playback starting...';";
-  html += "  xhr.onload = function() {";
-  html += "    if (xhr.status === 200) {";
-  html += "      statusMsg.textContent = xhr.responseText;"; // e.g., "PLAYBACK_STARTED" or "No sequence"
-  html += "    } else { statusMsg.textContent = 'Error: ' + xhr.status; }";
-  html += "  };";
-  html += "  xhr.send();";
-  html += "}";
-
-  html += "function deleteSequence() {";
-  html += "  var xhr = new XMLHttpRequest();";
-  html += "  xhr.open('GET', '/delete_sequence', true);";
-  html += "  var statusMsg = document.getElementById('statusMessage');";
-  html += "  xhr.onload = function() {";
-  html += "    if (xhr.status === 200) {";
-  html += "      statusMsg.textContent = xhr.responseText;";
-  html += "      var recordButton = document.getElementById('recordButton');";
-  html += "      recordButton.textContent = 'Start Record';"; // Reset record button text
-  html += "      recordButton.classList.remove('recording');"; // Reset record button style
-  html += "    } else { statusMsg.textContent = 'Error: ' + xhr.status; }";
-  html += "  };";
-  html += "  xhr.send();";
-  html += "}";
-  // --- End JavaScript for Record & Play ---
-
-  html += "document.addEventListener('DOMContentLoaded', function() {";
-  html += "  if (" + String(baseEnabled ? "true" : "false") + ") { var btn = document.getElementById('baseButton'); btn.textContent = 'Disable'; btn.classList.add('disable'); }";
-  html += "  if (" + String(shoulderEnabled ? "true" : "false") + ") { var btn = document.getElementById('shoulderButton'); btn.textContent = 'Disable'; btn.classList.add('disable'); }";
-  html += "  if (" + String(elbowEnabled ? "true" : "false") + ") { var btn = document.getElementById('elbowButton'); btn.textContent = 'Disable'; btn.classList.add('disable'); }";
-  html += "  if (" + String(gripperEnabled ? "true" : "false") + ") { var btn = document.getElementById('gripperButton'); btn.textContent = 'Disable'; btn.classList.add('disable'); }";
-  // Check if a recording exists on page load (more advanced, would require another endpoint or initial data)
-  // For now, record button defaults to "Start Record".
-  html += "});";
-  html += "</script>";
-
-  html += "</body></html>";
-  server.send(200, "text/html", html);
-}
-
-void handleSetServo() {
-  String servoName = server.arg("servo");
-  String posStr = server.arg("pos");
-  int targetPos = posStr.toInt();
-  int step = 1;
-  int delayTime = 3;
-
-  // Apply hardcoded safety limit for all servos
-  targetPos = constrain(targetPos, 0, 180);
-
-  if (servoName == "base") {
-    if (baseEnabled) {
-      moveServoSmoothly(baseServo, basePos, targetPos, step, delayTime);
-      basePos = targetPos;
-    }
-  } else if (servoName == "shoulder") {
-    if (shoulderEnabled) {
-      moveServoSmoothly(shoulderServo, shoulderPos, targetPos, step, delayTime);
-      shoulderPos = targetPos;
-    }
-  } else if (servoName == "elbow") {
-    if (elbowEnabled) {
-      moveServoSmoothly(elbowServo, elbowPos, targetPos, step, delayTime);
-      elbowPos = targetPos;
-    }
-  } else if (servoName == "gripper") {
-    if (gripperEnabled) {
-      moveServoSmoothly(gripperServo, gripperPos, targetPos, step, delayTime);
-      gripperPos = targetPos;
-    }
+#if MEARM_METRICS
+Metrics metrics; // Served at /metrics, see handleMetrics()
+RateMeter servoWriteRate;
+#endif
+
+// Serves the prebuilt page (web/index.html, gzipped into WebAssets.h at
+// build time) straight from flash. Browsers revalidate with the ETag and get
+// a 304 until the firmware changes.
+void handleRoot(AsyncWebServerRequest* request) {
+  if (request->hasHeader("If-None-Match") && request->header("If-None-Match") == INDEX_HTML_ETAG) {
+    request->send(304);
+    return;
   }
+  AsyncWebServerResponse* response = request->beginResponse_P(200, "text/html", INDEX_HTML_GZ, INDEX_HTML_GZ_LEN);
+  response->addHeader("Cache-Control", "no-cache");
+  response->addHeader("ETag", INDEX_HTML_ETAG);
+  response->addHeader("Content-Encoding", "gzip");
+  request->send(response);
+}
 
-  // If recording, add current state of ALL servos as a new pose
-  // Only record if the new pose is different from the last recorded one
-  if (isRecording) {
-    bool shouldRecord = true;
-    if (!recordedSequence.empty()) {
-      const Pose& lastPose = recordedSequence.back();
-      if (lastPose.base == basePos && lastPose.shoulder == shoulderPos &&
-          lastPose.elbow == elbowPos && lastPose.gripper == gripperPos) {
-        shouldRecord = false; // Same as last pose, don't record
-      }
-    }
-    
-    if (shouldRecord) {
-      Pose currentPose;
-      currentPose.base = basePos;
-      currentPose.shoulder = shoulderPos;
-      currentPose.elbow = elbowPos;
-      currentPose.gripper = gripperPos;
-      recordedSequence.push_back(currentPose);
-      Serial.println("Pose recorded. Sequence size: " + String(recordedSequence.size()));
+// Live values the page fills itself in with on load
+void handleState(AsyncWebServerRequest* request) {
+  char json[ArmController::STATE_JSON_SIZE];
+  arm.stateJson(json, sizeof(json));
+  AsyncWebServerResponse* response = request->beginResponse(200, "application/json", json);
+  response->addHeader("Cache-Control", "no-store");
+  request->send(response);
+}
+
+// Called from the network task: one snapshot serialized per frame,
+// however many pages are listening
+void broadcastState() {
+  uint32_t now = millis();
+  if (!events.due(now)) return;
+  char json[ArmController::STATE_JSON_SIZE];
+  arm.stateJson(json, sizeof(json));
+  events.publish("state", json, now);
+}
+
+// Picks the joint from ?joint=<id> (0-3, as the page sends it), which needs
+// no string compares. ?servo=<name> is still accepted for older clients.
+bool jointFromArgs(AsyncWebServerRequest* request, JointId& joint) {
+  if (request->hasArg("joint")) {
+    String id = request->arg("joint");
+    if (id.length() != 1 || id[0] < '0' || id[0] >= '0' + JOINT_COUNT) return false;
+    joint = (JointId)(id[0] - '0');
+    return true;
+  }
+  String name = request->arg("servo");
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+    if (name == jointTable[i].name) {
+      joint = (JointId)i;
+      return true;
     }
   }
-  server.send(200, "text/plain", "OK");
+  return false;
 }
 
-void handleToggleServo() {
-  String servoName = server.arg("servo");
-  bool nowEnabled = false;
+// Replies for the failures most handlers share; anything else is a 500
+void sendStatus(AsyncWebServerRequest* request, ArmStatus status) {
+  switch (status) {
+    case ARM_BUSY:
+      request->send(409, "text/plain", "Playback in progress");
+      break;
+    case ARM_QUEUE_FULL:
+      request->send(503, "text/plain", "Motion queue full");
+      break;
+    case ARM_NOT_FOUND:
+      request->send(404, "text/plain", "No such sequence.");
+      break;
+    case ARM_UNSAFE:
+      request->send(422, "text/plain", "Shoulder/elbow pose would hit the table or base");
+      break;
+    default:
+      request->send(500, "text/plain", "Error");
+      break;
+  }
+}
 
-  if (servoName == "base") {
-    baseEnabled = !baseEnabled;
-    nowEnabled = baseEnabled;
-    if (baseEnabled) baseServo.attach(basePin); else baseServo.detach();
-  } else if (servoName == "shoulder") {
-    shoulderEnabled = !shoulderEnabled;
-    nowEnabled = shoulderEnabled;
-    if (shoulderEnabled) shoulderServo.attach(shoulderPin); else shoulderServo.detach();
-  } else if (servoName == "elbow") {
-    elbowEnabled = !elbowEnabled;
-    nowEnabled = elbowEnabled;
-    if (elbowEnabled) elbowServo.attach(elbowPin); else elbowServo.detach();
-  } else if (servoName == "gripper") {
-    gripperEnabled = !gripperEnabled;
-    nowEnabled = gripperEnabled;
-    if (gripperEnabled) gripperServo.attach(gripperPin); else gripperServo.detach();
-  } else {
-    server.send(400, "text/plain", "Invalid servo");
+void handleSetServo(AsyncWebServerRequest* request) {
+  JointId joint;
+  ArmStatus status = ARM_OK;
+  if (jointFromArgs(request, joint)) {
+    status = arm.setJoint(joint, request->arg("pos").toInt());
+  } else if (arm.playing()) {
+    status = ARM_BUSY;
+  }
+  if (status != ARM_OK) {
+    sendStatus(request, status);
     return;
   }
-  server.send(200, "text/plain", nowEnabled ? "enabled" : "disabled");
+  request->send(200, "text/plain", "OK");
 }
 
-void handleSaveSettings() { // Now only saves Home positions
-  auto getArgInt = [&](const String& argName, int currentValue) {
-    if (server.hasArg(argName)) {
-      return (int)server.arg(argName).toInt();
-    }
-    return currentValue;
-  };
+// Moves the gripper tip to x,y,z (millimetres, see Kinematics.h for the frame)
+// with base, shoulder and elbow moving together. Replies with the servo angles.
+void handleMoveXYZ(AsyncWebServerRequest* request) {
+  if (arm.playing()) {
+    sendStatus(request, ARM_BUSY);
+    return;
+  }
+  if (!request->hasArg("x") || !request->hasArg("y") || !request->hasArg("z")) {
+    request->send(400, "text/plain", "x, y and z are required");
+    return;
+  }
 
-  baseHome = getArgInt("baseHome", baseHome);
-  shoulderHome = getArgInt("shoulderHome", shoulderHome);
-  elbowHome = getArgInt("elbowHome", elbowHome);
-  gripperHome = getArgInt("gripperHome", gripperHome);
-  // Limit settings removed
+  ArmPoint target;
+  target.x = lroundf(request->arg("x").toFloat() * 10);
+  target.y = lroundf(request->arg("y").toFloat() * 10);
+  target.z = lroundf(request->arg("z").toFloat() * 10);
+  int angles[JOINT_COUNT];
+  ArmStatus status = arm.moveXYZ(target, angles);
+  if (status == ARM_NOT_ENABLED) {
+    request->send(409, "text/plain", "Enable base, shoulder and elbow first");
+  } else if (status == ARM_OUT_OF_REACH) {
+    request->send(422, "text/plain", "Out of reach");
+  } else if (status != ARM_OK) {
+    sendStatus(request, status);
+  } else {
+    char reply[32];
+    snprintf(reply, sizeof(reply), "%d,%d,%d", angles[JOINT_BASE], angles[JOINT_SHOULDER], angles[JOINT_ELBOW]);
+    request->send(200, "text/plain", reply);
+  }
+}
 
-  server.send(200, "text/plain", "Home settings saved");
-  Serial.println("Home Settings Saved:");
-  Serial.println("  Base H:" + String(baseHome) + ", Shoulder H:" + String(shoulderHome) +
-                 ", Elbow H:" + String(elbowHome) + ", Gripper H:" + String(gripperHome));
+// --- WebSocket Control Channel ---
+void webSocketEvent(AsyncWebSocket*, AsyncWebSocketClient* client, AwsEventType type, void* arg,
+                    uint8_t* data, size_t length) {
+  ArmLock lock;
+  switch (type) {
+    case WS_EVT_CONNECT:
+      if (!controlChannel.connect(client->id())) client->close();
+      break;
+    case WS_EVT_DISCONNECT:
+      controlChannel.disconnect(client->id());
+      break;
+    case WS_EVT_DATA: {
+      // A slider or jog frame always fits in one binary frame; anything else
+      // (text, fragments) counts as malformed
+      AwsFrameInfo* info = (AwsFrameInfo*)arg;
+      bool whole = info->opcode == WS_BINARY && info->final && info->index == 0 && info->len == length;
+      // Frames arriving during playback are dropped rather than queued
+      if (!arm.playing()) {
+        controlChannel.accept(client->id(), data, whole ? length : 0);
+      }
+      break;
+    }
+    default:
+      break;
+  }
 }
 
-void handleGoHome() {
-  if (baseEnabled) {
-    moveServoSmoothly(baseServo, basePos, baseHome, 1, 3);
-    basePos = baseHome;
+// Called from the network task: applies at most one (the newest) target per
+// joint and the newest jog. A target or jog dropped on a full queue is
+// superseded by the next frame.
+void applyControlFrames() {
+  int targetPos;
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+    if (controlChannel.takePending((JointId)i, targetPos)) {
+      arm.setJoint((JointId)i, targetPos);
+    }
   }
-  if (shoulderEnabled) {
-    moveServoSmoothly(shoulderServo, shoulderPos, shoulderHome, 1, 3);
-    shoulderPos = shoulderHome;
+  float velocities[JOINT_COUNT];
+  if (controlChannel.takeJog(velocities)) {
+    arm.jog(velocities);
   }
-  if (elbowEnabled) {
-    moveServoSmoothly(elbowServo, elbowPos, elbowHome, 1, 3);
-    elbowPos = elbowHome;
+}
+// --- End WebSocket Control Channel ---
+
+// /jog?v=base,shoulder,elbow,gripper in deg/s; repeat within the dead-man
+// timeout to keep moving (the WebSocket jog frame is the cheaper way)
+void handleJog(AsyncWebServerRequest* request) {
+  float velocities[JOINT_COUNT] = {};
+  String list = request->arg("v");
+  const char* p = list.c_str();
+  for (uint8_t i = 0; i < JOINT_COUNT && *p; i++) {
+    char* end;
+    velocities[i] = strtof(p, &end);
+    if (end == p || !isfinite(velocities[i]) || (*end && *end != ',')) {
+      request->send(400, "text/plain", "v must be up to four comma-separated velocities");
+      return;
+    }
+    p = *end ? end + 1 : end;
   }
-  if (gripperEnabled) {
-    moveServoSmoothly(gripperServo, gripperPos, gripperHome, 1, 3);
-    gripperPos = gripperHome;
+  ArmStatus status = arm.jog(velocities);
+  if (status != ARM_OK) {
+    sendStatus(request, status);
+    return;
   }
-  String response = String(baseHome) + "," + String(shoulderHome) + "," + String(elbowHome) + "," + String(gripperHome) + ",";
-  response += String(baseEnabled ? "1" : "0") + "," + String(shoulderEnabled ? "1" : "0") + ",";
-  response += String(elbowEnabled ? "1" : "0") + "," + String(gripperEnabled ? "1" : "0");
-  server.send(200, "text/plain", response);
+  request->send(200, "text/plain", "OK");
 }
 
-// --- New Handler Functions for Record & Play ---
-void handleToggleRecord() {
-  if (!isRecording) { // Trying to start recording
-    if (!recordedSequence.empty()) {
-      Serial.println("Attempt to record over existing seq. Must delete first.");
-      server.send(200, "text/plain", "MUST_DELETE_FIRST");
+// Run by the motion task a few times a tick while jogging
+bool jogGuard(const float positions[JOINT_COUNT]) {
+  return envelopeAllows(lroundf(positions[JOINT_SHOULDER]), lroundf(positions[JOINT_ELBOW]));
+}
+
+void handleToggleServo(AsyncWebServerRequest* request) {
+  JointId joint;
+  bool nowEnabled = false;
+  if (arm.playing()) {
+    sendStatus(request, ARM_BUSY);
+  } else if (!jointFromArgs(request, joint)) {
+    request->send(400, "text/plain", "Invalid servo");
+  } else {
+    ArmStatus status = arm.toggleJoint(joint, nowEnabled);
+    if (status != ARM_OK) {
+      sendStatus(request, status);
       return;
     }
-    isRecording = true;
-    // recordedSequence.clear(); // Ensure it's empty if we were to auto-clear
-    Serial.println("Recording started.");
-    server.send(200, "text/plain", "RECORDING_STARTED");
-  } else { // Trying to stop recording
-    isRecording = false;
-    Serial.println("Recording stopped. Total Poses: " + String(recordedSequence.size()));
-    server.send(200, "text/plain", "RECORDING_STOPPED");
+    request->send(200, "text/plain", nowEnabled ? "enabled" : "disabled");
   }
 }
 
-void handlePlaySequence() {
-  if (recordedSequence.empty()) {
-    server.send(200, "text/plain", "No sequence recorded to play.");
-    Serial.println("Playback attempt: No sequence.");
-    return;
+void handleSaveSettings(AsyncWebServerRequest* request) { // Now only saves Home positions
+  const char* names[JOINT_COUNT] = {"baseHome", "shoulderHome", "elbowHome", "gripperHome"};
+  int home[JOINT_COUNT];
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+    home[i] = request->hasArg(names[i]) ? request->arg(names[i]).toInt() : arm.home((JointId)i);
   }
 
-  Serial.println("Playing sequence of " + String(recordedSequence.size()) + " poses...");
-  server.send(200, "text/plain", "PLAYBACK_STARTED"); 
-
-  bool tempBaseEnabled = !baseEnabled; // True if we need to temp enable
-  bool tempShoulderEnabled = !shoulderEnabled;
-  bool tempElbowEnabled = !elbowEnabled;
-  bool tempGripperEnabled = !gripperEnabled;
-
-  if (tempBaseEnabled) baseServo.attach(basePin);
-  if (tempShoulderEnabled) shoulderServo.attach(shoulderPin);
-  if (tempElbowEnabled) elbowServo.attach(elbowPin);
-  if (tempGripperEnabled) gripperServo.attach(gripperPin);
-  
-  int currentPlaybackBasePos = basePos;
-  int currentPlaybackShoulderPos = shoulderPos;
-  int currentPlaybackElbowPos = elbowPos;
-  int currentPlaybackGripperPos = gripperPos;
+  ArmStatus status = arm.saveHome(home);
+  if (status == ARM_UNSAFE) {
+    sendStatus(request, status);
+    return;
+  } else if (status != ARM_OK) {
+    request->send(500, "text/plain", "Could not write home settings to flash");
+    return;
+  }
+  request->send(200, "text/plain", "Home settings saved");
+}
 
-  for (const auto& pose : recordedSequence) {
-    int playStep = 1;   
-    int playDelay = 10; 
+// Replies with the four home positions followed by the four enable flags
+void handleGoHome(AsyncWebServerRequest* request) {
+  ArmStatus status = arm.goHome();
+  if (status != ARM_OK) {
+    sendStatus(request, status);
+    return;
+  }
+  char reply[48];
+  snprintf(reply, sizeof(reply), "%d,%d,%d,%d,%d,%d,%d,%d",
+           arm.home(JOINT_BASE), arm.home(JOINT_SHOULDER), arm.home(JOINT_ELBOW), arm.home(JOINT_GRIPPER),
+           arm.enabled(JOINT_BASE), arm.enabled(JOINT_SHOULDER), arm.enabled(JOINT_ELBOW), arm.enabled(JOINT_GRIPPER));
+  request->send(200, "text/plain", reply);
+}
 
-    moveServoSmoothly(baseServo, currentPlaybackBasePos, pose.base, playStep, playDelay);
-    currentPlaybackBasePos = pose.base; 
+// --- New Handler Functions for Record & Play ---
+void handleToggleRecord(AsyncWebServerRequest* request) {
+  switch (arm.toggleRecording()) {
+    case RECORD_STARTED:
+      request->send(200, "text/plain", "RECORDING_STARTED");
+      break;
+    case RECORD_STOPPED:
+      request->send(200, "text/plain", "RECORDING_STOPPED");
+      break;
+    case RECORD_MUST_DELETE_FIRST:
+      request->send(200, "text/plain", "MUST_DELETE_FIRST");
+      break;
+  }
+}
 
-    moveServoSmoothly(shoulderServo, currentPlaybackShoulderPos, pose.shoulder, playStep, playDelay);
-    currentPlaybackShoulderPos = pose.shoulder;
+// Re-runs keyframe reduction on the recorded sequence, optionally with new
+// tolerances (?tol= for all joints, or ?base=&shoulder=&elbow=&gripper=)
+void handleCompressSequence(AsyncWebServerRequest* request) {
+  float tolerance[JOINT_COUNT];
+  bool haveTolerance = false;
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+    tolerance[i] = arm.tolerance((JointId)i);
+    if (request->hasArg("tol")) tolerance[i] = request->arg("tol").toFloat();
+    const char* name = jointTable[i].name;
+    if (request->hasArg(name)) tolerance[i] = request->arg(name).toFloat();
+    haveTolerance = haveTolerance || request->hasArg("tol") || request->hasArg(name);
+  }
 
-    moveServoSmoothly(elbowServo, currentPlaybackElbowPos, pose.elbow, playStep, playDelay);
-    currentPlaybackElbowPos = pose.elbow;
+  size_t bytesBefore = arm.recordedSequence().bytesUsed();
+  KeyframeStats stats;
+  if (arm.compressRecording(haveTolerance ? tolerance : nullptr, stats) != ARM_OK) {
+    request->send(409, "text/plain", "Busy recording or playing.");
+    return;
+  }
+  char json[128];
+  snprintf(json, sizeof(json), "{\"before\":%u,\"after\":%u,\"ratio\":%.2f,\"bytesBefore\":%u,\"bytesAfter\":%u}",
+           (unsigned)stats.before, (unsigned)stats.after, stats.ratio(),
+           (unsigned)bytesBefore, (unsigned)arm.recordedSequence().bytesUsed());
+  request->send(200, "application/json", json);
+}
 
-    moveServoSmoothly(gripperServo, currentPlaybackGripperPos, pose.gripper, playStep, playDelay);
-    currentPlaybackGripperPos = pose.gripper;
+// Plays the recorded sequence, or with ?name= streams a stored one from flash.
+// ?loops= repeats it (0 = until stopped) and ?speed= scales it (0.1-3).
+void handlePlaySequence(AsyncWebServerRequest* request) {
+  uint16_t loops = request->hasArg("loops") ? constrain(request->arg("loops").toInt(), 0L, 65535L) : 1;
+  float speed = request->hasArg("speed") ? request->arg("speed").toFloat() : 1;
+  ArmStatus status = arm.play(request->hasArg("name") ? request->arg("name").c_str() : nullptr, loops, speed);
+  if (status == ARM_INVALID) {
+    request->send(400, "text/plain", "speed must be positive");
+  } else if (status == ARM_BUSY) {
+    request->send(200, "text/plain", "Playback already running.");
+  } else if (status == ARM_EMPTY) {
+    request->send(200, "text/plain", "No sequence recorded to play.");
+  } else if (status != ARM_OK) {
+    sendStatus(request, status);
+  } else {
+    request->send(200, "text/plain", "PLAYBACK_STARTED");
+  }
+}
 
-    delay(100); 
+void handlePauseSequence(AsyncWebServerRequest* request) {
+  switch (arm.pause()) {
+    case ARM_OK:
+      request->send(200, "text/plain", "PLAYBACK_PAUSED");
+      break;
+    case ARM_INVALID:
+      request->send(409, "text/plain", "A program can only be stopped.");
+      break;
+    default:
+      request->send(409, "text/plain", "Nothing playing.");
+      break;
   }
+}
 
-  basePos = currentPlaybackBasePos;
-  shoulderPos = currentPlaybackShoulderPos;
-  elbowPos = currentPlaybackElbowPos;
-  gripperPos = currentPlaybackGripperPos;
+void handleResumeSequence(AsyncWebServerRequest* request) {
+  ArmStatus status = arm.resume();
+  if (status == ARM_NOT_FOUND) {
+    request->send(409, "text/plain", "Nothing playing.");
+  } else if (status != ARM_OK) {
+    sendStatus(request, status);
+  } else {
+    request->send(200, "text/plain", "PLAYBACK_RESUMED");
+  }
+}
 
-  if (tempBaseEnabled) baseServo.detach();
-  if (tempShoulderEnabled) shoulderServo.detach();
-  if (tempElbowEnabled) elbowServo.detach();
-  if (tempGripperEnabled) gripperServo.detach();
+// Stops pose playback or a program; the arm holds within one motion tick
+void handleStopSequence(AsyncWebServerRequest* request) {
+  if (arm.stop() != ARM_OK) {
+    request->send(409, "text/plain", "Nothing playing.");
+    return;
+  }
+  request->send(200, "text/plain", "PLAYBACK_STOPPED");
+}
 
-  Serial.println("Playback finished.");
+// Changes the playback speed, also mid-run (from the next pose); replies
+// with the speed actually used
+void handleSequenceSpeed(AsyncWebServerRequest* request) {
+  if (arm.setPlaySpeed(request->arg("speed").toFloat()) != ARM_OK) {
+    request->send(400, "text/plain", "speed must be positive");
+    return;
+  }
+  char reply[16];
+  snprintf(reply, sizeof(reply), "%.2f", arm.playSpeed());
+  request->send(200, "text/plain", reply);
 }
 
-void handleDeleteSequence() {
-  recordedSequence.clear();
-  bool wasRecording = isRecording;
-  isRecording = false; 
-  
-  Serial.println("Recorded sequence deleted.");
-  if (wasRecording) {
-    server.send(200, "text/plain", "Sequence deleted. Recording stopped.");
+// Clears the recorded sequence, or with ?name= deletes a stored one
+void handleDeleteSequence(AsyncWebServerRequest* request) {
+  if (request->hasArg("name")) {
+    ArmStatus status = arm.deleteSequence(request->arg("name").c_str());
+    if (status != ARM_OK) {
+      sendStatus(request, status);
+    } else {
+      request->send(200, "text/plain", "Stored sequence deleted.");
+    }
+    return;
+  }
+
+  if (arm.deleteRecording()) {
+    request->send(200, "text/plain", "Sequence deleted. Recording stopped.");
   } else {
-    server.send(200, "text/plain", "Sequence deleted.");
+    request->send(200, "text/plain", "Sequence deleted.");
   }
 }
-// --- End New Handler Functions ---
 
+// --- Mirroring ---
+const char* const mirrorModeNames[] = {"off", "leader", "follower"};
 
-void moveServoSmoothly(Servo& servo, int currentServoPos, int targetPos, int step, int delayTime) {
-  if (!servo.attached()) {
-    // Serial.println("Servo not attached, cannot move."); // Optional debug
-    return; 
+// Runs in the AsyncUDP task
+void mirrorPacket(AsyncUDPPacket& packet) {
+  ArmLock lock;
+  mirror.receive(packet.data(), packet.length(), micros());
+}
+
+// Called from the network task once per mirror period: the leader sends
+// where its servos are, a follower moves towards the leader's path
+void runMirror() {
+  uint32_t now = micros();
+  if (!mirror.due(now)) return;
+
+  if (mirror.mode() == MIRROR_LEADER) {
+    MotionSnapshot snap;
+    motion.snapshot(snap);
+    int positions[JOINT_COUNT];
+    uint8_t enabled = 0;
+    for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+      positions[i] = snap.position[i];
+      if (arm.enabled((JointId)i)) enabled |= 1 << i;
+    }
+    uint8_t packet[MIRROR_PACKET_SIZE];
+    size_t len = mirror.encode(positions, enabled, now, packet);
+    mirrorUdp.writeTo(packet, len, mirrorGroup, mirrorPort);
+    return;
   }
-  
-  // Ensure targetPos is within valid servo range (0-180) if not already done
-  targetPos = constrain(targetPos, 0, 180);
 
-  if (targetPos > currentServoPos) {
-    for (int p = currentServoPos; p <= targetPos; p += step) {
-      servo.write(p);
-      delay(delayTime);
+  int targets[JOINT_COUNT];
+  uint8_t enabled;
+  if (mirror.target(now, targets, enabled) && !arm.playing()) {
+    arm.track(targets, enabled, mirror.periodUs() / 1e6f);
+  }
+}
+
+// /mirror?mode=off|leader|follower&rate=<Hz>, both optional; replies with
+// the mode and the follower's view of the link as JSON. Both arguments are
+// checked before either is applied, so a bad request changes nothing.
+void handleMirror(AsyncWebServerRequest* request) {
+  long rate = 0;
+  if (request->hasArg("rate")) {
+    String value = request->arg("rate");
+    const char* p = value.c_str();
+    char* end;
+    rate = strtol(p, &end, 10);
+    if (!isdigit((unsigned char)*p) || *end || rate < 1 || rate > 100) {
+      request->send(400, "text/plain", "rate must be 1-100 Hz");
+      return;
     }
-  } else if (targetPos < currentServoPos) {
-    for (int p = currentServoPos; p >= targetPos; p -= step) {
-      servo.write(p);
-      delay(delayTime);
+  }
+  int m = -1;
+  if (request->hasArg("mode")) {
+    String mode = request->arg("mode");
+    m = 0;
+    while (m <= MIRROR_FOLLOWER && mode != mirrorModeNames[m]) m++;
+    if (m > MIRROR_FOLLOWER) {
+      request->send(400, "text/plain", "mode must be off, leader or follower");
+      return;
     }
+  }
+
+  if (rate) mirror.setRate(rate);
+  if (m >= 0) {
+    // A fresh id per session, so followers never mistake a restarted
+    // leader's packets for stale ones
+    mirror.setMode((MirrorMode)m, esp_random());
+    LOG_INFO("Mirror mode: %s", mirrorModeNames[m]);
+  }
+
+  char json[256];
+  snprintf(json, sizeof(json),
+           "{\"mode\":\"%s\",\"rate\":%u,\"following\":%s,\"leader\":\"%08x\",\"sent\":%u,"
+           "\"accepted\":%u,\"stale\":%u,\"lost\":%u,\"jitter_us\":%u,\"playout_us\":%u}",
+           mirrorModeNames[mirror.mode()], mirror.rate(), mirror.following() ? "true" : "false",
+           (unsigned)mirror.leader(), (unsigned)mirror.packetsSent(), (unsigned)mirror.packetsAccepted(),
+           (unsigned)mirror.packetsStale(), (unsigned)mirror.packetsLost(), (unsigned)mirror.lastJitterUs(),
+           (unsigned)mirror.playoutUs());
+  request->send(200, "application/json", json);
+}
+// --- End Mirroring ---
+
+// --- Motion Programs ---
+// The POST body may arrive in several pieces; it is put together in a buffer
+// owned by the request (freed with it)
+void collectProgramBody(AsyncWebServerRequest* request, uint8_t* data, size_t len, size_t index, size_t total) {
+  if (total > maxProgramBytes) return;
+  if (index == 0) request->_tempObject = malloc(total + 1);
+  char* text = (char*)request->_tempObject;
+  if (!text) return;
+  memcpy(text + index, data, len);
+  if (index + len == total) text[total] = '\0';
+}
+
+// Runs a motion program (G-code style, see MotionProgram.h) sent as the POST
+// body, or as ?p= with newlines encoded
+void handleProgram(AsyncWebServerRequest* request) {
+  if (request->contentLength() > maxProgramBytes) {
+    request->send(413, "text/plain", "Program too long.");
+    return;
+  }
+  const char* body = (const char*)request->_tempObject;
+  ProgramError error;
+  ArmStatus status = arm.runProgram(body ? body : request->arg("p").c_str(), error);
+  if (status == ARM_OK) {
+    char json[32];
+    snprintf(json, sizeof(json), "{\"moves\":%u}", (unsigned)motion.program().size());
+    request->send(200, "application/json", json);
+  } else if (status == ARM_INVALID) {
+    char reply[80];
+    snprintf(reply, sizeof(reply), "Line %u: %s", (unsigned)error.line, error.message);
+    request->send(400, "text/plain", reply);
+  } else if (status == ARM_EMPTY) {
+    request->send(400, "text/plain", "Program has no moves.");
+  } else if (status == ARM_BUSY) {
+    request->send(409, "text/plain", "Busy recording or playing.");
   } else {
-    servo.write(targetPos); // If already at target, ensure it's written
+    sendStatus(request, status);
   }
-  // Final write to ensure it reaches the exact target position,
-  // especially if step doesn't divide evenly.
-  if (currentServoPos != targetPos) { // Only if a move actually happened
-      servo.write(targetPos); 
+}
+
+void handleStopProgram(AsyncWebServerRequest* request) {
+  if (arm.stopProgram() != ARM_OK) {
+    request->send(409, "text/plain", "No program running.");
+    return;
   }
+  request->send(200, "text/plain", "Program stopped.");
 }
+// --- End Motion Programs ---
+
+// --- Sequence Library ---
+struct ListContext {
+  char* json;
+  size_t len;
+  size_t used;
+};
 
-void handleNotFound() {
-  server.send(404, "text/plain", "Not found");
+// Entries that don't fit are left out rather than cut in half
+void appendSequenceJson(const char* name, uint32_t poses, void* ctx) {
+  ListContext* list = (ListContext*)ctx;
+  char entry[64];
+  int n = snprintf(entry, sizeof(entry), "%s{\"name\":\"%s\",\"poses\":%u}",
+                   list->used > 1 ? "," : "", name, (unsigned)poses);
+  if (list->used + n + 2 > list->len) return; // Room for "]" and the terminator
+  memcpy(list->json + list->used, entry, n);
+  list->used += n;
+}
+
+void handleListSequences(AsyncWebServerRequest* request) {
+  static char json[1024];
+  ListContext list = {json, sizeof(json), 1};
+  json[0] = '[';
+  sequenceStore.list(appendSequenceJson, &list);
+  json[list.used++] = ']';
+  json[list.used] = '\0';
+  request->send(200, "application/json", json);
+}
+
+void handleSaveSequence(AsyncWebServerRequest* request) {
+  switch (arm.saveSequence(request->arg("name").c_str())) {
+    case ARM_OK:
+      request->send(200, "text/plain", "Sequence saved.");
+      break;
+    case ARM_INVALID:
+      request->send(400, "text/plain", "Invalid name (1-24 of A-Z a-z 0-9 _ -)");
+      break;
+    case ARM_BUSY:
+      request->send(409, "text/plain", "Stop recording first.");
+      break;
+    case ARM_EMPTY:
+      request->send(400, "text/plain", "No sequence recorded to save.");
+      break;
+    default:
+      request->send(500, "text/plain", "Could not write sequence to flash");
+      break;
+  }
+}
+
+// Loads a stored sequence into RAM so it can be played or re-saved
+void handleLoadSequence(AsyncWebServerRequest* request) {
+  switch (arm.loadSequence(request->arg("name").c_str())) {
+    case ARM_OK:
+      request->send(200, "text/plain", "Sequence loaded.");
+      break;
+    case ARM_BUSY:
+      request->send(409, "text/plain", "Busy recording or playing.");
+      break;
+    case ARM_NOT_FOUND:
+      request->send(404, "text/plain", "No such sequence.");
+      break;
+    default:
+      request->send(413, "text/plain", "Sequence too large or corrupt; play it by name instead.");
+      break;
+  }
+}
+// --- End Sequence Library ---
+// --- End New Handler Functions ---
+
+
+void handleNotFound(AsyncWebServerRequest* request) {
+  request->send(404, "text/plain", "Not found");
+}
+
+#if MEARM_METRICS
+void sendMetricsChunk(const char* data, size_t len, void* ctx) {
+  ((AsyncResponseStream*)ctx)->write((const uint8_t*)data, len);
+}
+
+// Prometheus text format. Counters are totals since boot; rates are for the
+// scraper to work out, except servo writes/s, averaged since the last scrape.
+void handleMetrics(AsyncWebServerRequest* request) {
+  MotionSnapshot snap;
+  motion.snapshot(snap);
+
+  // The stream response buffers the text (a few KB) and sends it once the
+  // handler returns
+  AsyncResponseStream* response = request->beginResponseStream("text/plain; version=0.0.4");
+  MetricsWriter out(sendMetricsChunk, response);
+
+  metrics.write(out);
+  out.histogram("mearm_motion_tick_jitter_microseconds",
+                "Lateness of each 200 Hz motion tick against its schedule.",
+                nullptr, motion.tickJitterHistogram());
+  out.gauge("mearm_motion_tick_jitter_max_microseconds", "Worst motion tick lateness since boot.",
+            snap.maxTickJitterUs);
+  out.counter("mearm_motion_ticks_total", "Motion engine ticks.", snap.ticks);
+  out.counter("mearm_servo_writes_total", "Servo pulse width updates.", snap.servoWrites);
+  out.gauge("mearm_servo_writes_per_second", "Servo writes per second since the previous scrape.",
+            servoWriteRate.sample(snap.servoWrites, millis()));
+
+  out.gauge("mearm_motion_queue_depth", "Commands waiting for the motion task.", motion.queueDepth());
+  out.gauge("mearm_motion_queue_high_water", "Deepest the motion queue has been.", motion.queueHighWater());
+  out.gauge("mearm_motion_queue_capacity", "Motion queue size.", motion.queueCapacity());
+  out.counter("mearm_motion_commands_applied_total", "Commands applied by the motion task.", snap.commandsApplied);
+  out.gauge("mearm_motion_command_latency_microseconds", "Queue-to-apply time of the last command.",
+            snap.lastCommandLatencyUs);
+  out.gauge("mearm_motion_command_latency_max_microseconds", "Worst queue-to-apply time since boot.",
+            snap.maxCommandLatencyUs);
+
+  out.counter("mearm_envelope_corrections_total", "Moves cut short, projected into or routed round the collision envelope.",
+              arm.envelopeCorrections());
+  out.counter("mearm_log_records_total", "Log records written out.", logRecordsWritten());
+  out.counter("mearm_log_dropped_total", "Log records dropped with the ring full.", logRecordsDropped());
+  out.counter("mearm_log_rate_limited_total", "Log records over their call site's rate limit.",
+              logRecordsRateLimited());
+  out.counter("mearm_ws_frames_accepted_total", "WebSocket slider and jog frames accepted.", controlChannel.acceptedCount());
+  out.counter("mearm_ws_frames_dropped_total", "WebSocket slider and jog frames dropped as stale or malformed.",
+              controlChannel.droppedCount());
+
+  out.gauge("mearm_serial_active", "1 while a host speaks the binary serial protocol.", serialLink.active());
+  out.counter("mearm_serial_frames_total", "Serial protocol frames received.", serialLink.framesReceived());
+  out.counter("mearm_serial_frame_errors_total", "Serial frames failing COBS, length or CRC checks.",
+              serialLink.frameErrors());
+  out.counter("mearm_serial_setpoints_dropped_total", "Streamed serial setpoints that couldn't be applied.",
+              serialLink.setpointsDropped());
+
+  out.counter("mearm_mirror_packets_sent_total", "Mirror packets multicast as leader.", mirror.packetsSent());
+  out.counter("mearm_mirror_packets_accepted_total", "Leader packets a follower used.", mirror.packetsAccepted());
+  out.counter("mearm_mirror_packets_stale_total", "Late or duplicate leader packets dropped.", mirror.packetsStale());
+  out.counter("mearm_mirror_packets_lost_total", "Gaps in the leader's sequence numbers.", mirror.packetsLost());
+  out.counter("mearm_mirror_packets_invalid_total", "Malformed packets, or from a second leader.",
+              mirror.packetsInvalid());
+  out.counter("mearm_mirror_extrapolations_total", "Follower periods past the newest sample.", mirror.extrapolations());
+  out.gauge("mearm_mirror_jitter_microseconds", "Arrival delay of the last packet beyond the fastest recent one.",
+            mirror.lastJitterUs());
+
+  out.gauge("mearm_events_clients", "Pages connected to /events.", events.clientCount());
+  out.counter("mearm_events_frames_total", "State frames pushed (each to every client).", events.framesSent());
+
+  uint32_t freeHeap = ESP.getFreeHeap();
+  uint32_t largestBlock = ESP.getMaxAllocHeap();
+  out.gauge("mearm_heap_free_bytes", "Free heap.", freeHeap);
+  out.gauge("mearm_heap_min_free_bytes", "Lowest free heap since boot.", ESP.getMinFreeHeap());
+  out.gauge("mearm_heap_largest_free_block_bytes", "Largest allocatable block.", largestBlock);
+  out.gauge("mearm_heap_fragmentation_ratio", "1 - largest free block / free heap.",
+            freeHeap ? 1.0f - (float)largestBlock / freeHeap : 0.0f);
+  out.gauge("mearm_uptime_seconds", "Time since boot.", millis() / 1000.0f);
+
+  out.flush();
+  request->send(response);
+}
+#endif
+
+// Registers a route whose handler runs under the arm lock, timing it when
+// metrics are enabled
+void addRoute(const char* path, ArRequestHandlerFunction handler, WebRequestMethodComposite method = HTTP_GET,
+              ArBodyHandlerFunction onBody = nullptr) {
+#if MEARM_METRICS
+  int id = metrics.addRoute(path);
+  server.on(path, method, [id, handler](AsyncWebServerRequest* request) {
+    ArmLock lock;
+    uint32_t start = micros();
+    handler(request);
+    metrics.observeRoute(id, micros() - start);
+  }, nullptr, onBody);
+#else
+  server.on(path, method, [handler](AsyncWebServerRequest* request) {
+    ArmLock lock;
+    handler(request);
+  }, nullptr, onBody);
+#endif
+}
+
+// One pass of the network task: control frames, serial commands, playback
+// sequencing, mirroring and state pushes
+void networkPoll() {
+  ArmLock lock;
+#if MEARM_METRICS
+  metrics.loopPass(micros());
+#endif
+  applyControlFrames();
+  serialLink.poll();
+  arm.update(); // Playback sequencing
+  runMirror();
+  broadcastState();
+}
+
+// Pinned next to the Wi-Fi stack (and the AsyncTCP task) so the motion task
+// has the other core to itself
+void networkTask(void*) {
+  for (;;) {
+    networkPoll();
+    vTaskDelay(1); // Let the idle task run so the watchdog stays quiet
+  }
 }
 
 void setup() {
   Serial.begin(115200);
   while (!Serial && millis() < 3000); // Wait for Serial up to 3s
   Serial.println();
-  Serial.println("Configuring Access Point...");
+  logBegin(); // Everything after goes through the log task, see Log.h
+  serialLink.begin();
+  LOG_INFO("Configuring Access Point...");
+
+  if (LittleFS.begin(true)) { // Formats the partition on first boot
+    arm.begin();
+  } else {
+    LOG_ERROR("LittleFS mount failed; sequences and home positions will not persist.");
+  }
 
+  if (cellSSID[0]) {
+    WiFi.mode(WIFI_AP_STA);
+    WiFi.begin(cellSSID, cellPassword); // Connects in the background
+    LOG_INFO("Joining %s for mirroring", cellSSID);
+  }
   WiFi.softAP(apSSID, apPassword);
-  IPAddress myIP = WiFi.softAPIP();
-  Serial.print("AP IP address: ");
-  Serial.println(myIP);
+  String myIP = WiFi.softAPIP().toString();
+  LOG_INFO("AP IP address: %s", myIP.c_str());
+
+  MotionEngine& engine = motion.engine();
+  servoDriver.begin();
+  engine.setDriver(&servoDriver);
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+    engine.setStartPosition((JointId)i, arm.position((JointId)i));
+    engine.setLimits((JointId)i, jointMaxSpeed[i], jointMaxAccel[i]);
+  }
+  engine.setJogGuard(jogGuard);
+
+  armMutex = xSemaphoreCreateMutex();
 
-  server.on("/", HTTP_GET, handleRoot);
-  server.on("/set_servo", HTTP_GET, handleSetServo);
-  server.on("/toggle_servo", HTTP_GET, handleToggleServo);
-  server.on("/save_settings", HTTP_GET, handleSaveSettings);
-  server.on("/go_home", HTTP_GET, handleGoHome);
+  addRoute("/", handleRoot);
+  addRoute("/state", handleState);
+  addRoute("/set_servo", handleSetServo);
+  addRoute("/toggle_servo", handleToggleServo);
+  addRoute("/save_settings", handleSaveSettings);
+  addRoute("/go_home", handleGoHome);
+  addRoute("/move_xyz", handleMoveXYZ);
+  addRoute("/jog", handleJog);
 
   // New routes for record and play
-  server.on("/toggle_record", HTTP_GET, handleToggleRecord);
-  server.on("/play_sequence", HTTP_GET, handlePlaySequence);
-  server.on("/delete_sequence", HTTP_GET, handleDeleteSequence);
+  addRoute("/toggle_record", handleToggleRecord);
+  addRoute("/play_sequence", handlePlaySequence);
+  addRoute("/pause_sequence", handlePauseSequence);
+  addRoute("/resume_sequence", handleResumeSequence);
+  addRoute("/stop_sequence", handleStopSequence);
+  addRoute("/sequence_speed", handleSequenceSpeed);
+  addRoute("/delete_sequence", handleDeleteSequence);
+  addRoute("/compress_sequence", handleCompressSequence);
+  addRoute("/sequences", handleListSequences);
+  addRoute("/save_sequence", handleSaveSequence);
+  addRoute("/load_sequence", handleLoadSequence);
+  addRoute("/program", handleProgram, HTTP_ANY, collectProgramBody);
+  addRoute("/stop_program", handleStopProgram);
+  addRoute("/mirror", handleMirror);
+#if MEARM_METRICS
+  addRoute("/metrics", handleMetrics);
+#endif
 
   server.onNotFound(handleNotFound);
 
+  webSocket.onEvent(webSocketEvent);
+  server.addHandler(&webSocket);
+  events.source().onConnect([](AsyncEventSourceClient* client) {
+    ArmLock lock;
+    events.replay(client);
+  });
+  server.addHandler(&events.source());
+
   server.begin();
-  Serial.println("HTTP server started");
-  Serial.println("Connect to Wi-Fi AP: " + String(apSSID));
-  Serial.println("Open http://" + myIP.toString() + " in your browser.");
+  LOG_INFO("HTTP server started");
+  if (mirrorUdp.listenMulticast(mirrorGroup, mirrorPort)) {
+    mirrorUdp.onPacket(mirrorPacket);
+  } else {
+    LOG_ERROR("Mirror socket failed; /mirror will not work.");
+  }
+  LOG_INFO("Connect to Wi-Fi AP: %s", apSSID);
+  LOG_INFO("Open http://%s in your browser.", myIP.c_str());
+
+  motion.begin();
+  xTaskCreatePinnedToCore(networkTask, "network", networkStackSize, nullptr, 1, nullptr, networkCore);
 }
 
 void loop() {
-  server.handleClient();
-  // delay(1); // Can be useful for stability with ESP32 background tasks
+  // Everything runs in networkTask and the motion task
+  vTaskDelete(NULL);
 }
\ No newline at end of file
@@ -0,0 +1,173 @@
+// Firmware benchmark on the host: per-endpoint latency, playback duration,
+// servo writes and heap use, each with a gate to catch regressions.
+// pio test -e native -f test_benchmark -v prints the numbers.
+
+#include <ArmSim.h>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+// Until playback ends; returns the simulated time it took
+static uint32_t runUntilStopped(uint32_t limitMs) {
+  uint32_t start = millis();
+  while (arm.playing() && millis() - start < limitMs) runMs(1);
+  return millis() - start;
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void enableArm() {
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+    if (!arm.enabled((JointId)i)) {
+      char url[32];
+      snprintf(url, sizeof(url), "/toggle_servo?joint=%u", i);
+      TEST_ASSERT_EQUAL_STRING("enabled", get(url).body.c_str());
+    }
+  }
+  runMs(1000);
+}
+
+// Host wall time per request, handler plus the stand-in's parsing. The host
+// is far faster than the ESP32; the gates catch a handler that suddenly does
+// much more work, not small drifts.
+struct Endpoint {
+  const char* url;
+  uint32_t p99GateUs;
+};
+
+static void test_endpoint_latency() {
+  enableArm();
+  const Endpoint endpoints[] = {
+      {"/", 500},
+      {"/state", 500},
+      {"/set_servo?joint=0&pos=100", 500},
+      {"/set_servo?servo=shoulder&pos=95", 500},
+      {"/move_xyz?x=0&y=150&z=120", 500},
+      {"/go_home", 500},
+      {"/sequences", 500},
+      {"/mirror", 500},
+      {"/metrics", 2000},
+  };
+  const int runs = 300;
+  for (const Endpoint& e : endpoints) {
+    std::vector<double> us;
+    for (int i = 0; i < runs; i++) {
+      auto start = std::chrono::steady_clock::now();
+      SimResponse r = get(e.url);
+      auto end = std::chrono::steady_clock::now();
+      TEST_ASSERT_EQUAL_INT_MESSAGE(200, r.code, e.url);
+      us.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+      runMs(5); // Lets the motion task drain what the request queued
+    }
+    std::sort(us.begin(), us.end());
+    double p50 = us[runs / 2], p99 = us[runs * 99 / 100];
+    report("%-36s p50 %6.1f us  p99 %6.1f us", e.url, p50, p99);
+    TEST_ASSERT_LESS_OR_EQUAL_MESSAGE(e.p99GateUs, (uint32_t)p99, e.url);
+  }
+}
+
+// Records a pick-and-place style sequence through the HTTP routes and plays
+// it back on the simulated clock
+static void recordSequence() {
+  get("/delete_sequence");
+  TEST_ASSERT_EQUAL_STRING("RECORDING_STARTED", get("/toggle_record").body.c_str());
+  const int poses[][JOINT_COUNT] = {
+      {90, 90, 90, 90}, {30, 100, 70, 90}, {30, 110, 60, 150}, {30, 90, 80, 150},
+      {150, 90, 80, 150}, {150, 110, 60, 60}, {150, 90, 90, 60}, {90, 90, 90, 90},
+  };
+  for (const auto& pose : poses) {
+    for (uint8_t j = 0; j < JOINT_COUNT; j++) {
+      char url[48];
+      snprintf(url, sizeof(url), "/set_servo?joint=%u&pos=%d", j, pose[j]);
+      TEST_ASSERT_EQUAL_INT(200, get(url).code);
+    }
+    runMs(1000);
+  }
+  TEST_ASSERT_EQUAL_STRING("RECORDING_STOPPED", get("/toggle_record").body.c_str());
+}
+
+static void test_playback_duration_and_servo_writes() {
+  enableArm();
+  recordSequence();
+  size_t poses = arm.recordedSequence().size();
+  TEST_ASSERT_GREATER_THAN(4, poses);
+
+  MotionSnapshot before, after;
+  motion.snapshot(before);
+  uint32_t ledcBefore = simLedcUpdateCalls();
+  TEST_ASSERT_EQUAL_STRING("PLAYBACK_STARTED", get("/play_sequence").body.c_str());
+  uint32_t ms = runUntilStopped(60000);
+  motion.snapshot(after);
+  TEST_ASSERT_FALSE(arm.playing());
+
+  uint32_t ticks = after.ticks - before.ticks;
+  uint32_t writes = after.servoWrites - before.servoWrites;
+  uint32_t ledcWrites = simLedcUpdateCalls() - ledcBefore;
+  report("playback: %u poses in %u ms, %u ticks, %u servo writes (%u LEDC updates)", (unsigned)poses,
+         (unsigned)ms, (unsigned)ticks, (unsigned)writes, (unsigned)ledcWrites);
+
+  // Joints move together on trapezoidal profiles; 10.1 s when this was written
+  TEST_ASSERT_LESS_OR_EQUAL(11000, ms);
+  // One LEDC update per joint whose pulse changed, never more than 4 a tick
+  TEST_ASSERT_EQUAL_UINT32(writes, ledcWrites);
+  TEST_ASSERT_LESS_OR_EQUAL(ticks * JOINT_COUNT, writes);
+  TEST_ASSERT_GREATER_THAN(0, writes);
+
+  // Twice as fast takes about half as long
+  TEST_ASSERT_EQUAL_INT(200, get("/play_sequence?speed=2").code);
+  uint32_t fastMs = runUntilStopped(60000);
+  report("playback at 2x: %u ms", (unsigned)fastMs);
+  TEST_ASSERT_LESS_OR_EQUAL(ms * 6 / 10, fastMs);
+}
+
+// Operator new calls per request (including the stand-in's response object
+// and header strings) and per control-loop pass. Nothing the motion or
+// network task does per pass may allocate.
+struct AllocationGate {
+  const char* url;
+  uint32_t maxAllocations;
+};
+
+static void test_heap_allocations() {
+  enableArm();
+  const AllocationGate gates[] = {
+      {"/", 8},
+      {"/state", 6},
+      {"/set_servo?joint=0&pos=60", 1},
+      {"/go_home", 3},
+      {"/sequences", 3},
+      {"/metrics", 9},
+  };
+  for (const AllocationGate& g : gates) {
+    SimHeapStats before = simHeapStats();
+    {
+      SimResponse r = get(g.url);
+      TEST_ASSERT_EQUAL_INT_MESSAGE(200, r.code, g.url);
+      report("%-28s %u allocations", g.url, (unsigned)r.allocations);
+      TEST_ASSERT_LESS_OR_EQUAL_MESSAGE(g.maxAllocations, r.allocations, g.url);
+    }
+    runMs(5);
+    // Everything the request allocated has been given back
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(before.liveBytes, simHeapStats().liveBytes, g.url);
+  }
+
+  // Control loop during playback: no allocations at all
+  get("/play_sequence?loops=0");
+  runMs(100);
+  SimHeapStats before = simHeapStats();
+  runMs(2000);
+  SimHeapStats after = simHeapStats();
+  get("/stop_sequence");
+  report("2 s of playback: %u allocations", (unsigned)(after.allocations - before.allocations));
+  TEST_ASSERT_EQUAL_UINT32(before.allocations, after.allocations);
+}
+
+int main() {
+  setup();
+  UNITY_BEGIN();
+  RUN_TEST(test_endpoint_latency);
+  RUN_TEST(test_playback_duration_and_servo_writes);
+  RUN_TEST(test_heap_allocations);
+  return UNITY_END();
+}
@@ -0,0 +1,354 @@
+// The collision envelope: the generated bitmap against a brute-force check
+// of the geometry, straight lines between allowed poses against dense
+// sampling, and the arm refusing or routing round moves whose ends are
+// allowed but whose middle is not (Cartesian moves, playback and programs).
+// Most such pairs lie in the bitmap's two separate regions, which no path joins.
+// pio test -e native -f test_envelope -v prints the numbers.
+
+#include <ArmSim.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Envelope.h"
+#include "Kinematics.h"
+
+static const float maxSpeed[JOINT_COUNT] = {120, 100, 100, 180}; // jointMaxSpeed in main.cpp
+static const float maxAccel[JOINT_COUNT] = {600, 400, 400, 900}; // jointMaxAccel
+
+static uint32_t seed = 1;
+static int randomDegree() {
+  seed = seed * 1103515245 + 12345;
+  return (seed >> 8) % 181;
+}
+
+static void randomAllowed(int& shoulder, int& elbow) {
+  do {
+    shoulder = randomDegree();
+    elbow = randomDegree();
+  } while (!envelopeAllows(shoulder, elbow));
+}
+
+// tools/build_envelope.py: segment a-b through |r| < rMax, z < zMax (Liang-Barsky)
+static bool crossesBox(const double a[2], const double b[2], double rMax, double zMax) {
+  double t0 = 0, t1 = 1;
+  double dr = b[0] - a[0], dz = b[1] - a[1];
+  const double p[3] = {-dr, dr, dz}, q[3] = {a[0] + rMax, rMax - a[0], zMax - a[1]};
+  for (int i = 0; i < 3; i++) {
+    if (p[i] == 0) {
+      if (q[i] <= 0) return false;
+    } else if (p[i] < 0) {
+      t0 = fmax(t0, q[i] / p[i]);
+    } else {
+      t1 = fmin(t1, q[i] / p[i]);
+    }
+  }
+  return t0 < t1;
+}
+
+// tools/build_envelope.py: one pose in the arm's vertical plane (r, z)
+static bool geometryAllows(int shoulder, int elbow) {
+  double forearm = elbow - ARM_ELBOW_LEVEL / 100.0;
+  double bend = fabs(fmod(fmod(shoulder - forearm + 180, 360) + 360, 360) - 180);
+  double link = 180 - bend;
+  if (link < ARM_LINK_MIN_ANGLE / 100.0 || link > ARM_LINK_MAX_ANGLE / 100.0) return false;
+
+  double s = shoulder * M_PI / 180, f = forearm * M_PI / 180;
+  double pts[4][2] = {{0, (double)ARM_SHOULDER_HEIGHT}};
+  pts[1][0] = pts[0][0] + ARM_UPPER_LENGTH * cos(s);
+  pts[1][1] = pts[0][1] + ARM_UPPER_LENGTH * sin(s);
+  pts[2][0] = pts[1][0] + ARM_FOREARM_LENGTH * cos(f);
+  pts[2][1] = pts[1][1] + ARM_FOREARM_LENGTH * sin(f);
+  pts[3][0] = pts[2][0] + ARM_GRIPPER_LENGTH;
+  pts[3][1] = pts[2][1];
+  for (int i = 0; i < 3; i++) {
+    if (fmin(pts[i][1], pts[i + 1][1]) < ARM_TABLE_CLEARANCE) return false;
+    if (crossesBox(pts[i], pts[i + 1], ARM_BASE_RADIUS, ARM_BASE_TOP)) return false;
+  }
+  return true;
+}
+
+// Cells the rounded position visits along the line, sampled finely enough
+// to land inside every one: the crossings are all multiples of 1/(2|ds||de|)
+static bool sampledLineAllows(int s0, int e0, int s1, int e1) {
+  int64_t ds = s1 - s0, de = e1 - e0;
+  int64_t n = 4 * (ds ? llabs(ds) : 1) * (de ? llabs(de) : 1);
+  for (int64_t i = 0; i <= n; i++) {
+    // Rounded halves away from zero, in integers so corners are exact
+    int s = (int)((2 * (s0 * n + i * ds) + n) / (2 * n));
+    int e = (int)((2 * (e0 * n + i * de) + n) / (2 * n));
+    if (!envelopeAllows(s, e)) return false;
+  }
+  return true;
+}
+
+// runMs(), but false if the rounded shoulder/elbow ever leaves the envelope
+static bool runMsInside(uint32_t ms) {
+  bool inside = true;
+  for (uint32_t i = 0; i < ms; i++) {
+    simAdvanceMicros(1000);
+    if (simMicros() % MotionEngine::TICK_INTERVAL_US == 0) {
+      motion.step(micros());
+      MotionSnapshot snap;
+      motion.snapshot(snap);
+      if (!envelopeAllows(snap.position[JOINT_SHOULDER], snap.position[JOINT_ELBOW])) inside = false;
+    }
+    networkPoll();
+  }
+  return inside;
+}
+
+static bool runUntilIdle() {
+  bool inside = true;
+  for (int i = 0; i < 60 && !(arm.playing() == false && motion.isIdle()); i++) inside &= runMsInside(500);
+  return inside;
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_bitmap_matches_geometry() {
+  int allowed = 0, mismatched = 0;
+  for (int s = 0; s <= 180; s++) {
+    for (int e = 0; e <= 180; e++) {
+      bool expected = geometryAllows(s, e);
+      if (expected != envelopeAllows(s, e)) mismatched++;
+      allowed += expected;
+    }
+  }
+  report("%d of 32761 poses allowed, %d mismatched", allowed, mismatched);
+  TEST_ASSERT_EQUAL_INT(0, mismatched);
+  TEST_ASSERT_FALSE(envelopeAllows(-1, 90));
+  TEST_ASSERT_FALSE(envelopeAllows(90, 181));
+}
+
+// Which connected region of the bitmap each allowed pose is in (-1 for
+// none); poses in different regions have no path between them at all
+static int8_t region[181][181];
+static int regionCount = 0;
+
+static void labelRegions() {
+  static int16_t stack[181 * 181][2];
+  memset(region, -1, sizeof(region));
+  for (int s = 0; s <= 180; s++) {
+    for (int e = 0; e <= 180; e++) {
+      if (!envelopeAllows(s, e) || region[s][e] >= 0) continue;
+      int top = 0;
+      region[s][e] = regionCount;
+      stack[top][0] = s;
+      stack[top++][1] = e;
+      while (top > 0) {
+        top--;
+        int cs = stack[top][0], ce = stack[top][1];
+        const int next[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+        for (const int* d : next) {
+          int ns = cs + d[0], ne = ce + d[1];
+          if (!envelopeAllows(ns, ne) || region[ns][ne] >= 0) continue;
+          region[ns][ne] = regionCount;
+          stack[top][0] = ns;
+          stack[top++][1] = ne;
+        }
+      }
+      regionCount++;
+    }
+  }
+}
+
+// The exact walk agrees with sampling on every line; how many lines between
+// two allowed poses leave the envelope, how many of those join separate
+// regions, and how many of the rest a corner fixes
+static void test_lines_against_sampling() {
+  labelRegions();
+  const int pairs = 2000;
+  int crossing = 0, apart = 0, detoured = 0;
+  for (int i = 0; i < pairs; i++) {
+    int s0, e0, s1, e1;
+    randomAllowed(s0, e0);
+    randomAllowed(s1, e1);
+    bool clear = envelopeAllowsLine(s0, e0, s1, e1);
+    TEST_ASSERT_EQUAL(sampledLineAllows(s0, e0, s1, e1), clear);
+    TEST_ASSERT_EQUAL(clear, envelopeAllowsLine(s1, e1, s0, e0)); // Same cells either way
+    if (clear) continue;
+    crossing++;
+    int vs, ve;
+    if (region[s0][e0] != region[s1][e1]) {
+      apart++;
+      TEST_ASSERT_FALSE(envelopeDetour(s0, e0, s1, e1, vs, ve));
+    } else if (envelopeDetour(s0, e0, s1, e1, vs, ve)) {
+      detoured++;
+      TEST_ASSERT_TRUE(sampledLineAllows(s0, e0, vs, ve));
+      TEST_ASSERT_TRUE(sampledLineAllows(vs, ve, s1, e1));
+    }
+  }
+  report("%d regions; %d of %d lines between allowed poses leave the envelope (%.0f%%), %d of them between regions, "
+         "%d go round a corner",
+         regionCount, crossing, pairs, 100.0 * crossing / pairs, apart, detoured);
+  TEST_ASSERT_GREATER_THAN(0, crossing);
+}
+
+// Shoulder/elbow that solveIK() picks for the pose's own FK point, as moveXYZ() rounds them
+static bool xyzFor(int shoulder, int elbow, ArmPoint& p, int& s, int& e) {
+  ArmAngles a = {9000, shoulder * 100, elbow * 100};
+  forwardKinematics(a, p);
+  if (!solveIK(p, a)) return false;
+  s = (a.shoulder + 50) / 100;
+  e = (a.elbow + 50) / 100;
+  return envelopeAllows(s, e);
+}
+
+static void test_move_xyz_refuses_crossing() {
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+    bool on;
+    if (!arm.enabled((JointId)i)) TEST_ASSERT_EQUAL(ARM_OK, arm.toggleJoint((JointId)i, on));
+  }
+  runUntilIdle();
+
+  // A reachable pose clear of where the arm is, and one whose line from it isn't
+  int here[2] = {arm.position(JOINT_SHOULDER), arm.position(JOINT_ELBOW)};
+  ArmPoint a, b;
+  int as = 0, ae = 0, bs = 0, be = 0;
+  bool found = false;
+  for (int tries = 0; tries < 100000 && !found; tries++) {
+    int s, e;
+    randomAllowed(s, e);
+    if (!xyzFor(s, e, a, as, ae) || !envelopeAllowsLine(here[0], here[1], as, ae)) continue;
+    randomAllowed(s, e);
+    found = xyzFor(s, e, b, bs, be) && !envelopeAllowsLine(as, ae, bs, be);
+  }
+  TEST_ASSERT_TRUE(found);
+
+  int out[JOINT_COUNT];
+  TEST_ASSERT_EQUAL(ARM_OK, arm.moveXYZ(a, out));
+  TEST_ASSERT_TRUE(runUntilIdle());
+  TEST_ASSERT_EQUAL(ARM_UNSAFE, arm.moveXYZ(b, out));
+  TEST_ASSERT_EQUAL_INT(as, arm.position(JOINT_SHOULDER));
+  TEST_ASSERT_EQUAL_INT(ae, arm.position(JOINT_ELBOW));
+  TEST_ASSERT_TRUE(motion.isIdle());
+}
+
+// A pair in the same region whose line leaves the envelope but a corner doesn't
+static bool findDetour(int from[2], int to[2]) {
+  for (int tries = 0; tries < 1000000; tries++) {
+    int vs, ve;
+    randomAllowed(from[0], from[1]);
+    randomAllowed(to[0], to[1]);
+    if (region[from[0]][from[1]] == region[to[0]][to[1]] && !envelopeAllowsLine(from[0], from[1], to[0], to[1]) &&
+        envelopeDetour(from[0], from[1], to[0], to[1], vs, ve)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Recorded poses with a collision between two of them, then one in the other
+// region: every tick stays inside, the arm goes round the first and stops
+// before the second
+static void test_playback_goes_round() {
+  int a[2], b[2];
+  TEST_ASSERT_TRUE(findDetour(a, b));
+  TEST_ASSERT_TRUE(envelopeAllowsLine(arm.position(JOINT_SHOULDER), arm.position(JOINT_ELBOW), a[0], a[1]));
+  int c[2];
+  do {
+    randomAllowed(c[0], c[1]);
+  } while (region[c[0]][c[1]] == region[b[0]][b[1]]);
+
+  TEST_ASSERT_EQUAL(ARM_OK, arm.beginUpload());
+  const int* poses[3] = {a, b, c};
+  for (const int* p : poses) {
+    PackedPose pose = {{90, (uint8_t)p[0], (uint8_t)p[1], 90}, 0};
+    TEST_ASSERT_EQUAL(ARM_OK, arm.uploadPose(pose));
+  }
+  uint32_t corrections = arm.envelopeCorrections();
+  TEST_ASSERT_EQUAL(ARM_OK, arm.play(nullptr));
+  TEST_ASSERT_TRUE(runUntilIdle());
+  TEST_ASSERT_FALSE(arm.playing());
+  TEST_ASSERT_EQUAL_INT(b[0], arm.position(JOINT_SHOULDER));
+  TEST_ASSERT_EQUAL_INT(b[1], arm.position(JOINT_ELBOW));
+  TEST_ASSERT_EQUAL_UINT32(corrections + 2, arm.envelopeCorrections());
+  report("played S%d E%d -> S%d E%d round a corner, stopped before S%d E%d", a[0], a[1], b[0], b[1], c[0], c[1]);
+}
+
+// One G1 per point
+static void programText(char* text, size_t len, const int (*points)[2], int count) {
+  size_t n = 0;
+  for (int i = 0; i < count; i++) n += snprintf(text + n, len - n, "G1 S%d E%d\n", points[i][0], points[i][1]);
+}
+
+// Straight moves through the envelope are refused when parsed; the planned
+// path is checked from where the arm actually is, and random programs of
+// clear moves run with every tick inside
+static void test_programs() {
+  MotionProgram& program = motion.program();
+  static BlendPath scratch;
+  ProgramError error;
+  TEST_ASSERT_TRUE(motion.isIdle());
+  int start[JOINT_COUNT];
+  float from[JOINT_COUNT];
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) from[i] = start[i] = arm.position((JointId)i);
+  int here = region[start[JOINT_SHOULDER]][start[JOINT_ELBOW]];
+
+  int points[4][2];
+  char text[128];
+  do {
+    randomAllowed(points[0][0], points[0][1]);
+    randomAllowed(points[1][0], points[1][1]);
+  } while (!envelopeAllowsLine(start[JOINT_SHOULDER], start[JOINT_ELBOW], points[0][0], points[0][1]) ||
+           envelopeAllowsLine(points[0][0], points[0][1], points[1][0], points[1][1]));
+  programText(text, sizeof(text), points, 2);
+  TEST_ASSERT_EQUAL(ARM_INVALID, arm.runProgram(text, error));
+  TEST_ASSERT_EQUAL_UINT16(2, error.line);
+  TEST_ASSERT_EQUAL_STRING("Move would pass through the table or base", error.message);
+
+  // Parsed from the commanded pose, but the arm is somewhere else: still in
+  // the other region, say, on its way back
+  programText(text, sizeof(text), points, 1);
+  TEST_ASSERT_TRUE(program.parse(text, start, error));
+  float elsewhere[JOINT_COUNT] = {90, 0, 0, 90};
+  do {
+    int s, e;
+    randomAllowed(s, e);
+    elsewhere[JOINT_SHOULDER] = s;
+    elsewhere[JOINT_ELBOW] = e;
+  } while (region[(int)elsewhere[JOINT_SHOULDER]][(int)elsewhere[JOINT_ELBOW]] == here);
+  TEST_ASSERT_FALSE(program.checkPath(elsewhere, maxSpeed, maxAccel, scratch, error));
+  TEST_ASSERT_EQUAL_UINT16(1, error.line);
+  TEST_ASSERT_EQUAL_STRING("Path near this move would hit the table or base", error.message);
+  TEST_ASSERT_TRUE(program.checkPath(from, maxSpeed, maxAccel, scratch, error));
+  program.clear();
+
+  // Blended programs of clear moves: the check and the arm agree
+  int ran = 0, refused = 0;
+  for (int n = 0; n < 20; n++) {
+    int s = start[JOINT_SHOULDER], e = start[JOINT_ELBOW];
+    for (int i = 0; i < 4; i++) {
+      do {
+        randomAllowed(points[i][0], points[i][1]);
+      } while (!envelopeAllowsLine(s, e, points[i][0], points[i][1]));
+      s = points[i][0];
+      e = points[i][1];
+    }
+    programText(text, sizeof(text), points, 4);
+    ArmStatus status = arm.runProgram(text, error);
+    if (status != ARM_OK) {
+      TEST_ASSERT_EQUAL(ARM_INVALID, status);
+      refused++;
+      continue;
+    }
+    ran++;
+    TEST_ASSERT_TRUE(runUntilIdle());
+    TEST_ASSERT_EQUAL_INT(points[3][0], arm.position(JOINT_SHOULDER));
+    for (uint8_t i = 0; i < JOINT_COUNT; i++) start[i] = arm.position((JointId)i);
+  }
+  report("%d blended programs ran inside the envelope, %d refused for their corners", ran, refused);
+  TEST_ASSERT_GREATER_THAN(0, ran);
+}
+
+int main() {
+  setup();
+  UNITY_BEGIN();
+  RUN_TEST(test_bitmap_matches_geometry);
+  RUN_TEST(test_lines_against_sampling);
+  RUN_TEST(test_move_xyz_refuses_crossing);
+  RUN_TEST(test_playback_goes_round);
+  RUN_TEST(test_programs);
+  return UNITY_END();
+}
@@ -0,0 +1,130 @@
+// State pushes over /events: frames per second, the cost of a network loop
+// pass as pages are added, one serialization per frame however many pages
+// listen, and what an idle stream sends.
+// pio test -e native -f test_event_stream -v prints the numbers.
+
+#include <ArmSim.h>
+#include <chrono>
+#include <vector>
+#include "EventStream.h"
+
+// From src/main.cpp
+extern EventStream events;
+
+typedef std::chrono::steady_clock Clock;
+
+static const uint32_t RATE_HZ = 10; // eventRateHz in main.cpp
+
+// runMs(), returning the host time spent in the network task
+static double runMsTimed(uint32_t ms) {
+  double us = 0;
+  for (uint32_t i = 0; i < ms; i++) {
+    simAdvanceMicros(1000);
+    if (simMicros() % MotionEngine::TICK_INTERVAL_US == 0) motion.step(micros());
+    auto start = Clock::now();
+    networkPoll();
+    us += std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+  }
+  return us;
+}
+
+static std::vector<AsyncEventSourceClient*> clients;
+
+static void connect(size_t count) {
+  while (clients.size() < count) clients.push_back(events.source().simConnect());
+}
+
+static void disconnectAll() {
+  for (AsyncEventSourceClient* client : clients) events.source().simDisconnect(client);
+  clients.clear();
+}
+
+void setUp() {}
+void tearDown() {
+  disconnectAll();
+}
+
+// The base sweeps back and forth so every frame carries new positions
+static uint32_t sweepStep = 0;
+static double sweepMs(uint32_t ms) {
+  double us = 0;
+  for (uint32_t t = 0; t < ms; t += 100) {
+    char url[40];
+    snprintf(url, sizeof(url), "/set_servo?joint=0&pos=%u", (unsigned)(sweepStep++ % 2 ? 40 : 140));
+    TEST_ASSERT_EQUAL_INT(200, get(url).code);
+    us += runMsTimed(100);
+  }
+  return us;
+}
+
+static void test_rate_and_shared_frames() {
+  if (!arm.enabled(JOINT_BASE)) TEST_ASSERT_EQUAL_STRING("enabled", get("/toggle_servo?joint=0").body.c_str());
+  connect(3);
+  uint32_t formatted = events.source().simFormatted();
+  uint32_t sent = events.framesSent();
+  sweepMs(5000);
+  uint32_t frames = events.framesSent() - sent;
+  report("5 s of motion: %u frames to %u pages", (unsigned)frames, (unsigned)clients.size());
+  TEST_ASSERT_UINT32_WITHIN(2, 5 * RATE_HZ, frames);
+  // Formatted once each, and every page got the same bytes
+  TEST_ASSERT_EQUAL_UINT32(frames, events.source().simFormatted() - formatted);
+  for (AsyncEventSourceClient* client : clients) {
+    TEST_ASSERT_EQUAL_UINT32(clients[0]->simBytes(), client->simBytes());
+    TEST_ASSERT_EQUAL_STRING(clients[0]->simLastMessage().c_str(), client->simLastMessage().c_str());
+  }
+}
+
+// Network loop time per simulated second of motion as pages are added. The
+// frame is built and formatted once; only the per-page write grows.
+static void test_cost_per_client_count() {
+  const size_t counts[] = {1, 4, 16, 64};
+  double baseUs = 0;
+  for (size_t count : counts) {
+    connect(count);
+    sweepMs(1000); // Warm up at this count
+    uint32_t sent = events.framesSent();
+    double us = sweepMs(10000);
+    uint32_t frames = events.framesSent() - sent;
+    report("%2u pages: %.1f us of network loop per second of motion, %u frames, %u bytes each",
+           (unsigned)count, us / 10, (unsigned)frames, (unsigned)clients[0]->simLastMessage().size());
+    if (count == 1) baseUs = us;
+    // Far from 64 times one page's cost
+    if (count == 64) TEST_ASSERT_TRUE(us < 2 * baseUs);
+    disconnectAll();
+  }
+}
+
+// An idle stream: nothing until the heartbeat, which repeats the whole
+// last frame; a new page gets the last frame straight away
+static void test_idle_heartbeat() {
+  runMs(2000); // Let the arm settle
+  connect(1);
+  runMs(1000);
+  AsyncEventSourceClient* page = clients[0];
+  uint32_t messages = page->simMessages();
+  std::string last = page->simLastMessage();
+
+  runMs(EventStream::HEARTBEAT_MS - 1500);
+  TEST_ASSERT_EQUAL_UINT32(messages, page->simMessages());
+  runMs(1000);
+  TEST_ASSERT_EQUAL_UINT32(messages + 1, page->simMessages());
+  size_t heartbeat = page->simLastMessage().size();
+  report("idle: one %u byte heartbeat every %u s", (unsigned)heartbeat, (unsigned)(EventStream::HEARTBEAT_MS / 1000));
+  // Same event and data; only the id moves on
+  TEST_ASSERT_TRUE(page->simLastMessage().substr(page->simLastMessage().find("event:")) ==
+                   last.substr(last.find("event:")));
+
+  AsyncEventSourceClient* late = events.source().simConnect();
+  clients.push_back(late);
+  TEST_ASSERT_EQUAL_UINT32(1, late->simMessages());
+  TEST_ASSERT_TRUE(late->simLastMessage().find("retry: 1000") != std::string::npos);
+}
+
+int main() {
+  setup();
+  UNITY_BEGIN();
+  RUN_TEST(test_rate_and_shared_frames);
+  RUN_TEST(test_cost_per_client_count);
+  RUN_TEST(test_idle_heartbeat);
+  return UNITY_END();
+}
@@ -0,0 +1,282 @@
+// Jogging on the simulated clock: /jog commands through the network and
+// motion tasks at 200 Hz, with each tick's angle read back from the servo
+// pulse (about 1/35 degree). Checks the acceleration limits, the stop after
+// a release or a silent client, the end stops, lost commands and the
+// collision envelope. pio test -e native -f test_jog -v prints the numbers.
+
+#include <ArmSim.h>
+#include <math.h>
+#include <vector>
+#include "Envelope.h"
+#include "ServoDriver.h"
+
+// From src/main.cpp
+bool jogGuard(const float positions[JOINT_COUNT]);
+extern ServoDriver servoDriver;
+
+static const float TICK_SEC = MotionEngine::TICK_INTERVAL_US / 1e6f;
+
+// The joint's angle from its servo pulse, undoing the joint table
+static float angle(JointId joint) {
+  const JointConfig& cfg = servoDriver.config(joint);
+  float pulse = servoDriver.duty(joint) * (float)ServoDriver::PERIOD_US / (1UL << ServoDriver::RESOLUTION_BITS);
+  float a = (pulse - cfg.minUs) * 180 / (cfg.maxUs - cfg.minUs) - cfg.offsetDeg;
+  return cfg.direction < 0 ? 180 - a : a;
+}
+
+// One angle of `traced` per tick
+static JointId traced = JOINT_BASE;
+static std::vector<float> trace;
+
+// runMs(), adding to the trace every tick
+static void runMsTraced(uint32_t ms) {
+  for (uint32_t i = 0; i < ms; i++) {
+    simAdvanceMicros(1000);
+    if (simMicros() % MotionEngine::TICK_INTERVAL_US == 0) {
+      motion.step(micros());
+      trace.push_back(angle(traced));
+    }
+    networkPoll();
+  }
+}
+
+// Sends /jog with `v` for `joint` and nothing for the others
+static void jog(JointId joint, float v) {
+  float velocities[JOINT_COUNT] = {};
+  velocities[joint] = v;
+  char url[64];
+  snprintf(url, sizeof(url), "/jog?v=%g,%g,%g,%g", velocities[0], velocities[1], velocities[2], velocities[3]);
+  TEST_ASSERT_EQUAL_STRING("OK", get(url).body.c_str());
+}
+
+// Velocity at tick k over the 20 ms before it. The pulse is within 1/70
+// degree of the angle, so this is within 1.5 deg/s.
+static const size_t V_TICKS = 4;
+static float velocityAt(size_t k) {
+  return (trace[k] - trace[k - V_TICKS]) / (V_TICKS * TICK_SEC);
+}
+
+// Largest change of velocity over 100 ms windows (within 30 deg/s^2)
+static float peakAccel(size_t from, size_t to) {
+  const size_t window = 20;
+  float peak = 0;
+  for (size_t k = from + V_TICKS; k + window < to; k++) {
+    float a = fabsf(velocityAt(k + window) - velocityAt(k)) / (window * TICK_SEC);
+    if (a > peak) peak = a;
+  }
+  return peak;
+}
+
+// Ticks from `from` until the joint last moved
+static size_t ticksToRest(size_t from) {
+  size_t last = from;
+  for (size_t k = from + 1; k < trace.size(); k++) {
+    if (fabsf(trace[k] - trace[k - 1]) > 0.001f) last = k;
+  }
+  return last - from;
+}
+
+// Jogs `joint` at `v` with a command every 100 ms for `ms`, skipping every
+// `skip`-th command (0 for none). Returns the trace index of the last one.
+static size_t hold(JointId joint, float v, uint32_t ms, uint32_t skip = 0) {
+  size_t last = trace.size();
+  for (uint32_t t = 0, n = 0; t < ms; t += 100, n++) {
+    if (!skip || n % skip != skip - 1) {
+      jog(joint, v);
+      last = trace.size();
+    }
+    runMsTraced(100);
+  }
+  return last;
+}
+
+static void moveTo(JointId joint, int position) {
+  char url[48];
+  snprintf(url, sizeof(url), "/set_servo?joint=%u&pos=%d", (unsigned)joint, position);
+  TEST_ASSERT_EQUAL_STRING("OK", get(url).body.c_str());
+  runMsTraced(3000);
+  TEST_ASSERT_EQUAL_INT(position, arm.position(joint));
+}
+
+void setUp() {
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+    bool on;
+    if (!arm.enabled((JointId)i)) TEST_ASSERT_EQUAL(ARM_OK, arm.toggleJoint((JointId)i, on));
+  }
+  runMsTraced(20);
+}
+
+void tearDown() {
+  jog(JOINT_BASE, 0);
+  runMsTraced(1000);
+}
+
+// Held at the base's top speed at the 10 Hz a page resends, then released:
+// up to speed and back down within the acceleration limit
+static void test_ramp_and_release() {
+  const MotionEngine& eng = motion.engine();
+  moveTo(JOINT_BASE, 60);
+  traced = JOINT_BASE;
+  trace.clear();
+  runMsTraced(20);
+  size_t start = trace.size();
+  hold(JOINT_BASE, 120, 600);
+  float top = velocityAt(trace.size() - 1);
+  size_t released = trace.size();
+  jog(JOINT_BASE, 0);
+  runMsTraced(1000);
+
+  float accel = peakAccel(start, trace.size());
+  size_t restTicks = ticksToRest(released);
+  report("base at 120 deg/s: top speed %.1f deg/s, peak acceleration %.0f deg/s^2 (limit %.0f)", top, accel,
+         eng.maxAccel(JOINT_BASE));
+  report("  stopped %u ms after the release (%.0f ms at the limit), %.1f deg on", (unsigned)(restTicks * 5),
+         eng.maxSpeed(JOINT_BASE) / eng.maxAccel(JOINT_BASE) * 1000, trace.back() - trace[released]);
+  TEST_ASSERT_FLOAT_WITHIN(2, eng.maxSpeed(JOINT_BASE), top);
+  TEST_ASSERT_TRUE(accel < eng.maxAccel(JOINT_BASE) + 30);
+  TEST_ASSERT_TRUE(accel > eng.maxAccel(JOINT_BASE) - 30);
+  // The stop is applied on the next tick, then takes speed / acceleration
+  TEST_ASSERT_TRUE(restTicks * TICK_SEC <= eng.maxSpeed(JOINT_BASE) / eng.maxAccel(JOINT_BASE) + 2 * TICK_SEC);
+  TEST_ASSERT_EQUAL_INT(lroundf(trace.back()), arm.position(JOINT_BASE));
+}
+
+// A client that goes quiet without a release: the dead-man timer starts
+// the same ramp down ArmController::JOG_DEADMAN_MS after the last command
+static void test_deadman() {
+  const MotionEngine& eng = motion.engine();
+  moveTo(JOINT_BASE, 150);
+  traced = JOINT_BASE;
+  trace.clear();
+  runMsTraced(20);
+  size_t last = hold(JOINT_BASE, -60, 500);
+  runMsTraced(1000);
+
+  size_t slowing = last;
+  while (slowing < trace.size() && velocityAt(slowing) < -60 + 3) slowing++;
+  // velocityAt() lags by half its window
+  float deadmanMs = (slowing - last) * 5.0f - V_TICKS * 5 / 2;
+  size_t restTicks = ticksToRest(last);
+  report("silent client: slowing %.0f ms after the last command (dead-man %u ms), at rest after %u ms", deadmanMs,
+         (unsigned)ArmController::JOG_DEADMAN_MS, (unsigned)(restTicks * 5));
+  TEST_ASSERT_FLOAT_WITHIN(15, ArmController::JOG_DEADMAN_MS, deadmanMs);
+  float restSec = ArmController::JOG_DEADMAN_MS / 1000.0f + 60 / eng.maxAccel(JOINT_BASE);
+  TEST_ASSERT_TRUE(restTicks * TICK_SEC <= restSec + 2 * TICK_SEC);
+  TEST_ASSERT_TRUE(peakAccel(0, trace.size()) < eng.maxAccel(JOINT_BASE) + 30);
+}
+
+// The gripper driven into its end stop at full speed comes to rest on it,
+// braking within its limit, without going past
+static void test_end_stop() {
+  const MotionEngine& eng = motion.engine();
+  traced = JOINT_GRIPPER;
+  trace.clear();
+  runMsTraced(20);
+  hold(JOINT_GRIPPER, eng.maxSpeed(JOINT_GRIPPER), 2000);
+
+  float highest = 0;
+  for (float a : trace) highest = a > highest ? a : highest;
+  float accel = peakAccel(0, trace.size());
+  report("gripper into 180 at %.0f deg/s: highest %.2f deg, rest %.2f deg, peak acceleration %.0f deg/s^2 (limit %.0f)",
+         eng.maxSpeed(JOINT_GRIPPER), highest, trace.back(), accel, eng.maxAccel(JOINT_GRIPPER));
+  TEST_ASSERT_TRUE(highest < 180.03f);
+  TEST_ASSERT_FLOAT_WITHIN(0.03f, 180, trace.back());
+  TEST_ASSERT_TRUE(accel < eng.maxAccel(JOINT_GRIPPER) + 30);
+  jog(JOINT_GRIPPER, 0);
+  runMsTraced(100);
+  TEST_ASSERT_EQUAL_INT(180, arm.position(JOINT_GRIPPER));
+}
+
+// One command in four lost at 10 Hz: the gaps are shorter than the
+// dead-man timeout, so the joint never slows down
+static void test_lost_commands() {
+  moveTo(JOINT_BASE, 150);
+  traced = JOINT_BASE;
+  trace.clear();
+  runMsTraced(20);
+  size_t start = trace.size();
+  hold(JOINT_BASE, -40, 2000, 4);
+  size_t end = trace.size();
+
+  float slowest = 40;
+  for (size_t k = start + 40; k < end; k++) slowest = fminf(slowest, -velocityAt(k));
+  report("-40 deg/s with every 4th command lost: slowest %.1f deg/s after the ramp", slowest);
+  TEST_ASSERT_TRUE(slowest > 40 - 2);
+}
+
+// Shoulder and elbow jogged in eight directions from start poses across
+// the envelope. The engine is driven directly, as the motion task would,
+// since most start poses can't be reached from home in a straight move.
+// No pose may leave the envelope; report how close to its edge the arm
+// comes to rest and how often it has to stop dead.
+static void test_envelope() {
+  MotionEngine& eng = motion.engine();
+  const float speed = 80;
+  const int dirs[8][2] = {{1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}, {0, -1}, {1, -1}};
+  int runs = 0, outside = 0, hardStops = 0, atEdge = 0;
+  float shortOfEdge = 0, worstShort = 0;
+
+  for (int s = 30; s <= 150; s += 15) {
+    for (int e = 30; e <= 150; e += 15) {
+      if (!envelopeAllows(s, e)) continue;
+      for (const int* d : dirs) {
+        eng.setStartPosition(JOINT_SHOULDER, s);
+        eng.setStartPosition(JOINT_ELBOW, e);
+        float v[JOINT_COUNT] = {0, d[0] * speed, d[1] * speed, 0};
+        float before[2] = {(float)s, (float)e}, vBefore[2] = {0, 0};
+        bool hard = false;
+        for (int k = 0; k < 600; k++) { // 3 s
+          if (k % 20 == 0) eng.jog(v, ArmController::JOG_DEADMAN_MS / 1000.0f);
+          eng.tick(TICK_SEC);
+          if (!envelopeAllows(eng.position(JOINT_SHOULDER), eng.position(JOINT_ELBOW))) outside++;
+          float now[2] = {angle(JOINT_SHOULDER), angle(JOINT_ELBOW)};
+          for (int j = 0; j < 2; j++) {
+            float vNow = (now[j] - before[j]) / TICK_SEC;
+            // The limit allows 2 deg/s a tick; the pulse adds up to 6
+            if (fabsf(vNow - vBefore[j]) > 15) hard = true;
+            vBefore[j] = vNow;
+            before[j] = now[j];
+          }
+        }
+        v[JOINT_SHOULDER] = v[JOINT_ELBOW] = 0;
+        eng.jog(v, ArmController::JOG_DEADMAN_MS / 1000.0f);
+        for (int k = 0; k < 100; k++) eng.tick(TICK_SEC);
+        runs++;
+        hardStops += hard;
+
+        // How much further the same direction would have been allowed
+        float pose[JOINT_COUNT] = {0, angle(JOINT_SHOULDER), angle(JOINT_ELBOW), 0};
+        float len = sqrtf(d[0] * d[0] + d[1] * d[1]);
+        for (float step = 0.01f; step < 5; step += 0.01f) {
+          float p[JOINT_COUNT] = {0, pose[1] + d[0] / len * step, pose[2] + d[1] / len * step, 0};
+          if (p[1] < 0 || p[1] > 180 || p[2] < 0 || p[2] > 180) break; // An end stop
+          if (!jogGuard(p)) {
+            atEdge++;
+            shortOfEdge += step;
+            worstShort = fmaxf(worstShort, step);
+            break;
+          }
+        }
+      }
+    }
+  }
+  report("shoulder/elbow jogs at %.0f deg/s: %d runs, %d ticks outside the envelope, %d stopped dead", speed, runs,
+         outside, hardStops);
+  report("  %d came to rest at the envelope's edge: %.2f deg short on average, %.2f at most", atEdge,
+         atEdge ? shortOfEdge / atEdge : 0, worstShort);
+  TEST_ASSERT_TRUE(runs >= 300);
+  TEST_ASSERT_EQUAL_INT(0, outside);
+  TEST_ASSERT_TRUE(hardStops * 20 <= runs);
+  TEST_ASSERT_TRUE(atEdge > runs / 2);
+  TEST_ASSERT_TRUE(shortOfEdge / atEdge < 1);
+}
+
+int main() {
+  setup();
+  UNITY_BEGIN();
+  RUN_TEST(test_ramp_and_release);
+  RUN_TEST(test_deadman);
+  RUN_TEST(test_end_stop);
+  RUN_TEST(test_lost_commands);
+  RUN_TEST(test_envelope);
+  return UNITY_END();
+}
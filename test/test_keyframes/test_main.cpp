@@ -0,0 +1,147 @@
+// Keyframe compression on synthetic and recorded slider drags: pose count,
+// memory and playback time before and after, and every dropped pose within
+// tolerance of the path that replaced it.
+// pio test -e native -f test_keyframes -v prints the numbers.
+
+#include <ArmSim.h>
+#include <chrono>
+#include <math.h>
+#include "Keyframes.h"
+
+static const float tolerance[JOINT_COUNT] = {2, 2, 2, 1}; // The firmware's defaults
+
+// Plays the recording from its first pose and returns the time it took
+static uint32_t playMs() {
+  TEST_ASSERT_EQUAL_INT(ARM_OK, arm.play(nullptr));
+  uint32_t start = millis();
+  while (arm.playing() && millis() - start < 600000) runMs(1);
+  TEST_ASSERT_FALSE(arm.playing());
+  return millis() - start;
+}
+
+static void load(const PoseBuffer& poses) {
+  TEST_ASSERT_EQUAL_INT(ARM_OK, arm.beginUpload());
+  for (size_t i = 0; i < poses.size(); i++) TEST_ASSERT_EQUAL_INT(ARM_OK, arm.uploadPose(poses[i]));
+}
+
+// Each raw pose against the keyframe segment it was folded into, scaled by
+// the tolerances the way compressKeyframes() measures it
+static void checkWithinTolerance(const PoseBuffer& raw, const PoseBuffer& keys) {
+  size_t k = 0;
+  for (size_t i = 0; i < raw.size(); i++) {
+    if (k + 1 < keys.size() && memcmp(raw[i].joints, keys[k + 1].joints, JOINT_COUNT) == 0) {
+      k++;
+      continue;
+    }
+    if (k + 1 >= keys.size()) break;
+    const PackedPose& a = keys[k];
+    const PackedPose& b = keys[k + 1];
+    double v[JOINT_COUNT], w[JOINT_COUNT], vv = 0, wv = 0;
+    for (uint8_t j = 0; j < JOINT_COUNT; j++) {
+      v[j] = (b.joints[j] - a.joints[j]) / tolerance[j];
+      w[j] = (raw[i].joints[j] - a.joints[j]) / tolerance[j];
+      vv += v[j] * v[j];
+      wv += w[j] * v[j];
+    }
+    double t = vv > 0 ? fmin(fmax(wv / vv, 0), 1) : 0, d = 0;
+    for (uint8_t j = 0; j < JOINT_COUNT; j++) d += (w[j] - t * v[j]) * (w[j] - t * v[j]);
+    TEST_ASSERT_TRUE_MESSAGE(d <= 1.0001, "dropped pose outside tolerance");
+  }
+  TEST_ASSERT_EQUAL_MEMORY(raw.back().joints, keys.back().joints, JOINT_COUNT);
+}
+
+// Compresses `raw`, checks it, and compares playback of both. Playback
+// gets at least 4x shorter: most of the raw time is the per-pose pause and
+// ramps of one-degree moves.
+static void benchmark(const char* name, const PoseBuffer& raw, float minRatio) {
+  static PoseBuffer keys;
+  keys.clear();
+  for (size_t i = 0; i < raw.size(); i++) keys.appendPacked(raw[i]);
+  auto start = std::chrono::steady_clock::now();
+  KeyframeStats stats = compressKeyframes(keys, tolerance);
+  double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+  checkWithinTolerance(raw, keys);
+
+  load(raw);
+  uint32_t rawMs = playMs();
+  load(keys);
+  uint32_t keyMs = playMs();
+  report("%-14s poses %4u -> %3u (%.1fx), %5u -> %4u bytes, playback %6u -> %5u ms, compress %.0f us", name,
+         (unsigned)stats.before, (unsigned)stats.after, stats.ratio(), (unsigned)raw.bytesUsed(),
+         (unsigned)keys.bytesUsed(), (unsigned)rawMs, (unsigned)keyMs, us);
+  TEST_ASSERT_TRUE_MESSAGE(stats.ratio() >= minRatio, name);
+  TEST_ASSERT_TRUE_MESSAGE(keyMs * 4 <= rawMs, name);
+}
+
+void setUp() {}
+void tearDown() {}
+
+// A slow straight drag of base and shoulder together, 1 degree per sample
+static void test_synthetic_line() {
+  static PoseBuffer raw;
+  raw.clear();
+  for (int i = 0; i <= 120; i++) {
+    uint8_t joints[JOINT_COUNT] = {(uint8_t)(30 + i), (uint8_t)(80 + i / 6), 90, 90};
+    raw.append(joints, i * 20);
+  }
+  benchmark("line", raw, 20);
+}
+
+// A smooth curve: base sweeps while the shoulder follows a sine and the
+// gripper closes
+static void test_synthetic_curve() {
+  static PoseBuffer raw;
+  raw.clear();
+  for (int i = 0; i <= 400; i++) {
+    float t = i / 400.0f;
+    uint8_t joints[JOINT_COUNT] = {(uint8_t)lroundf(20 + 140 * t), (uint8_t)lroundf(95 + 12 * sinf(6.2832f * t)),
+                                   90, (uint8_t)lroundf(150 - 90 * t)};
+    raw.append(joints, i * 20);
+  }
+  benchmark("curve", raw, 8);
+}
+
+// Two sliders dragged by hand through /set_servo at about 50 events a
+// second, recorded by the firmware with tolerance 0 (only poses within half
+// a degree of the line dropped) to stand in for the raw recording
+static void test_recorded_drag() {
+  for (uint8_t j = 0; j < JOINT_COUNT; j++) {
+    char url[32];
+    snprintf(url, sizeof(url), "/toggle_servo?joint=%u", j);
+    if (!arm.enabled((JointId)j)) TEST_ASSERT_EQUAL_STRING("enabled", get(url).body.c_str());
+  }
+  get("/delete_sequence");
+  TEST_ASSERT_EQUAL_INT(200, get("/compress_sequence?tol=0").code);
+  TEST_ASSERT_EQUAL_STRING("RECORDING_STARTED", get("/toggle_record").body.c_str());
+  uint32_t seed = 7;
+  int base = 40, shoulder = 90;
+  for (int i = 0; i < 150; i++) {
+    seed = seed * 1103515245 + 12345;
+    char url[48];
+    if (i % 2) {
+      shoulder += i < 75 ? 1 : -1;
+      snprintf(url, sizeof(url), "/set_servo?joint=%u&pos=%d", JOINT_SHOULDER, shoulder);
+    } else {
+      base += 1 + (seed >> 16) % 2; // Uneven steps, like a finger on a slider
+      snprintf(url, sizeof(url), "/set_servo?joint=%u&pos=%d", JOINT_BASE, base);
+    }
+    TEST_ASSERT_EQUAL_INT(200, get(url).code);
+    runMs(20);
+  }
+  TEST_ASSERT_EQUAL_STRING("RECORDING_STOPPED", get("/toggle_record").body.c_str());
+
+  static PoseBuffer raw;
+  raw.clear();
+  const PoseBuffer& recorded = arm.recordedSequence();
+  for (size_t i = 0; i < recorded.size(); i++) raw.appendPacked(recorded[i]);
+  benchmark("recorded drag", raw, 10);
+}
+
+int main() {
+  setup();
+  UNITY_BEGIN();
+  RUN_TEST(test_synthetic_line);
+  RUN_TEST(test_synthetic_curve);
+  RUN_TEST(test_recorded_drag);
+  return UNITY_END();
+}
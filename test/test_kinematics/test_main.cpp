@@ -0,0 +1,175 @@
+// Fixed-point kinematics against a double-precision reference of the same
+// geometry, and solves per second on the host.
+// pio test -e native -f test_kinematics -v prints the numbers.
+
+#include <ArmSim.h>
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include "Kinematics.h"
+
+static const double RAD = M_PI / 18000; // Per centidegree
+
+// Reference forward kinematics, angles in centidegrees, lengths in tenths of a mm
+static void referenceFK(double base, double shoulder, double elbow, double p[3]) {
+  double forearm = elbow - ARM_ELBOW_LEVEL;
+  double r = ARM_UPPER_LENGTH * cos(shoulder * RAD) + ARM_FOREARM_LENGTH * cos(forearm * RAD) + ARM_GRIPPER_LENGTH;
+  p[0] = r * cos(base * RAD);
+  p[1] = r * sin(base * RAD);
+  p[2] = ARM_UPPER_LENGTH * sin(shoulder * RAD) + ARM_FOREARM_LENGTH * sin(forearm * RAD) + ARM_SHOULDER_HEIGHT;
+}
+
+// Reference elbow-up IK; false where solveIK() should refuse too
+static bool referenceIK(const double p[3], double out[3]) {
+  double base = atan2(p[1], p[0]) / RAD;
+  double r = hypot(p[0], p[1]) - ARM_GRIPPER_LENGTH;
+  double h = p[2] - ARM_SHOULDER_HEIGHT;
+  double d = hypot(r, h);
+  const double l1 = ARM_UPPER_LENGTH, l2 = ARM_FOREARM_LENGTH;
+  if (d > l1 + l2 || d < fabs(l1 - l2) || d == 0) return false;
+  double shoulder = (atan2(h, r) + acos((l1 * l1 + d * d - l2 * l2) / (2 * l1 * d))) / RAD;
+  double ex = l1 * cos(shoulder * RAD), ez = l1 * sin(shoulder * RAD);
+  double elbow = atan2(h - ez, r - ex) / RAD + ARM_ELBOW_LEVEL;
+  out[0] = base;
+  out[1] = shoulder;
+  out[2] = elbow;
+  return base >= 0 && base <= 18000 && shoulder >= 0 && shoulder <= 18000 && elbow >= 0 && elbow <= 18000;
+}
+
+// Targets reachable with every servo inside 10-170 degrees, so rounding
+// can't push a solution over the limits, at least 50 mm out from the base
+// axis, and with the upper arm and forearm 35-160 degrees apart (the
+// envelope allows 35-170). Nearly folded or stretched out, a tenth of a
+// millimetre moves the angles by degrees, which says nothing about the
+// arithmetic.
+static int makeTargets(ArmPoint* points, int count) {
+  uint32_t seed = 1;
+  auto next = [&seed](int lo, int hi) {
+    seed = seed * 1103515245 + 12345;
+    return lo + (int)((seed >> 8) % (uint32_t)(hi - lo + 1));
+  };
+  int made = 0;
+  while (made < count) {
+    double p[3], angles[3];
+    referenceFK(next(1000, 17000), next(1000, 17000), next(1000, 17000), p);
+    for (int k = 0; k < 3; k++) p[k] = lround(p[k]);
+    if (hypot(p[0], p[1]) < 500) continue;
+    if (!referenceIK(p, angles)) continue; // The elbow-down twin of a pose
+    if (angles[1] < 1000 || angles[1] > 17000 || angles[2] < 1000 || angles[2] > 17000) continue;
+    double link = 18000 - (angles[1] - (angles[2] - ARM_ELBOW_LEVEL)); // Between the links
+    if (link < 3500 || link > 16000) continue;
+    points[made++] = {(int32_t)p[0], (int32_t)p[1], (int32_t)p[2]};
+  }
+  return made;
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_trig_accuracy() {
+  int32_t worstSin = 0, worstAtan = 0, worstAcos = 0;
+  for (int32_t a = -36000; a <= 36000; a += 7) {
+    int32_t err = abs(sinQ16(a) - (int32_t)lround(sin(a * RAD) * 65536));
+    if (err > worstSin) worstSin = err;
+  }
+  for (int32_t a = -17999; a <= 18000; a += 13) {
+    int32_t y = (int32_t)lround(sin(a * RAD) * 100000), x = (int32_t)lround(cos(a * RAD) * 100000);
+    int32_t err = abs(atan2Centideg(y, x) - a);
+    if (err > worstAtan) worstAtan = err;
+  }
+  for (int32_t c = -65536; c <= 65536; c += 17) {
+    int32_t err = abs(acosCentideg(c) - (int32_t)lround(acos(c / 65536.0) / RAD));
+    if (err > worstAcos) worstAcos = err;
+  }
+  report("worst error: sin %d/65536, atan2 %d cdeg, acos %d cdeg", (int)worstSin, (int)worstAtan, (int)worstAcos);
+  TEST_ASSERT_LESS_OR_EQUAL(8, worstSin);
+  TEST_ASSERT_LESS_OR_EQUAL(2, worstAtan);
+  TEST_ASSERT_LESS_OR_EQUAL(4, worstAcos);
+
+  for (uint64_t v : {0ULL, 1ULL, 2ULL, 99ULL, 100ULL, 65535ULL * 65535ULL, (1ULL << 62) + 12345}) {
+    uint64_t r = isqrt64(v);
+    TEST_ASSERT_TRUE(r * r <= v && (r + 1) * (r + 1) > v);
+  }
+}
+
+// solveIK() angles against the reference, and where they put the tip
+// according to the reference forward kinematics
+static void test_ik_accuracy() {
+  static ArmPoint targets[5000];
+  int count = makeTargets(targets, 5000);
+  double worstAngle = 0, worstTip = 0, sumTip = 0;
+  for (int i = 0; i < count; i++) {
+    const ArmPoint& t = targets[i];
+    double p[3] = {(double)t.x, (double)t.y, (double)t.z}, ref[3];
+    TEST_ASSERT_TRUE(referenceIK(p, ref));
+    ArmAngles a;
+    TEST_ASSERT_TRUE_MESSAGE(solveIK(t, a), "reachable target refused");
+    double got[3] = {(double)a.base, (double)a.shoulder, (double)a.elbow};
+    for (int k = 0; k < 3; k++) worstAngle = fmax(worstAngle, fabs(got[k] - ref[k]));
+
+    double tip[3];
+    referenceFK(a.base, a.shoulder, a.elbow, tip);
+    double err = sqrt((tip[0] - p[0]) * (tip[0] - p[0]) + (tip[1] - p[1]) * (tip[1] - p[1]) +
+                      (tip[2] - p[2]) * (tip[2] - p[2]));
+    worstTip = fmax(worstTip, err);
+    sumTip += err;
+  }
+  report("%d targets: worst angle error %.1f cdeg, tip error mean %.2f mm, worst %.2f mm", count, worstAngle,
+         sumTip / count / 10, worstTip / 10);
+  // Servo angles are whole degrees, so a fifth of one is plenty
+  TEST_ASSERT_LESS_OR_EQUAL(30, (int)worstAngle);
+  TEST_ASSERT_LESS_OR_EQUAL(5, (int)worstTip); // 0.5 mm
+}
+
+static void test_fk_accuracy() {
+  double worst = 0;
+  for (int32_t b = 0; b <= 18000; b += 450) {
+    for (int32_t s = 0; s <= 18000; s += 450) {
+      for (int32_t e = 0; e <= 18000; e += 450) {
+        ArmPoint got;
+        forwardKinematics({b, s, e}, got);
+        double ref[3];
+        referenceFK(b, s, e, ref);
+        worst = fmax(worst, fmax(fabs(got.x - ref[0]), fmax(fabs(got.y - ref[1]), fabs(got.z - ref[2]))));
+      }
+    }
+  }
+  report("forward kinematics: worst axis error %.2f mm", worst / 10);
+  TEST_ASSERT_LESS_OR_EQUAL(10, (int)worst); // 1 mm
+}
+
+static void test_out_of_reach() {
+  ArmAngles a;
+  const int32_t far = ARM_UPPER_LENGTH + ARM_FOREARM_LENGTH + ARM_GRIPPER_LENGTH + 100;
+  TEST_ASSERT_FALSE(solveIK({0, far, ARM_SHOULDER_HEIGHT}, a));
+  TEST_ASSERT_FALSE(solveIK({0, -1500, 1000}, a)); // Behind the base
+  TEST_ASSERT_FALSE(solveIK({0, ARM_GRIPPER_LENGTH, ARM_SHOULDER_HEIGHT}, a)); // Wrist on the shoulder pivot
+}
+
+static void test_solves_per_second() {
+  static ArmPoint targets[1000];
+  int count = makeTargets(targets, 1000);
+  const int rounds = 500;
+  volatile int32_t sink = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; r++) {
+    for (int i = 0; i < count; i++) {
+      ArmAngles a;
+      if (solveIK(targets[i], a)) sink = sink + a.elbow;
+    }
+  }
+  double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  double perSec = rounds * count / sec;
+  report("solveIK: %.2f M solves/s on the host, %.0f ns each", perSec / 1e6, 1e9 / perSec);
+  TEST_ASSERT_TRUE(perSec > 1e6);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_trig_accuracy);
+  RUN_TEST(test_ik_accuracy);
+  RUN_TEST(test_fk_accuracy);
+  RUN_TEST(test_out_of_reach);
+  RUN_TEST(test_solves_per_second);
+  return UNITY_END();
+}
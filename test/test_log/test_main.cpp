@@ -0,0 +1,197 @@
+// Cost of a log call against the Serial.println(String) pattern it replaced:
+// host time and heap allocations per call, and the time a 115200 baud UART
+// would hold the caller. Also the drain task's cost per record and the
+// dropped-record count when the ring overflows.
+// pio test -e native -f test_log -v prints the numbers.
+
+#include <ArmSim.h>
+#include <chrono>
+#include "Log.h"
+
+typedef std::chrono::steady_clock Clock;
+
+static double nsSince(Clock::time_point start, uint32_t calls) {
+  return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / calls;
+}
+
+// The ESP32 UART with Arduino's default of no TX buffer: a write fills the
+// 128-byte hardware FIFO and blocks while the rest goes out at 10 bits a
+// byte. Counts the time the caller would spend blocked, against the
+// simulated clock.
+class UartModel : public Print {
+public:
+  static const uint32_t BAUD = 115200;
+  static const size_t FIFO = 128;
+
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t* data, size_t len) override {
+    (void)data;
+    drain();
+    for (size_t i = 0; i < len; i++) {
+      if (level == FIFO) { // Wait for the next byte to go
+        uint64_t wait = byteUs() - (simMicros() - lastUs) % byteUs();
+        simAdvanceMicros(wait);
+        blockedUs += wait;
+        drain();
+      }
+      level++;
+    }
+    bytes += len;
+    return len;
+  }
+
+  uint64_t blockedUs = 0;
+  uint64_t bytes = 0;
+
+private:
+  size_t level = 0;
+  uint64_t lastUs = 0;
+
+  static uint64_t byteUs() { return (10 * 1000000ULL + BAUD - 1) / BAUD; } // 87 us
+  void drain() {
+    uint64_t now = simMicros();
+    size_t sent = (now - lastUs) / byteUs();
+    if (sent >= level) {
+      level = 0;
+      lastUs = now;
+    } else {
+      level -= sent;
+      lastUs += sent * byteUs();
+    }
+  }
+};
+
+static uint64_t sinkBytes = 0;
+static uint32_t sinkLines = 0;
+static void countingSink(const char* line, size_t len) {
+  (void)line;
+  sinkBytes += len;
+  sinkLines++;
+}
+
+void setUp() {
+  logSetSink(countingSink);
+  logFlush();
+}
+void tearDown() {
+  logFlush();
+  logSetSink(nullptr);
+}
+
+// The message recordPose() logs for every pose, at the full (not rate
+// limited) cost: a fresh site each call
+static void test_call_cost() {
+  const uint32_t calls = 1000000;
+  double ns = 0;
+  SimHeapStats before = simHeapStats();
+  for (uint32_t done = 0; done < calls; done += LOG_RING_SIZE) {
+    auto start = Clock::now();
+    for (uint32_t i = 0; i < LOG_RING_SIZE; i++) {
+      LogSite site = {0, 0};
+      logWrite(site, LOG_LEVEL_INFO, "Pose recorded. Sequence size: %u", (unsigned)(done + i));
+    }
+    ns += std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    logFlush(); // Not timed: the drain task's job
+  }
+  uint32_t allocations = simHeapStats().allocations - before.allocations;
+  report("LOG_INFO: %.1f ns a call, %u allocations in %u calls", ns / calls, (unsigned)allocations, (unsigned)calls);
+  TEST_ASSERT_EQUAL_UINT32(0, allocations);
+  TEST_ASSERT_EQUAL_UINT32(0, logRecordsDropped());
+  TEST_ASSERT_TRUE(ns / calls < 1000);
+
+  // Over the site's rate, or below the level: no record at all
+  LogSite busy = {0, LOG_SITE_RATE};
+  busy.windowStartMs = millis();
+  auto start = Clock::now();
+  for (uint32_t i = 0; i < calls; i++) logWrite(busy, LOG_LEVEL_INFO, "Pose recorded. Sequence size: %u", (unsigned)i);
+  double limitedNs = nsSince(start, calls);
+  logSetLevel(LOG_LEVEL_WARN);
+  LogSite quiet = {0, 0};
+  start = Clock::now();
+  for (uint32_t i = 0; i < calls; i++) logWrite(quiet, LOG_LEVEL_INFO, "Pose recorded. Sequence size: %u", (unsigned)i);
+  double filteredNs = nsSince(start, calls);
+  logSetLevel((LogLevel)MEARM_LOG_LEVEL);
+  report("rate limited: %.1f ns a call; below the level: %.1f ns; below MEARM_LOG_LEVEL: compiled out", limitedNs,
+         filteredNs);
+}
+
+// Takes the bytes and does nothing with them
+class NullPrint : public Print {
+public:
+  size_t write(uint8_t) override { return 1; }
+  size_t write(const uint8_t*, size_t len) override { return len; }
+};
+
+// The old pattern, as handlers and recordPose() had it: building the
+// String on the host, then what the UART adds on the ESP32
+static void test_println_string_cost() {
+  NullPrint null;
+  Print& serial = null;
+  const uint32_t calls = 200000;
+  SimHeapStats before = simHeapStats();
+  auto start = Clock::now();
+  for (uint32_t i = 0; i < calls; i++) serial.println("Pose recorded. Sequence size: " + String(i));
+  double ns = nsSince(start, calls);
+  uint32_t allocations = simHeapStats().allocations - before.allocations;
+  report("Serial.println(String): %.1f ns a call without the UART, %.1f allocations a call", ns,
+         (double)allocations / calls);
+  TEST_ASSERT_TRUE(allocations >= calls);
+
+  UartModel uart;
+  for (uint32_t i = 0; i < calls / 100; i++) uart.println("Pose recorded. Sequence size: " + String(i));
+  report("  at 115200 baud: %.0f us blocked a call back to back (%.1f bytes each)",
+         (double)uart.blockedUs / (calls / 100), (double)uart.bytes / (calls / 100));
+
+  // One on its own fits the FIFO; the fourth in a burst starts to wait
+  UartModel idle;
+  simAdvanceMicros(1000000);
+  for (int i = 0; i < 10; i++) {
+    uint64_t blocked = idle.blockedUs;
+    idle.println("Pose recorded. Sequence size: " + String(1000 + i));
+    if (i == 0) TEST_ASSERT_TRUE(idle.blockedUs == blocked);
+  }
+  report("  a burst of 10 after an idle second: %.0f us blocked in all", (double)idle.blockedUs);
+  TEST_ASSERT_TRUE(idle.blockedUs > 0);
+}
+
+// The drain task's side: popping and formatting one record
+static void test_drain_cost() {
+  const uint32_t calls = 200000;
+  double ns = 0;
+  sinkBytes = 0;
+  sinkLines = 0;
+  for (uint32_t done = 0; done < calls; done += LOG_RING_SIZE) {
+    for (uint32_t i = 0; i < LOG_RING_SIZE; i++) {
+      LogSite site = {0, 0};
+      logWrite(site, LOG_LEVEL_INFO, "Streaming sequence '%s' (%u poses)...", "pick-and-place", (unsigned)i);
+    }
+    auto start = Clock::now();
+    logFlush();
+    ns += std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+  }
+  report("logFlush: %.1f ns a record, %.1f bytes a line", ns / calls, (double)sinkBytes / sinkLines);
+  TEST_ASSERT_EQUAL_UINT32(calls, sinkLines);
+}
+
+// A burst bigger than the ring between drains: the rest are dropped,
+// counted, and reported on the next flush
+static void test_dropped_records() {
+  uint32_t dropped = logRecordsDropped();
+  sinkLines = 0;
+  for (uint32_t i = 0; i < 3 * LOG_RING_SIZE; i++) {
+    LogSite site = {0, 0};
+    logWrite(site, LOG_LEVEL_WARN, "Burst %u", (unsigned)i);
+  }
+  TEST_ASSERT_EQUAL_UINT32(dropped + 2 * LOG_RING_SIZE, logRecordsDropped());
+  logFlush();
+  TEST_ASSERT_EQUAL_UINT32(LOG_RING_SIZE + 1, sinkLines); // And the drop report
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_call_cost);
+  RUN_TEST(test_println_string_cost);
+  RUN_TEST(test_drain_cost);
+  RUN_TEST(test_dropped_records);
+  return UNITY_END();
+}
@@ -0,0 +1,114 @@
+// Cost of the /metrics instrumentation: observe() and loopPass() per call,
+// a scrape's size, time and heap use, and the per-request overhead of the
+// route timing. Run it in both native envs to compare request times with
+// the instrumentation compiled out:
+// pio test -e native -f test_metrics -v
+// pio test -e native_nometrics -f test_metrics -v
+
+#include <ArmSim.h>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "Metrics.h"
+
+typedef std::chrono::steady_clock Clock;
+
+static double nsSince(Clock::time_point start, uint32_t calls) {
+  return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / calls;
+}
+
+void setUp() {}
+void tearDown() {}
+
+// Spread over every bucket, the +Inf one included, so the bucket search
+// isn't always the shortest
+static void test_observe_cost() {
+  static LatencyHistogram hist;
+  const uint32_t calls = 5000000;
+  auto start = Clock::now();
+  for (uint32_t i = 0; i < calls; i++) hist.observe((i * 7919) % 150000);
+  double ns = nsSince(start, calls);
+  report("LatencyHistogram::observe: %.1f ns a call", ns);
+  TEST_ASSERT_EQUAL_UINT32(calls, hist.count());
+  TEST_ASSERT_GREATER_THAN(0, hist.bucketCount(LatencyHistogram::BUCKETS - 1));
+  TEST_ASSERT_TRUE(ns < 50);
+}
+
+static void test_loop_pass_cost() {
+  static Metrics m;
+  const uint32_t calls = 5000000;
+  auto start = Clock::now();
+  for (uint32_t i = 0; i < calls; i++) m.loopPass(i * 1000);
+  double ns = nsSince(start, calls);
+  report("Metrics::loopPass: %.1f ns a call", ns);
+  TEST_ASSERT_TRUE(ns < 50);
+}
+
+// Median host time of `url`; the motion task gets a tick between requests
+static double requestUs(const char* url, int runs) {
+  std::vector<double> us;
+  for (int i = 0; i < runs; i++) {
+    auto start = Clock::now();
+    SimResponse r = get(url);
+    us.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+    TEST_ASSERT_EQUAL_INT_MESSAGE(200, r.code, url);
+    runMs(5);
+  }
+  std::sort(us.begin(), us.end());
+  return us[runs / 2];
+}
+
+// What the route wrapper adds to every request, against the request itself.
+// With MEARM_METRICS=0 there's no wrapper and the numbers are the baseline.
+static void test_request_overhead() {
+  const char* urls[] = {"/state", "/set_servo?joint=0&pos=100", "/sequences"};
+  for (const char* url : urls) {
+    report("%-28s p50 %6.2f us a request (metrics %s)", url, requestUs(url, 500), MEARM_METRICS ? "on" : "off");
+  }
+#if MEARM_METRICS
+  static Metrics m;
+  int id = m.addRoute("/state");
+  const uint32_t calls = 1000000;
+  auto start = Clock::now();
+  for (uint32_t i = 0; i < calls; i++) {
+    uint32_t begin = micros();
+    m.observeRoute(id, micros() - begin + i % 300);
+  }
+  double ns = nsSince(start, calls);
+  report("route timing: %.1f ns a request", ns);
+  TEST_ASSERT_TRUE(ns < 100);
+#endif
+}
+
+// A scrape: its size, host time and heap, and that the handler's own time
+// lands in its histogram
+static void test_scrape() {
+#if MEARM_METRICS
+  requestUs("/metrics", 50);
+  simResetHeapPeak();
+  SimHeapStats before = simHeapStats();
+  auto start = Clock::now();
+  SimResponse r = get("/metrics");
+  double us = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+  TEST_ASSERT_EQUAL_INT(200, r.code);
+  report("/metrics: %u bytes in %.1f us, %u allocations, peak %u bytes above baseline", (unsigned)r.body.size(), us,
+         (unsigned)r.allocations, (unsigned)(simHeapStats().peakBytes - before.liveBytes));
+  TEST_ASSERT_TRUE(r.body.find("mearm_http_handler_duration_microseconds_count{route=\"/metrics\"} 50\n") !=
+                   std::string::npos);
+  TEST_ASSERT_LESS_OR_EQUAL(9, r.allocations);
+  TEST_ASSERT_LESS_OR_EQUAL(2000, (uint32_t)us);
+#else
+  TEST_ASSERT_EQUAL_INT(404, get("/metrics").code);
+#endif
+}
+
+int main() {
+  setup();
+  UNITY_BEGIN();
+  RUN_TEST(test_observe_cost);
+  RUN_TEST(test_loop_pass_cost);
+  RUN_TEST(test_request_overhead);
+  RUN_TEST(test_scrape);
+  return UNITY_END();
+}
@@ -0,0 +1,408 @@
+// Mirroring between separate firmware instances over loopback multicast: a
+// leader and three followers, each its own process with its own clock, the
+// tasks on threads as on the ESP32. The test process also repeats some of
+// the leader's packets late, as a network might. Reports how closely and
+// how far behind each follower tracks the leader, and checks that a new
+// leader takes over once the old one goes quiet.
+// pio test -e native -f test_mirror -v prints the numbers.
+
+#include <ArmSim.h>
+#include <AsyncUDP.h>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <math.h>
+#include <mutex>
+#include <new>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include "Mirror.h"
+
+// From src/main.cpp
+extern Mirror mirror;
+
+typedef std::chrono::steady_clock Clock;
+
+// As in src/main.cpp
+static const IPAddress group(239, 77, 65, 1);
+static const uint16_t port = 4210;
+
+static const int FOLLOWERS = 3;
+// Each follower's clock is this far ahead of the leader's; the last one's
+// micros() wraps during the run
+static const uint64_t clockOffsetUs[FOLLOWERS] = {0, 123000000ULL, 4290000000ULL};
+static const uint32_t SAMPLE_US = 5000;
+static const size_t MAX_SAMPLES = 2000;
+static const uint32_t DUPLICATE_EVERY = 10; // Leader packets
+static const uint32_t DUPLICATE_DELAY_MS = 30;
+
+enum Phase : int {
+  PHASE_SETUP,
+  PHASE_RECORD,   // Followers sample their base joint
+  PHASE_TAKEOVER, // A new leader session
+  PHASE_REPORT,   // Followers write their counters and exit
+};
+
+// Base joint positions against the shared steady clock
+struct Trace {
+  uint32_t count;
+  float t[MAX_SAMPLES];
+  int16_t base[MAX_SAMPLES];
+
+  void add(float seconds, int16_t position) {
+    if (count == MAX_SAMPLES) return;
+    t[count] = seconds;
+    base[count] = position;
+    count++;
+  }
+};
+
+struct FollowerResult {
+  Trace trace;
+  uint32_t accepted, stale, lost, invalid, extrapolated, leader;
+  bool following;
+};
+
+// Mapped before the fork, so every process sees it
+struct Shared {
+  Clock::time_point start;
+  std::atomic<int> ready;
+  std::atomic<int> phase;
+  Trace leader;
+  FollowerResult followers[FOLLOWERS];
+};
+
+static Shared* shared;
+static pid_t children[FOLLOWERS];
+
+static float secondsNow() {
+  return std::chrono::duration<float>(Clock::now() - shared->start).count();
+}
+
+// --- One firmware instance ---
+static std::atomic<bool> running{false};
+static std::thread motionTask, networkTask;
+
+// The motion task at 200 Hz and the network task every millisecond, on the
+// host clock
+static void startTasks(uint64_t offsetUs) {
+  simUseHostClock(true, offsetUs);
+  running = true;
+  motionTask = std::thread([] {
+    auto next = Clock::now();
+    while (running) {
+      next += std::chrono::microseconds(MotionEngine::TICK_INTERVAL_US);
+      std::this_thread::sleep_until(next);
+      motion.step(micros());
+    }
+  });
+  networkTask = std::thread([] {
+    while (running) {
+      networkPoll();
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  });
+}
+
+static void stopTasks() {
+  running = false;
+  networkTask.join();
+  motionTask.join();
+}
+
+static int16_t basePosition() {
+  MotionSnapshot snap;
+  motion.snapshot(snap);
+  return snap.position[JOINT_BASE];
+}
+
+static bool enableAll() {
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+    bool on;
+    if (!arm.enabled((JointId)i) && arm.toggleJoint((JointId)i, on) != ARM_OK) return false;
+  }
+  return true;
+}
+
+// No Unity here: the exit code says whether it got as far as reporting
+static void runFollower(int index) {
+  setup();
+  if (!enableAll()) _exit(1);
+  if (get("/mirror?mode=follower").code != 200) _exit(2);
+  startTasks(clockOffsetUs[index]);
+  shared->ready++;
+
+  FollowerResult& out = shared->followers[index];
+  auto next = Clock::now();
+  while (shared->phase != PHASE_REPORT) {
+    if (shared->phase == PHASE_RECORD) out.trace.add(secondsNow(), basePosition());
+    next += std::chrono::microseconds(SAMPLE_US);
+    std::this_thread::sleep_until(next);
+  }
+  stopTasks();
+  out.accepted = mirror.packetsAccepted();
+  out.stale = mirror.packetsStale();
+  out.lost = mirror.packetsLost();
+  out.invalid = mirror.packetsInvalid();
+  out.extrapolated = mirror.extrapolations();
+  out.leader = mirror.leader();
+  out.following = mirror.following();
+  _exit(0);
+}
+
+// --- The network in between ---
+// Repeats every DUPLICATE_EVERY-th packet of the leader's DUPLICATE_DELAY_MS
+// later, by then one and a half periods stale
+class Duplicator {
+public:
+  void start() {
+    TEST_ASSERT_TRUE(udp.listenMulticast(group, port));
+    udp.onPacket([this](AsyncUDPPacket& packet) {
+      if (packet.length() != MIRROR_PACKET_SIZE) return;
+      std::lock_guard<std::mutex> guard(lock);
+      const uint8_t* d = packet.data();
+      leaderId = d[4] | (d[5] << 8) | (d[6] << 16) | ((uint32_t)d[7] << 24);
+      uint32_t seq = d[8] | (d[9] << 8) | (d[10] << 16) | ((uint32_t)d[11] << 24);
+      if (!enabled || (seen && (int32_t)(seq - newestSeq) <= 0)) return; // Our own repeats
+      seen = true;
+      newestSeq = seq;
+      if (seq % DUPLICATE_EVERY) return;
+      Delayed p;
+      memcpy(p.data, d, MIRROR_PACKET_SIZE);
+      p.due = Clock::now() + std::chrono::milliseconds(DUPLICATE_DELAY_MS);
+      pending.push_back(p);
+    });
+    enabled = true;
+    running = true;
+    sender = std::thread([this] {
+      while (running) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        std::lock_guard<std::mutex> guard(lock);
+        while (!pending.empty() && pending.front().due <= Clock::now()) {
+          udp.writeTo(pending.front().data, MIRROR_PACKET_SIZE, group, port);
+          pending.pop_front();
+          repeated++;
+        }
+      }
+    });
+  }
+
+  // Stops repeating once everything already captured has gone out
+  void drain() {
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      enabled = false;
+    }
+    while (true) {
+      {
+        std::lock_guard<std::mutex> guard(lock);
+        if (pending.empty()) break;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+  }
+
+  void stop() {
+    running = false;
+    sender.join();
+    udp.close();
+  }
+
+  uint32_t packetsRepeated() {
+    std::lock_guard<std::mutex> guard(lock);
+    return repeated;
+  }
+  uint32_t lastLeader() {
+    std::lock_guard<std::mutex> guard(lock);
+    return leaderId;
+  }
+
+private:
+  struct Delayed {
+    uint8_t data[MIRROR_PACKET_SIZE];
+    Clock::time_point due;
+  };
+  AsyncUDP udp;
+  std::mutex lock;
+  std::deque<Delayed> pending;
+  std::thread sender;
+  std::atomic<bool> running{false};
+  bool enabled = false;
+  bool seen = false;
+  uint32_t newestSeq = 0;
+  uint32_t leaderId = 0;
+  uint32_t repeated = 0;
+};
+
+static Duplicator duplicator;
+
+// --- Tracking error ---
+// The leader's base position at `t`, between its samples
+static bool leaderAt(float t, float& position) {
+  const Trace& l = shared->leader;
+  if (l.count < 2 || t < l.t[0] || t > l.t[l.count - 1]) return false;
+  uint32_t i = 1;
+  while (l.t[i] < t) i++;
+  float f = (t - l.t[i - 1]) / (l.t[i] - l.t[i - 1]);
+  position = l.base[i - 1] + (l.base[i] - l.base[i - 1]) * f;
+  return true;
+}
+
+struct Tracking {
+  float lagMs, rms, max;
+};
+
+// The lag that best lines the follower up with the leader, and the error
+// left at that lag
+static Tracking tracking(const Trace& f) {
+  Tracking best = {0, 1e9f, 0};
+  for (int lagMs = 0; lagMs <= 150; lagMs++) {
+    double sum = 0;
+    float max = 0;
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < f.count; i++) {
+      float expected;
+      if (!leaderAt(f.t[i] - lagMs / 1000.0f, expected)) continue;
+      float error = fabsf(f.base[i] - expected);
+      sum += error * error;
+      if (error > max) max = error;
+      n++;
+    }
+    float rms = n ? sqrtf(sum / n) : 1e9f;
+    if (rms < best.rms) best = {(float)lagMs, rms, max};
+  }
+  return best;
+}
+
+void setUp() {}
+void tearDown() {}
+
+// The leader plays a sweep of the base and gripper at full speed while the
+// followers, started first, record where their own base is
+static void test_followers_track_leader() {
+  auto deadline = Clock::now() + std::chrono::seconds(10);
+  while (shared->ready < FOLLOWERS && Clock::now() < deadline) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  TEST_ASSERT_EQUAL_INT(FOLLOWERS, shared->ready.load());
+
+  TEST_ASSERT_TRUE(enableAll());
+  TEST_ASSERT_EQUAL(ARM_OK, arm.beginUpload());
+  for (int i = 0; i < 20; i++) {
+    PackedPose pose = {{(uint8_t)(i % 2 ? 40 : 140), 90, 90, (uint8_t)(i % 2 ? 20 : 60)}, 0};
+    TEST_ASSERT_EQUAL(ARM_OK, arm.uploadPose(pose));
+  }
+  TEST_ASSERT_EQUAL_INT(200, get("/mirror?mode=leader").code);
+  startTasks(0);
+  duplicator.start();
+  TEST_ASSERT_EQUAL_STRING("PLAYBACK_STARTED", get("/play_sequence?loops=0").body.c_str());
+
+  std::this_thread::sleep_for(std::chrono::seconds(1)); // Followers lock on and catch up
+  shared->phase = PHASE_RECORD;
+  auto next = Clock::now();
+  auto end = next + std::chrono::seconds(5);
+  while (next < end) {
+    shared->leader.add(secondsNow(), basePosition());
+    next += std::chrono::microseconds(SAMPLE_US);
+    std::this_thread::sleep_until(next);
+  }
+  shared->phase = PHASE_TAKEOVER;
+  TEST_ASSERT_EQUAL_STRING("PLAYBACK_STOPPED", get("/stop_sequence").body.c_str());
+  duplicator.drain();
+}
+
+// A leader restarted with a fresh id is refused while the old session is
+// recent, then followed once it has been quiet for LEADER_TIMEOUT_US
+static void test_new_leader_takes_over() {
+  uint32_t oldLeader = duplicator.lastLeader();
+  TEST_ASSERT_EQUAL_INT(200, get("/mirror?mode=off").code);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  TEST_ASSERT_EQUAL_INT(200, get("/mirror?mode=leader").code);
+  std::this_thread::sleep_for(std::chrono::microseconds(Mirror::LEADER_TIMEOUT_US + 500000));
+  uint32_t newLeader = duplicator.lastLeader();
+  TEST_ASSERT_TRUE(newLeader != oldLeader);
+
+  uint32_t sent = mirror.packetsSent();
+  uint32_t repeated = duplicator.packetsRepeated();
+  shared->phase = PHASE_REPORT;
+  for (int i = 0; i < FOLLOWERS; i++) {
+    int status = -1;
+    TEST_ASSERT_EQUAL_INT(children[i], waitpid(children[i], &status, 0));
+    children[i] = 0;
+    TEST_ASSERT_TRUE(WIFEXITED(status));
+    TEST_ASSERT_EQUAL_INT(0, WEXITSTATUS(status));
+  }
+  stopTasks();
+  duplicator.stop();
+
+  report("leader: %u packets at %u Hz, %u repeated %u ms late", (unsigned)sent, (unsigned)mirror.rate(),
+         (unsigned)repeated, (unsigned)DUPLICATE_DELAY_MS);
+  for (int i = 0; i < FOLLOWERS; i++) {
+    const FollowerResult& f = shared->followers[i];
+    Tracking t = tracking(f.trace);
+    report("follower %d (clock +%.0f s): lag %.0f ms, error rms %.2f deg, max %.1f deg", i,
+           clockOffsetUs[i] / 1e6, t.lagMs, t.rms, t.max);
+    report("  %u accepted, %u stale, %u lost, %u from the second leader, %u extrapolated", (unsigned)f.accepted,
+           (unsigned)f.stale, (unsigned)f.lost, (unsigned)f.invalid, (unsigned)f.extrapolated);
+
+    TEST_ASSERT_TRUE(f.trace.count > 900);
+    // About the playout delay; a follower that drifted or stalled wouldn't fit any lag this well
+    TEST_ASSERT_TRUE(t.lagMs > 20 && t.lagMs < 100);
+    TEST_ASSERT_TRUE(t.rms < 1.5f);
+    TEST_ASSERT_TRUE(t.max < 5);
+    // Every repeat arrives after the original and is dropped
+    TEST_ASSERT_EQUAL_UINT32(repeated, f.stale);
+    TEST_ASSERT_TRUE(f.lost <= sent / 100);
+    TEST_ASSERT_TRUE(f.accepted + f.invalid + f.lost >= sent * 95 / 100);
+    // The new leader was refused until the old one timed out, then followed
+    TEST_ASSERT_TRUE(f.invalid > 0);
+    TEST_ASSERT_TRUE(f.following);
+    TEST_ASSERT_EQUAL_UINT32(newLeader, f.leader);
+  }
+}
+
+// A bad rate or mode is refused with 400 and changes neither
+static void test_bad_arguments_rejected() {
+  uint16_t rate = mirror.rate();
+  MirrorMode mode = mirror.mode();
+  const char* bad[] = {"/mirror?rate=abc", "/mirror?rate=0",   "/mirror?rate=-1",         "/mirror?rate=65536",
+                       "/mirror?rate=101", "/mirror?rate=2.5", "/mirror?rate=",           "/mirror?rate=+20",
+                       "/mirror?rate=20&mode=on",              "/mirror?mode=off&rate=0"};
+  for (const char* url : bad) {
+    TEST_ASSERT_EQUAL_INT_MESSAGE(400, get(url).code, url);
+    TEST_ASSERT_EQUAL_UINT16(rate, mirror.rate());
+    TEST_ASSERT_EQUAL(mode, mirror.mode());
+  }
+  TEST_ASSERT_EQUAL_INT(200, get("/mirror?rate=100").code);
+  TEST_ASSERT_EQUAL_UINT16(100, mirror.rate());
+  TEST_ASSERT_EQUAL_INT(200, get("/mirror?rate=1&mode=off").code);
+  TEST_ASSERT_EQUAL_UINT16(1, mirror.rate());
+  TEST_ASSERT_EQUAL(MIRROR_OFF, mirror.mode());
+}
+
+int main() {
+  shared = (Shared*)mmap(nullptr, sizeof(Shared), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  if (shared == MAP_FAILED) return 1;
+  new (shared) Shared();
+  shared->start = Clock::now();
+  // Before anything starts a thread
+  for (int i = 0; i < FOLLOWERS; i++) {
+    children[i] = fork();
+    if (children[i] == 0) runFollower(i);
+  }
+
+  setup();
+  UNITY_BEGIN();
+  RUN_TEST(test_followers_track_leader);
+  RUN_TEST(test_new_leader_takes_over);
+  RUN_TEST(test_bad_arguments_rejected);
+  int failures = UNITY_END();
+
+  // After a failure, don't leave followers behind
+  shared->phase = PHASE_REPORT;
+  for (int i = 0; i < FOLLOWERS; i++) {
+    if (children[i] > 0) waitpid(children[i], nullptr, 0);
+  }
+  if (running) stopTasks();
+  return failures;
+}
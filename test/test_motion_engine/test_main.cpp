@@ -0,0 +1,120 @@
+// Handler latency and tick jitter on a simulated clock. delay() advances
+// that clock, so a handler that blocked the way moveServoSmoothly() did
+// would show up here as hundreds of simulated milliseconds.
+
+#include <ArmSim.h>
+#include <chrono>
+#include <string>
+#include "ServoDriver.h"
+
+// From src/main.cpp
+extern ServoDriver servoDriver;
+
+// The number after `series` in a /metrics body, or -1
+static long metricValue(const std::string& body, const char* series) {
+  size_t at = body.find(series);
+  if (at == std::string::npos) return -1;
+  return strtol(body.c_str() + at + strlen(series), nullptr, 10);
+}
+
+void setUp() {}
+void tearDown() {}
+
+// A full-range slider jump used to block for 540 ms; now the handler only
+// queues the target and the servo gets there over the following ticks
+static void test_set_servo_returns_before_the_move() {
+  TEST_ASSERT_EQUAL_STRING("enabled", get("/toggle_servo?joint=0").body.c_str());
+  TEST_ASSERT_EQUAL_STRING("OK", get("/set_servo?joint=0&pos=0").body.c_str());
+  runMs(1000);
+  TEST_ASSERT_EQUAL_INT(0, arm.position(JOINT_BASE));
+
+  uint64_t simBefore = simMicros();
+  auto start = std::chrono::steady_clock::now();
+  SimResponse r = get("/set_servo?joint=0&pos=180");
+  auto end = std::chrono::steady_clock::now();
+  uint64_t simUs = simMicros() - simBefore;
+  double hostUs = std::chrono::duration<double, std::micro>(end - start).count();
+  report("/set_servo 0 -> 180: %llu us simulated, %.1f us host", (unsigned long long)simUs, hostUs);
+  TEST_ASSERT_EQUAL_INT(200, r.code);
+  TEST_ASSERT_EQUAL_UINT32(0, (uint32_t)simUs);
+  TEST_ASSERT_LESS_OR_EQUAL(1000, (uint32_t)hostUs);
+
+  // The servo walks there at the old 1 degree per 3 ms, one LEDC update a tick
+  MotionSnapshot snap;
+  uint32_t lastDuty = simLedcChannel(LEDC_CHANNEL_0).duty;
+  uint32_t ms = 0;
+  for (; ms < 1000; ms += 5) {
+    runMs(5);
+    uint32_t duty = simLedcChannel(LEDC_CHANNEL_0).duty;
+    TEST_ASSERT_GREATER_OR_EQUAL(lastDuty, duty);
+    lastDuty = duty;
+    motion.snapshot(snap);
+    if (snap.position[JOINT_BASE] == 180) break;
+  }
+  report("reached 180 after %u ms", (unsigned)ms);
+  TEST_ASSERT_UINT32_WITHIN(15, 540, ms);
+  TEST_ASSERT_EQUAL_UINT32(ServoDriver::dutyFor(ServoDriver::pulseUs(servoDriver.config(JOINT_BASE), 180)),
+                           simLedcChannel(LEDC_CHANNEL_0).duty);
+}
+
+// Every timed route reports its handler time; none of them waits on the clock
+static void test_handler_histograms_stay_in_the_first_bucket() {
+  const char* urls[] = {"/set_servo?joint=0&pos=20", "/go_home", "/state", "/move_xyz?x=0&y=150&z=120"};
+  for (int i = 0; i < 50; i++) {
+    for (const char* url : urls) get(url);
+    runMs(5);
+  }
+  std::string body = get("/metrics").body;
+  const char* routes[] = {"/set_servo", "/go_home", "/state", "/move_xyz"};
+  for (const char* route : routes) {
+    char fast[96], count[96];
+    snprintf(fast, sizeof(fast), "mearm_http_handler_duration_microseconds_bucket{route=\"%s\",le=\"100\"} ", route);
+    snprintf(count, sizeof(count), "mearm_http_handler_duration_microseconds_count{route=\"%s\"} ", route);
+    long total = metricValue(body, count);
+    TEST_ASSERT_GREATER_OR_EQUAL_MESSAGE(50, total, route);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(total, metricValue(body, fast), route);
+  }
+}
+
+// Ticks woken late by a known amount show up in the jitter histogram as
+// exactly that lateness; early wakes count as on time, and a stall resyncs
+// the schedule instead of making every later tick look late
+static void test_tick_jitter() {
+  const LatencyHistogram& hist = motion.tickJitterHistogram();
+
+  // Resync on a stall so the schedule is known: the next tick is due at base + period
+  uint64_t base = simMicros() + 50000;
+  simSetMicros(base);
+  motion.step(micros());
+  MotionSnapshot snap;
+  motion.snapshot(snap);
+  TEST_ASSERT_GREATER_OR_EQUAL(40000, snap.maxTickJitterUs);
+
+  uint32_t count = hist.count();
+  uint64_t sum = hist.sumUs();
+  uint32_t onTime = hist.bucketCount(0);
+  uint32_t late = hist.bucketCount(2); // 250-500 us
+  const uint32_t ticks = 200;
+  for (uint32_t k = 1; k <= ticks; k++) {
+    uint64_t due = base + k * MotionEngine::TICK_INTERVAL_US;
+    uint64_t now = k % 10 == 0 ? due + 300 : k % 10 == 5 ? due - 200 : due;
+    simSetMicros(now);
+    motion.step(micros());
+  }
+  report("%u ticks: sum %llu us, %u on time, %u late", (unsigned)(hist.count() - count),
+         (unsigned long long)(hist.sumUs() - sum), (unsigned)(hist.bucketCount(0) - onTime),
+         (unsigned)(hist.bucketCount(2) - late));
+  TEST_ASSERT_EQUAL_UINT32(ticks, hist.count() - count);
+  TEST_ASSERT_EQUAL_UINT32(ticks / 10 * 300, (uint32_t)(hist.sumUs() - sum));
+  TEST_ASSERT_EQUAL_UINT32(ticks - ticks / 10, hist.bucketCount(0) - onTime);
+  TEST_ASSERT_EQUAL_UINT32(ticks / 10, hist.bucketCount(2) - late);
+}
+
+int main() {
+  setup();
+  UNITY_BEGIN();
+  RUN_TEST(test_set_servo_returns_before_the_move);
+  RUN_TEST(test_handler_histograms_stay_in_the_first_bucket);
+  RUN_TEST(test_tick_jitter);
+  return UNITY_END();
+}
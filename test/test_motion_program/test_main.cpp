@@ -0,0 +1,82 @@
+// Motion program text: numbers, words run together, dwell limits and the
+// errors reported for bad input.
+
+#include <ArmSim.h>
+#include "Envelope.h"
+#include "MotionProgram.h"
+
+static const int start[JOINT_COUNT] = {90, 90, 90, 90};
+static MotionProgram program;
+static ProgramError error;
+
+static void assertTargets(uint8_t block, int base, int shoulder, int elbow, int claw) {
+  const int16_t* t = program[block].targets;
+  TEST_ASSERT_EQUAL_INT(base, t[JOINT_BASE]);
+  TEST_ASSERT_EQUAL_INT(shoulder, t[JOINT_SHOULDER]);
+  TEST_ASSERT_EQUAL_INT(elbow, t[JOINT_ELBOW]);
+  TEST_ASSERT_EQUAL_INT(claw, t[JOINT_GRIPPER]);
+}
+
+static void assertRejected(const char* text, uint16_t line, const char* message) {
+  TEST_ASSERT_FALSE_MESSAGE(program.parse(text, start, error), text);
+  TEST_ASSERT_EQUAL_UINT16_MESSAGE(line, error.line, text);
+  TEST_ASSERT_EQUAL_STRING_MESSAGE(message, error.message, text);
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_words_and_numbers() {
+  TEST_ASSERT_TRUE(envelopeAllows(100, 60));
+  TEST_ASSERT_TRUE(program.parse("G1 B90 S100 E60 C30 F90\n"
+                                 "G1B45S100E60C30\n"          // No spaces; E is a joint, not an exponent
+                                 "G1 S100E60\n"
+                                 "b12.5 c+7 ; lower case, a fraction and a sign\n"
+                                 "G0 B.5\n",
+                                 start, error));
+  TEST_ASSERT_EQUAL_UINT8(5, program.size());
+  assertTargets(0, 90, 100, 60, 30);
+  assertTargets(1, 45, 100, 60, 30);
+  assertTargets(2, 45, 100, 60, 30);
+  assertTargets(3, 13, 100, 60, 7);
+  assertTargets(4, 1, 100, 60, 7);
+  TEST_ASSERT_EQUAL_FLOAT(90, program[1].speed); // F carries over
+  TEST_ASSERT_EQUAL_FLOAT(0, program[4].speed);  // G0 runs at the joint limits
+}
+
+static void test_bad_numbers() {
+  assertRejected("G1 Bnan", 1, "Expected a letter followed by a number");
+  assertRejected("G1 B90 F inf", 1, "Expected a letter followed by a number");
+  // B1 then elbow 2, not 100
+  assertRejected("G1 B90\nG1 B1e2", 2, "Shoulder/elbow pose would hit the table or base");
+  assertRejected("G1 B-", 1, "Expected a letter followed by a number");
+  assertRejected("G1 B.", 1, "Expected a letter followed by a number");
+  assertRejected("G1 B9.0.5", 1, "Expected a letter followed by a number");
+  assertRejected("G1 B0x10", 1, "Unknown word");
+  assertRejected("G1 F1000000000000000000000000000000000000000", 1, "Number out of range");
+  assertRejected("G1 B181", 1, "Joint angle out of range (0-180)");
+  assertRejected("G1 B-0.6", 1, "Joint angle out of range (0-180)");
+  assertRejected("G2 B90", 1, "Only G0, G1 and G4 are supported");
+  assertRejected("G1.5 B90", 1, "Only G0, G1 and G4 are supported");
+}
+
+// Dwells on one waypoint add up to at most 60 s instead of wrapping 16 bits
+static void test_dwell() {
+  TEST_ASSERT_TRUE(program.parse("G1 B10\nG4 P250\nG4 P750\nG1 B20\nG4 P60000", start, error));
+  TEST_ASSERT_EQUAL_UINT8(2, program.size());
+  TEST_ASSERT_TRUE(program[0].stop);
+  TEST_ASSERT_EQUAL_UINT16(1000, program[0].dwellMs);
+  TEST_ASSERT_EQUAL_UINT16(60000, program[1].dwellMs);
+
+  assertRejected("G1 B10\nG4 P60000\nG4 P1", 3, "Dwell adds up to more than 60000 ms");
+  assertRejected("G1 B10\nG4 P40000\nG4 P40000", 3, "Dwell adds up to more than 60000 ms");
+  assertRejected("G1 B10\nG4 P60001", 2, "P must be 0-60000 ms");
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_words_and_numbers);
+  RUN_TEST(test_bad_numbers);
+  RUN_TEST(test_dwell);
+  return UNITY_END();
+}
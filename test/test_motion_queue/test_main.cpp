@@ -0,0 +1,149 @@
+// Stress test of the network-to-motion hand-off with real threads: the SPSC
+// queue flooded from one thread and drained from another, and a MotionTask
+// ticking on its own thread while commands pour in and a third thread
+// reads snapshots. Checks ordering, loss, torn reads and latency.
+// pio test -e native -f test_motion_queue -v prints the numbers.
+
+#include <ArmSim.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "SpscQueue.h"
+
+typedef std::chrono::steady_clock Clock;
+
+static uint64_t nowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+void setUp() {}
+void tearDown() {}
+
+// An item whose fields are all derived from its sequence number, so a slot
+// read while being written shows up
+struct Item {
+  uint32_t seq;
+  uint32_t check[6];
+  uint64_t sentNs;
+};
+
+static void test_queue_flood() {
+  static SpscQueue<Item, MotionTask::QUEUE_SIZE> queue;
+  const uint32_t count = 200000;
+  std::atomic<uint32_t> outOfOrder{0}, torn{0};
+  std::vector<uint32_t> latencyNs;
+  latencyNs.reserve(count);
+
+  auto start = Clock::now();
+  std::thread consumer([&] {
+    uint32_t expected = 0;
+    Item item;
+    while (expected < count) {
+      if (!queue.pop(item)) {
+        std::this_thread::yield(); // The host may have a single core
+        continue;
+      }
+      uint64_t now = nowNs();
+      if (item.seq != expected) outOfOrder++;
+      for (uint32_t k = 0; k < 6; k++) {
+        if (item.check[k] != item.seq * (k + 3)) torn++;
+      }
+      latencyNs.push_back((uint32_t)(now - item.sentNs));
+      expected = item.seq + 1;
+    }
+  });
+  uint32_t fullSpins = 0;
+  for (uint32_t seq = 0; seq < count; seq++) {
+    Item item;
+    item.seq = seq;
+    for (uint32_t k = 0; k < 6; k++) item.check[k] = seq * (k + 3);
+    item.sentNs = nowNs();
+    while (!queue.push(item)) {
+      fullSpins++;
+      std::this_thread::yield();
+      item.sentNs = nowNs();
+    }
+  }
+  consumer.join();
+  double sec = std::chrono::duration<double>(Clock::now() - start).count();
+
+  std::sort(latencyNs.begin(), latencyNs.end());
+  report("%u items in %.2f s (%.1f M/s), queue full %u times; latency p50 %u ns, p99 %u ns, max %u ns",
+         (unsigned)count, sec, count / sec / 1e6, (unsigned)fullSpins, (unsigned)latencyNs[count / 2],
+         (unsigned)latencyNs[count / 100 * 99], (unsigned)latencyNs.back());
+  TEST_ASSERT_EQUAL_UINT32(count, latencyNs.size());
+  TEST_ASSERT_EQUAL_UINT32(0, outOfOrder.load());
+  TEST_ASSERT_EQUAL_UINT32(0, torn.load());
+  TEST_ASSERT_EQUAL_UINT32(0, queue.size());
+}
+
+// The motion task at its real 200 Hz on the host clock. The producer sends
+// base targets 0, 1, 2, ... (mod 181) as fast as the queue takes them, so
+// in every consistent snapshot the base target follows from the count of
+// applied commands.
+static void test_motion_task_flood() {
+  simUseHostClock(true);
+  static MotionTask motion;
+  motion.begin(); // Records the task; the thread below stands in for it
+  const uint32_t count = 20000;
+  std::atomic<bool> done{false};
+  std::atomic<uint32_t> torn{0}, reads{0};
+
+  std::thread ticker([&] {
+    auto next = Clock::now();
+    while (!done) {
+      next += std::chrono::microseconds(MotionEngine::TICK_INTERVAL_US);
+      std::this_thread::sleep_until(next);
+      motion.step(micros());
+    }
+  });
+  std::thread reader([&] {
+    MotionSnapshot snap;
+    while (!done) {
+      motion.snapshot(snap);
+      if (snap.commandsApplied > 0 &&
+          snap.target[JOINT_BASE] != (int)((snap.commandsApplied - 1) % 181)) {
+        torn++;
+      }
+      reads++;
+      std::this_thread::yield();
+    }
+  });
+
+  uint32_t fullSpins = 0;
+  for (uint32_t i = 0; i < count; i++) {
+    while (!motion.setTarget(JOINT_BASE, i % 181, 100)) {
+      fullSpins++;
+      std::this_thread::yield();
+    }
+  }
+  MotionSnapshot snap;
+  for (motion.snapshot(snap); snap.commandsApplied < count; motion.snapshot(snap)) {
+    std::this_thread::yield();
+  }
+  done = true;
+  ticker.join();
+  reader.join();
+  simUseHostClock(false);
+
+  report("%u commands over %u ticks, queue full %u times, high water %u; %u snapshot reads; "
+         "command latency max %u us",
+         (unsigned)snap.commandsApplied, (unsigned)snap.ticks, (unsigned)fullSpins,
+         (unsigned)motion.queueHighWater(), (unsigned)reads.load(), (unsigned)snap.maxCommandLatencyUs);
+  TEST_ASSERT_EQUAL_UINT32(count, snap.commandsApplied);
+  TEST_ASSERT_EQUAL_INT((count - 1) % 181, snap.target[JOINT_BASE]);
+  TEST_ASSERT_EQUAL_UINT32(0, torn.load());
+  TEST_ASSERT_EQUAL_UINT32(MotionTask::QUEUE_SIZE, motion.queueHighWater());
+  // A command waits at most for the next tick, which drains the whole
+  // queue; the rest is the host's scheduling
+  TEST_ASSERT_LESS_OR_EQUAL(50000, snap.maxCommandLatencyUs);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_queue_flood);
+  RUN_TEST(test_motion_task_flood);
+  return UNITY_END();
+}
@@ -0,0 +1,124 @@
+// Playback control: how long /stop_sequence takes to bring a fast playback
+// to rest, also with the motion queue full, and that commands which can't
+// be queued are refused without changing anything.
+// pio test -e native -f test_playback -v prints the numbers.
+
+#include <ArmSim.h>
+
+// A base sweep, far enough each way that the arm is always mid-move
+static void uploadSweep() {
+  TEST_ASSERT_EQUAL(ARM_OK, arm.beginUpload());
+  for (int i = 0; i < 20; i++) {
+    PackedPose pose = {{(uint8_t)(i % 2 ? 20 : 160), 90, 90, 90}, 0};
+    TEST_ASSERT_EQUAL(ARM_OK, arm.uploadPose(pose));
+  }
+}
+
+static bool moving() {
+  MotionSnapshot snap;
+  motion.snapshot(snap);
+  return !snap.idle;
+}
+
+// Fills the queue with commands that change nothing
+static void fillQueue() {
+  while (motion.hold(JOINT_GRIPPER)) {
+  }
+}
+
+void setUp() {
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+    bool on;
+    if (!arm.enabled((JointId)i)) TEST_ASSERT_EQUAL(ARM_OK, arm.toggleJoint((JointId)i, on));
+  }
+}
+
+void tearDown() {
+  arm.stop();
+  runMs(20);
+}
+
+// From the request to the first tick with every joint held, for stops at
+// different points of a 3x playback; at most one tick
+static uint32_t stopLatencyUs(bool queueFull) {
+  uint32_t worst = 0, total = 0;
+  const int runs = 50;
+  for (int run = 0; run < runs; run++) {
+    uploadSweep();
+    TEST_ASSERT_EQUAL_STRING("PLAYBACK_STARTED", get("/play_sequence?speed=3&loops=0").body.c_str());
+    runMs(300 + run * 37);
+    while (!moving()) runMs(1); // Not in the pause between poses
+    if (queueFull) fillQueue();
+
+    uint32_t requested = simMicros();
+    TEST_ASSERT_EQUAL_STRING("PLAYBACK_STOPPED", get("/stop_sequence").body.c_str());
+    TEST_ASSERT_FALSE(arm.playing());
+    while (moving()) runMs(1);
+    uint32_t latency = simMicros() - requested;
+    MotionSnapshot held;
+    motion.snapshot(held);
+    runMs(200);
+    MotionSnapshot later;
+    motion.snapshot(later);
+    TEST_ASSERT_EQUAL_INT16_ARRAY(held.position, later.position, JOINT_COUNT);
+
+    if (latency > worst) worst = latency;
+    total += latency;
+  }
+  report("stop at 3x speed%s: mean %.1f ms, worst %.1f ms (tick %u ms)", queueFull ? " with the queue full" : "",
+         total / 1000.0 / runs, worst / 1000.0, (unsigned)(MotionEngine::TICK_INTERVAL_US / 1000));
+  return worst;
+}
+
+static void test_stop_latency() {
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(MotionEngine::TICK_INTERVAL_US, stopLatencyUs(false));
+  // The stop doesn't queue behind the commands; they are applied first in the same tick
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(MotionEngine::TICK_INTERVAL_US, stopLatencyUs(true));
+}
+
+// With no room in the queue each of these is refused and nothing changes;
+// once the motion task drains it they all go through
+static void test_queue_full_changes_nothing() {
+  bool on;
+  TEST_ASSERT_EQUAL(ARM_OK, arm.toggleJoint(JOINT_GRIPPER, on));
+  TEST_ASSERT_FALSE(on);
+  runMs(20);
+  uploadSweep();
+  int before[JOINT_COUNT];
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) before[i] = arm.position((JointId)i);
+
+  fillQueue();
+  TEST_ASSERT_EQUAL(ARM_QUEUE_FULL, arm.toggleJoint(JOINT_GRIPPER, on));
+  TEST_ASSERT_FALSE(arm.enabled(JOINT_GRIPPER));
+  TEST_ASSERT_EQUAL_INT(503, get("/toggle_servo?joint=3").code);
+  TEST_ASSERT_FALSE(arm.enabled(JOINT_GRIPPER));
+
+  TEST_ASSERT_EQUAL(ARM_QUEUE_FULL, arm.goHome());
+  TEST_ASSERT_EQUAL_INT(503, get("/go_home").code);
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) TEST_ASSERT_EQUAL_INT(before[i], arm.position((JointId)i));
+
+  // Playback needs the gripper enabled for its duration
+  TEST_ASSERT_EQUAL(ARM_QUEUE_FULL, arm.play(nullptr));
+  TEST_ASSERT_FALSE(arm.playing());
+  ProgramError error;
+  TEST_ASSERT_EQUAL(ARM_QUEUE_FULL, arm.runProgram("G1 B100", error));
+  TEST_ASSERT_FALSE(arm.playing());
+  TEST_ASSERT_FALSE(motion.programBusy());
+
+  runMs(MotionEngine::TICK_INTERVAL_US / 1000);
+  TEST_ASSERT_EQUAL(ARM_OK, arm.goHome());
+  TEST_ASSERT_EQUAL(ARM_OK, arm.play(nullptr));
+  TEST_ASSERT_TRUE(arm.playing());
+  TEST_ASSERT_EQUAL(ARM_OK, arm.stop());
+  runMs(MotionEngine::TICK_INTERVAL_US / 1000);
+  TEST_ASSERT_EQUAL(ARM_OK, arm.toggleJoint(JOINT_GRIPPER, on));
+  TEST_ASSERT_TRUE(on);
+}
+
+int main() {
+  setup();
+  UNITY_BEGIN();
+  RUN_TEST(test_stop_latency);
+  RUN_TEST(test_queue_full_changes_nothing);
+  return UNITY_END();
+}
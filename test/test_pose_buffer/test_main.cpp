@@ -0,0 +1,87 @@
+// Recording buffer: fixed capacity, 6 bytes a pose, reported over /state,
+// and no heap allocation anywhere on the record path.
+
+#include <ArmSim.h>
+#include <string>
+#include "PoseBuffer.h"
+
+// `"key":N` from a JSON body, or -1
+static long jsonNumber(const std::string& json, const char* key) {
+  std::string quoted = std::string("\"") + key + "\":";
+  size_t at = json.find(quoted);
+  if (at == std::string::npos) return -1;
+  return strtol(json.c_str() + at + quoted.size(), nullptr, 10);
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_layout() {
+  TEST_ASSERT_EQUAL_UINT32(6, sizeof(PackedPose));
+  TEST_ASSERT_LESS_OR_EQUAL(PoseBuffer::CAPACITY * sizeof(PackedPose) + 16, sizeof(PoseBuffer));
+}
+
+// Fills to exactly CAPACITY, refuses the next pose without storing it, and
+// saturates the delta timestamp instead of wrapping
+static void test_capacity_and_timestamps() {
+  static PoseBuffer buffer;
+  uint8_t joints[JOINT_COUNT] = {0, 90, 90, 0};
+  uint32_t nowMs = 1000;
+  SimHeapStats before = simHeapStats();
+  for (size_t i = 0; i < PoseBuffer::CAPACITY; i++) {
+    joints[JOINT_BASE] = i % 181;
+    nowMs += i == 10 ? 100000 : 20;
+    TEST_ASSERT_TRUE(buffer.append(joints, nowMs));
+  }
+  TEST_ASSERT_TRUE(buffer.full());
+  TEST_ASSERT_FALSE(buffer.append(joints, nowMs + 20));
+  TEST_ASSERT_EQUAL_UINT32(PoseBuffer::CAPACITY, buffer.size());
+  TEST_ASSERT_EQUAL_UINT32(PoseBuffer::CAPACITY * 6, buffer.bytesUsed());
+  TEST_ASSERT_EQUAL_UINT32(before.allocations, simHeapStats().allocations);
+
+  TEST_ASSERT_EQUAL_UINT16(0, buffer[0].dtMs);
+  TEST_ASSERT_EQUAL_UINT16(20, buffer[1].dtMs);
+  TEST_ASSERT_EQUAL_UINT16(0xFFFF, buffer[10].dtMs);
+  TEST_ASSERT_EQUAL_UINT8(100, buffer[100].joints[JOINT_BASE]);
+}
+
+// Slider moves while recording, straight through the controller: the
+// buffer fills, recording stops itself, and not one allocation is made
+static void test_record_path_allocations() {
+  bool enabled;
+  TEST_ASSERT_EQUAL_INT(ARM_OK, arm.toggleJoint(JOINT_BASE, enabled));
+  TEST_ASSERT_TRUE(enabled);
+  TEST_ASSERT_EQUAL_INT(RECORD_STARTED, arm.toggleRecording());
+
+  SimHeapStats before = simHeapStats();
+  uint32_t moves = 0;
+  while (arm.recording() && moves < 2 * PoseBuffer::CAPACITY) {
+    simAdvanceMicros(MotionEngine::TICK_INTERVAL_US);
+    TEST_ASSERT_EQUAL_INT(ARM_OK, arm.setJoint(JOINT_BASE, moves % 2 ? 60 : 120));
+    motion.step(micros()); // Keeps the motion queue drained
+    moves++;
+  }
+  SimHeapStats after = simHeapStats();
+  report("%u slider moves recorded %u poses, %u allocations", (unsigned)moves,
+         (unsigned)arm.recordedSequence().size(), (unsigned)(after.allocations - before.allocations));
+  TEST_ASSERT_FALSE(arm.recording());
+  TEST_ASSERT_EQUAL_UINT32(PoseBuffer::CAPACITY, arm.recordedSequence().size());
+  TEST_ASSERT_EQUAL_UINT32(before.allocations, after.allocations);
+}
+
+// Capacity and fill level are reported over the API
+static void test_fill_reported_in_state() {
+  std::string json = get("/state").body;
+  TEST_ASSERT_EQUAL_INT(PoseBuffer::CAPACITY, jsonNumber(json, "capacity"));
+  TEST_ASSERT_EQUAL_INT(arm.recordedSequence().size(), jsonNumber(json, "poses"));
+}
+
+int main() {
+  setup();
+  UNITY_BEGIN();
+  RUN_TEST(test_layout);
+  RUN_TEST(test_capacity_and_timestamps);
+  RUN_TEST(test_record_path_allocations);
+  RUN_TEST(test_fill_reported_in_state);
+  return UNITY_END();
+}
@@ -0,0 +1,169 @@
+// Sequence library and home positions against the LittleFS stand-in (a RAM
+// disk that can be made to run out of space).
+
+#include <ArmSim.h>
+#include <LittleFS.h>
+#include <string>
+#include "SequenceStore.h"
+
+static SequenceStore store(LittleFS);
+
+static void fill(PoseBuffer& poses, size_t count, uint8_t seed) {
+  poses.clear();
+  for (size_t i = 0; i < count; i++) {
+    uint8_t joints[JOINT_COUNT] = {(uint8_t)((i + seed) % 181), 90, 90, seed};
+    poses.append(joints, i * 20);
+  }
+}
+
+// A sequence file with `poses` records and `count` in its header
+static void writeRaw(const char* name, uint32_t count, size_t poses) {
+  char path[48];
+  SequenceStore::pathFor(name, path, sizeof(path));
+  LittleFS.mkdir("/seq");
+  File file = LittleFS.open(path, "w");
+  uint8_t header[SEQUENCE_HEADER_SIZE] = {'M', 'A', 'R', 'M', SEQUENCE_FILE_VERSION, JOINT_COUNT, 0, 0,
+                                          (uint8_t)count, (uint8_t)(count >> 8), (uint8_t)(count >> 16),
+                                          (uint8_t)(count >> 24)};
+  file.write(header, sizeof(header));
+  for (size_t i = 0; i < poses; i++) {
+    PackedPose pose = {{(uint8_t)(i % 181), 90, 90, 0}, 20};
+    file.write((const uint8_t*)&pose, sizeof(pose));
+  }
+  file.close();
+}
+
+static void countSequence(const char*, uint32_t, void* ctx) {
+  (*(int*)ctx)++;
+}
+
+void setUp() {
+  LittleFS.simSetCapacity(0);
+}
+
+void tearDown() {}
+
+static void test_save_load_list_remove() {
+  static PoseBuffer saved, loaded;
+  fill(saved, 300, 7);
+  TEST_ASSERT_TRUE(store.save("pick", saved));
+  TEST_ASSERT_TRUE(store.exists("pick"));
+  TEST_ASSERT_EQUAL_UINT32(SEQUENCE_HEADER_SIZE + 300 * sizeof(PackedPose),
+                           LittleFS.open("/seq/pick.seq").size());
+
+  TEST_ASSERT_TRUE(store.load("pick", loaded));
+  TEST_ASSERT_EQUAL_UINT32(saved.size(), loaded.size());
+  TEST_ASSERT_EQUAL_MEMORY(&saved[0], &loaded[0], saved.bytesUsed());
+
+  fill(saved, 10, 9);
+  TEST_ASSERT_TRUE(store.save("place", saved));
+  int found = 0;
+  TEST_ASSERT_EQUAL_UINT32(2, store.list(countSequence, &found));
+  TEST_ASSERT_EQUAL_INT(2, found);
+
+  TEST_ASSERT_TRUE(store.remove("place"));
+  TEST_ASSERT_FALSE(store.exists("place"));
+  TEST_ASSERT_FALSE(store.save("../x", saved));
+  TEST_ASSERT_FALSE(store.save("", saved));
+}
+
+// Re-saving replaces the file by renaming over it; a save that runs out of
+// space fails and leaves the previous version readable, with no temporary
+// file behind
+static void test_failed_save_keeps_the_old_file() {
+  static PoseBuffer first, second, loaded;
+  fill(first, 50, 1);
+  fill(second, 1000, 2);
+  TEST_ASSERT_TRUE(store.save("keep", first));
+  TEST_ASSERT_TRUE(store.save("keep", second));
+  TEST_ASSERT_TRUE(store.load("keep", loaded));
+  TEST_ASSERT_EQUAL_UINT32(1000, loaded.size());
+  TEST_ASSERT_TRUE(store.save("keep", first));
+
+  LittleFS.simSetCapacity(LittleFS.usedBytes() + 2000);
+  TEST_ASSERT_FALSE(store.save("keep", second));
+  TEST_ASSERT_FALSE(LittleFS.exists("/seq/keep.seq.tmp"));
+  TEST_ASSERT_TRUE(store.load("keep", loaded));
+  TEST_ASSERT_EQUAL_UINT32(50, loaded.size());
+  TEST_ASSERT_EQUAL_MEMORY(&first[0], &loaded[0], first.bytesUsed());
+}
+
+// Headers promising more poses than the file holds are rejected, including
+// counts whose byte size wraps 32 bits
+static void test_corrupt_headers() {
+  SequenceReader reader;
+  writeRaw("short", 100, 99);
+  TEST_ASSERT_FALSE(reader.open(LittleFS, "short"));
+  writeRaw("exact", 100, 100);
+  TEST_ASSERT_TRUE(reader.open(LittleFS, "exact"));
+  TEST_ASSERT_EQUAL_UINT32(100, reader.size());
+  reader.close();
+  writeRaw("wraps", 0x2AAAAAAB, 1); // 6 * count == 2 mod 2^32
+  TEST_ASSERT_FALSE(reader.open(LittleFS, "wraps"));
+  writeRaw("huge", 0xFFFFFFFF, 4);
+  TEST_ASSERT_FALSE(reader.open(LittleFS, "huge"));
+
+  File stub = LittleFS.open("/seq/stub.seq", "w");
+  stub.write((const uint8_t*)"MARM", 4);
+  stub.close();
+  TEST_ASSERT_FALSE(reader.open(LittleFS, "stub"));
+  int found = 0;
+  store.list(countSequence, &found);
+  TEST_ASSERT_EQUAL_INT(3, found); // pick, keep and exact
+}
+
+// A sequence several times the RAM buffer streams through playback a chunk
+// at a time; it can't be loaded
+static void test_streaming_playback() {
+  const size_t poses = PoseBuffer::CAPACITY * 3;
+  writeRaw("long", poses, poses);
+  TEST_ASSERT_EQUAL_INT(413, get("/load_sequence?name=long").code);
+
+  SequenceReader reader;
+  TEST_ASSERT_TRUE(reader.open(LittleFS, "long"));
+  SimHeapStats before = simHeapStats();
+  PackedPose pose;
+  size_t read = 0;
+  while (reader.next(pose)) {
+    TEST_ASSERT_EQUAL_UINT8(read % 181, pose.joints[JOINT_BASE]);
+    read++;
+  }
+  TEST_ASSERT_EQUAL_UINT32(poses, read);
+  TEST_ASSERT_EQUAL_UINT32(before.allocations, simHeapStats().allocations);
+  TEST_ASSERT_TRUE(reader.rewind());
+  TEST_ASSERT_TRUE(reader.next(pose));
+  TEST_ASSERT_EQUAL_UINT8(0, pose.joints[JOINT_BASE]);
+  reader.close();
+
+  TEST_ASSERT_EQUAL_STRING("PLAYBACK_STARTED", get("/play_sequence?name=long&speed=3").body.c_str());
+  runMs(3000);
+  uint32_t done, total;
+  arm.playProgress(done, total);
+  TEST_ASSERT_EQUAL_UINT32(poses, total);
+  TEST_ASSERT_GREATER_THAN(SequenceReader::CHUNK_POSES, done); // Past the first chunk
+  get("/stop_sequence");
+  TEST_ASSERT_FALSE(arm.playing());
+}
+
+// Home positions survive a reboot (a fresh controller over the same volume)
+static void test_home_persists() {
+  const int home[JOINT_COUNT] = {45, 100, 80, 20};
+  TEST_ASSERT_TRUE(store.saveHome(home));
+  static MotionTask otherMotion;
+  static ArmController rebooted(otherMotion, store);
+  rebooted.begin();
+  for (uint8_t i = 0; i < JOINT_COUNT; i++) {
+    TEST_ASSERT_EQUAL_INT(home[i], rebooted.home((JointId)i));
+  }
+}
+
+int main() {
+  setup();
+  UNITY_BEGIN();
+  RUN_TEST(test_save_load_list_remove);
+  RUN_TEST(test_failed_save_keeps_the_old_file);
+  RUN_TEST(test_corrupt_headers);
+  RUN_TEST(test_streaming_playback);
+  RUN_TEST(test_home_persists);
+  return UNITY_END();
+}
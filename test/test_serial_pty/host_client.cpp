@@ -0,0 +1,2 @@
+// The host client library, built into this test as it is into mearmctl
+#include "../../host/MeArmClient.cpp"
@@ -0,0 +1,235 @@
+// The binary serial protocol end to end: the native firmware's UART on the
+// master side of a Linux pseudo-terminal, the host client (host/) on the
+// other, and the firmware's tasks on their own threads as on the ESP32.
+// Reports round-trip times for each request type.
+// pio test -e native -f test_serial_pty -v prints the numbers.
+
+#include <ArmSim.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fcntl.h>
+#include <termios.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include "Log.h"
+#include "SerialLink.h"
+#include "../../host/MeArmClient.h"
+
+// From src/main.cpp
+extern SerialLink serialLink;
+
+typedef std::chrono::steady_clock Clock;
+
+static int master = -1, slave = -1;
+static std::string device;
+static std::atomic<bool> running{false};
+static std::thread motionTask, networkTask, logTask;
+static MeArmClient client;
+static uint32_t connectErrors;
+
+// The motion task at 200 Hz, the network task every millisecond (as with
+// vTaskDelay(1)) and the log task, each on its own thread with the host
+// clock. As on the ESP32, a client keeping the link busy holds up neither
+// the ticks nor the log.
+static void startTasks() {
+  running = true;
+  motionTask = std::thread([] {
+    auto next = Clock::now();
+    while (running) {
+      next += std::chrono::microseconds(MotionEngine::TICK_INTERVAL_US);
+      std::this_thread::sleep_until(next);
+      motion.step(micros());
+    }
+  });
+  networkTask = std::thread([] {
+    while (running) {
+      networkPoll();
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  });
+  logTask = std::thread([] {
+    while (running) {
+      logFlush();
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  });
+}
+
+static void stopTasks() {
+  running = false;
+  logTask.join();
+  networkTask.join();
+  motionTask.join();
+}
+
+static void openPty() {
+  master = posix_openpt(O_RDWR | O_NOCTTY);
+  TEST_ASSERT_TRUE(master >= 0);
+  TEST_ASSERT_EQUAL_INT(0, grantpt(master));
+  TEST_ASSERT_EQUAL_INT(0, unlockpt(master));
+  device = ptsname(master);
+  // Raw from the start, so nothing the firmware writes is echoed back to it;
+  // held open so the master never reads end-of-file between clients
+  slave = open(device.c_str(), O_RDWR | O_NOCTTY);
+  TEST_ASSERT_TRUE(slave >= 0);
+  struct termios tio;
+  tcgetattr(slave, &tio);
+  cfmakeraw(&tio);
+  tcsetattr(slave, TCSANOW, &tio);
+}
+
+struct Stats {
+  double p50, p99, max;
+};
+
+static Stats stats(std::vector<double>& us) {
+  std::sort(us.begin(), us.end());
+  return {us[us.size() / 2], us[us.size() * 99 / 100], us.back()};
+}
+
+// Round trips of `request`, in microseconds
+template <typename F>
+static Stats roundTrips(const char* name, int count, F request) {
+  std::vector<double> us;
+  for (int i = 0; i < count; i++) {
+    auto start = Clock::now();
+    TEST_ASSERT_TRUE_MESSAGE(request(i), name);
+    us.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+  }
+  Stats s = stats(us);
+  report("%-12s %4d round trips: p50 %6.0f us, p99 %6.0f us, max %6.0f us", name, count, s.p50, s.p99, s.max);
+  return s;
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_connect() {
+  TEST_ASSERT_FALSE(serialLink.active());
+  TEST_ASSERT_TRUE(client.open(device));
+  TEST_ASSERT_TRUE(serialLink.active());
+  // The boot log's text, ended by the delimiter the firmware sends first
+  connectErrors = client.frameErrors();
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(1, connectErrors);
+  uint8_t status;
+  TEST_ASSERT_TRUE(client.enable(0x0F, 0x0F, status));
+  TEST_ASSERT_EQUAL_UINT8(0, status);
+}
+
+// Each kind of request, and what the UART itself would add at 115200 baud
+static void test_round_trips() {
+  uint8_t payload[8] = {};
+  Stats ping = roundTrips("ping", 1000, [&](int i) {
+    memcpy(payload, &i, sizeof(i));
+    return client.ping(payload, sizeof(payload));
+  });
+  SerialState state;
+  roundTrips("get state", 500, [&](int) { return client.getState(state); });
+  roundTrips("set targets", 500, [&](int i) {
+    uint16_t tenths[SERIAL_JOINTS] = {(uint16_t)(800 + (i % 20) * 10), 0, 0, 0};
+    uint8_t status;
+    return client.setTargets(0x01, tenths, status) && status == 0;
+  });
+  // A frame is type, seq, payload and CRC plus COBS overhead and delimiter
+  double wireUs = 2 * (2 + sizeof(payload) + 2 + 2) * 10 * 1e6 / 115200;
+  report("a ping's %u bytes each way would add %.0f us on a 115200 baud cable", (unsigned)(sizeof(payload) + 6),
+         wireUs);
+  // Well inside the firmware's one-millisecond network task period and then some
+  TEST_ASSERT_TRUE(ping.p50 < 5000);
+  TEST_ASSERT_EQUAL_UINT32(connectErrors, client.frameErrors());
+  TEST_ASSERT_EQUAL_UINT32(0, serialLink.frameErrors());
+}
+
+// The arm goes where it was told
+static void test_targets_and_state() {
+  uint16_t tenths[SERIAL_JOINTS] = {450, 0, 0, 300};
+  uint8_t status;
+  TEST_ASSERT_TRUE(client.setTargets(0x09, tenths, status));
+  TEST_ASSERT_EQUAL_UINT8(0, status);
+  SerialState state;
+  auto deadline = Clock::now() + std::chrono::seconds(3);
+  do {
+    TEST_ASSERT_TRUE(client.getState(state));
+  } while ((state.actual[0] != 45 || state.actual[3] != 30) && Clock::now() < deadline);
+  TEST_ASSERT_EQUAL_UINT8(45, state.target[0]);
+  TEST_ASSERT_EQUAL_INT16(45, state.actual[0]);
+  TEST_ASSERT_EQUAL_INT16(30, state.actual[3]);
+  TEST_ASSERT_EQUAL_UINT8(0x0F, state.enabled);
+}
+
+// 100 setpoints a second for a second; none dropped, and the last one wins
+static void test_stream() {
+  uint32_t dropped = serialLink.setpointsDropped();
+  auto next = Clock::now();
+  for (int i = 0; i <= 100; i++) {
+    uint16_t tenths[SERIAL_JOINTS] = {(uint16_t)(450 + i * 5), 0, 0, 0};
+    TEST_ASSERT_TRUE(client.streamSetpoint(0x01, tenths));
+    next += std::chrono::milliseconds(10);
+    std::this_thread::sleep_until(next);
+  }
+  SerialState state;
+  TEST_ASSERT_TRUE(client.getState(state));
+  TEST_ASSERT_EQUAL_UINT8(95, state.target[0]);
+  TEST_ASSERT_EQUAL_UINT32(dropped, serialLink.setpointsDropped());
+}
+
+// An upload in several frames, saved to the library; the save's log line
+// comes back as a LOG frame
+static void test_upload() {
+  std::vector<MeArmClient::Pose> poses;
+  for (int i = 0; i < 100; i++) poses.push_back({{(uint8_t)(60 + i % 60), 90, 90, 40}, 50});
+  std::vector<std::string> logs;
+  client.onLog = [&](const std::string& line) { logs.push_back(line); };
+  uint8_t status;
+  auto start = Clock::now();
+  TEST_ASSERT_TRUE(client.uploadSequence(poses, "pty", status));
+  double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+  TEST_ASSERT_EQUAL_UINT8(0, status);
+  // The log task sends it within its 10 ms period
+  bool saved = false;
+  auto deadline = Clock::now() + std::chrono::seconds(1);
+  while (!saved && Clock::now() < deadline) {
+    TEST_ASSERT_TRUE(client.ping());
+    for (const std::string& line : logs) saved |= line.find("Saved sequence 'pty'") != std::string::npos;
+  }
+  client.onLog = nullptr;
+  report("upload of %u poses in %u frames: %.1f ms", (unsigned)poses.size(),
+         (unsigned)((poses.size() + 39) / 40 + 2), ms);
+  TEST_ASSERT_TRUE(saved);
+  SerialState state;
+  TEST_ASSERT_TRUE(client.getState(state));
+  TEST_ASSERT_EQUAL_UINT16(100, state.poses);
+}
+
+// CLOSE hands the UART back to the text log
+static void test_close() {
+  client.close();
+  auto deadline = Clock::now() + std::chrono::seconds(1);
+  while (serialLink.active() && Clock::now() < deadline) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  TEST_ASSERT_FALSE(serialLink.active());
+}
+
+int main() {
+  setup();
+  openPty();
+  Serial.simAttach(master);
+  simUseHostClock(true);
+  startTasks();
+
+  UNITY_BEGIN();
+  RUN_TEST(test_connect);
+  RUN_TEST(test_round_trips);
+  RUN_TEST(test_targets_and_state);
+  RUN_TEST(test_stream);
+  RUN_TEST(test_upload);
+  RUN_TEST(test_close);
+  int failures = UNITY_END();
+
+  stopTasks();
+  Serial.simAttach(-1);
+  close(slave);
+  close(master);
+  return failures;
+}
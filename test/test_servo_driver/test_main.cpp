@@ -0,0 +1,153 @@
+// Joint angle to LEDC duty: the calibration table (pulse range, direction,
+// trim), the 16-bit resolution, and that staged pulses only reach the
+// channels together on commit(). Also what it costs a request to find its
+// joint.
+
+#include <ArmSim.h>
+#include <math.h>
+#include "ServoDriver.h"
+
+// Four differently calibrated joints
+static const JointConfig table[JOINT_COUNT] = {
+    {"base", 13, 544, 2400, 1, 0},
+    {"shoulder", 12, 500, 2500, -1, 0}, // Mounted the other way round
+    {"elbow", 14, 1000, 2000, 1, 5},    // Horn trimmed 5 degrees
+    {"gripper", 27, 544, 2400, -1, -10},
+};
+
+static const SimLedcChannel& ledc(JointId joint) {
+  return simLedcChannel((ledc_channel_t)(LEDC_CHANNEL_0 + joint));
+}
+
+// Duty the way a scope would read it back: the pulse's share of the period
+static float dutyToUs(uint32_t duty) {
+  return duty * (float)ServoDriver::PERIOD_US / (1UL << ServoDriver::RESOLUTION_BITS);
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_pulse_widths() {
+  const JointConfig& base = table[JOINT_BASE];
+  TEST_ASSERT_FLOAT_WITHIN(0.01, 544, ServoDriver::pulseUs(base, 0));
+  TEST_ASSERT_FLOAT_WITHIN(0.01, 1472, ServoDriver::pulseUs(base, 90));
+  TEST_ASSERT_FLOAT_WITHIN(0.01, 2400, ServoDriver::pulseUs(base, 180));
+
+  // Reversed: 0 degrees is the long pulse
+  const JointConfig& shoulder = table[JOINT_SHOULDER];
+  TEST_ASSERT_FLOAT_WITHIN(0.01, 2500, ServoDriver::pulseUs(shoulder, 0));
+  TEST_ASSERT_FLOAT_WITHIN(0.01, 1500, ServoDriver::pulseUs(shoulder, 90));
+  TEST_ASSERT_FLOAT_WITHIN(0.01, 500, ServoDriver::pulseUs(shoulder, 180));
+
+  // Trimmed: the offset shifts the angle, and the horn can't be driven past
+  // the servo's own range
+  const JointConfig& elbow = table[JOINT_ELBOW];
+  TEST_ASSERT_FLOAT_WITHIN(0.01, 1000 + 1000 * 5 / 180.0, ServoDriver::pulseUs(elbow, 0));
+  TEST_ASSERT_FLOAT_WITHIN(0.01, 1500 + 1000 * 5 / 180.0, ServoDriver::pulseUs(elbow, 90));
+  TEST_ASSERT_FLOAT_WITHIN(0.01, 2000, ServoDriver::pulseUs(elbow, 178));
+
+  // Direction first, then the trim
+  const JointConfig& gripper = table[JOINT_GRIPPER];
+  TEST_ASSERT_FLOAT_WITHIN(0.01, 544 + 1856 * 160 / 180.0, ServoDriver::pulseUs(gripper, 10));
+  TEST_ASSERT_FLOAT_WITHIN(0.01, 544, ServoDriver::pulseUs(gripper, 175));
+}
+
+// Every angle in 0.1 degree steps lands within half a duty step of its
+// pulse, and every 1/10 degree is a different duty
+static void test_duty_resolution() {
+  const float stepUs = dutyToUs(1);
+  TEST_ASSERT_FLOAT_WITHIN(0.001, 0.305, stepUs);
+  for (uint8_t j = 0; j < JOINT_COUNT; j++) {
+    uint32_t previous = 0;
+    for (int tenth = 0; tenth <= 1800; tenth++) {
+      float us = ServoDriver::pulseUs(table[j], tenth / 10.0f);
+      uint32_t duty = ServoDriver::dutyFor(us);
+      TEST_ASSERT_FLOAT_WITHIN(stepUs / 2 + 0.001f, us, dutyToUs(duty));
+      float angle = (table[j].direction < 0 ? 180 - tenth / 10.0f : tenth / 10.0f) + table[j].offsetDeg;
+      if (tenth > 0 && angle > 0.05f && angle < 180) TEST_ASSERT_NOT_EQUAL(previous, duty);
+      previous = duty;
+    }
+  }
+}
+
+// Channels stay idle until enabled and then until the first position;
+// staged duties wait in the shadow register until commit() latches them all
+static void test_stage_and_commit() {
+  static ServoDriver driver(table);
+  driver.begin();
+  TEST_ASSERT_EQUAL_UINT32(ServoDriver::FREQUENCY_HZ, simLedcFrequency());
+  TEST_ASSERT_EQUAL_UINT8(ServoDriver::RESOLUTION_BITS, simLedcResolutionBits());
+  TEST_ASSERT_FALSE(driver.stage(JOINT_BASE, 90)); // Not enabled
+
+  for (uint8_t j = 0; j < JOINT_COUNT; j++) {
+    driver.setEnabled((JointId)j, true);
+    TEST_ASSERT_EQUAL_INT(table[j].pin, ledc((JointId)j).gpio);
+    TEST_ASSERT_EQUAL_UINT32(0, ledc((JointId)j).duty);
+  }
+
+  simLedcResetCounts();
+  for (uint8_t j = 0; j < JOINT_COUNT; j++) TEST_ASSERT_TRUE(driver.stage((JointId)j, 45));
+  TEST_ASSERT_EQUAL_UINT32(0, simLedcSetDutyCalls());
+  TEST_ASSERT_EQUAL_UINT32(0, ledc(JOINT_BASE).duty);
+  driver.commit();
+  TEST_ASSERT_EQUAL_UINT32(JOINT_COUNT, simLedcUpdateCalls());
+  for (uint8_t j = 0; j < JOINT_COUNT; j++) {
+    uint32_t expected = ServoDriver::dutyFor(ServoDriver::pulseUs(table[j], 45));
+    TEST_ASSERT_EQUAL_UINT32(expected, ledc((JointId)j).duty);
+    TEST_ASSERT_EQUAL_UINT32(expected, driver.duty((JointId)j));
+  }
+
+  // Only changed pulses are written; a change below one duty step is none
+  simLedcResetCounts();
+  TEST_ASSERT_FALSE(driver.stage(JOINT_BASE, 45));
+  TEST_ASSERT_FALSE(driver.stage(JOINT_SHOULDER, 45.001f));
+  TEST_ASSERT_TRUE(driver.stage(JOINT_ELBOW, 46));
+  driver.commit();
+  driver.commit();
+  TEST_ASSERT_EQUAL_UINT32(1, simLedcSetDutyCalls());
+  TEST_ASSERT_EQUAL_UINT32(1, simLedcUpdateCalls());
+
+  // Disabling stops the pulses; re-enabling waits for a position again
+  driver.setEnabled(JOINT_ELBOW, false);
+  TEST_ASSERT_FALSE(ledc(JOINT_ELBOW).running);
+  TEST_ASSERT_EQUAL_UINT32(0, driver.duty(JOINT_ELBOW));
+  driver.setEnabled(JOINT_ELBOW, true);
+  TEST_ASSERT_EQUAL_UINT32(0, ledc(JOINT_ELBOW).duty);
+  TEST_ASSERT_TRUE(driver.stage(JOINT_ELBOW, 46));
+  driver.commit();
+  TEST_ASSERT_EQUAL_UINT32(ServoDriver::dutyFor(ServoDriver::pulseUs(table[JOINT_ELBOW], 46)),
+                           ledc(JOINT_ELBOW).duty);
+}
+
+// The instruction count of the dispatch path can't be read on the host, so
+// this pins what would grow it: ?joint=<id> (what the page sends) reaches
+// the joint without a single string compare, while the legacy ?servo=<name>
+// pays one per table row up to the match
+static void test_dispatch_by_id() {
+  setup();
+  TEST_ASSERT_EQUAL_STRING("enabled", get("/toggle_servo?joint=3").body.c_str());
+
+  simResetStringCompares();
+  TEST_ASSERT_EQUAL_INT(200, get("/set_servo?joint=3&pos=100").code);
+  TEST_ASSERT_EQUAL_UINT32(0, simStringCompares());
+  TEST_ASSERT_EQUAL_INT(200, get("/toggle_servo?joint=3").code);
+  TEST_ASSERT_EQUAL_UINT32(0, simStringCompares());
+
+  simResetStringCompares();
+  TEST_ASSERT_EQUAL_INT(200, get("/set_servo?servo=gripper&pos=100").code);
+  TEST_ASSERT_EQUAL_UINT32(JOINT_COUNT, simStringCompares());
+
+  // Out of range ids don't fall back to a name
+  simResetStringCompares();
+  TEST_ASSERT_EQUAL_INT(400, get("/toggle_servo?joint=4").code);
+  TEST_ASSERT_EQUAL_UINT32(0, simStringCompares());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_pulse_widths);
+  RUN_TEST(test_duty_resolution);
+  RUN_TEST(test_stage_and_commit);
+  RUN_TEST(test_dispatch_by_id);
+  return UNITY_END();
+}
@@ -0,0 +1,167 @@
+// Cycle time of synchronized playback against the sequential playback it
+// replaced, which moved base, shoulder, elbow and gripper one after another
+// at 10 ms per degree and then waited 100 ms. Both run on the simulated
+// clock; pio test -e native -f test_trajectory -v prints the numbers.
+
+#include <ArmSim.h>
+#include <math.h>
+#include "Envelope.h"
+
+// What the old handlePlaySequence() took: moveServoSmoothly() wrote every
+// degree from the current to the target position with a 10 ms delay after
+// each, one joint at a time, then delay(100)
+static uint32_t sequentialMs(const PoseBuffer& poses, const int start[JOINT_COUNT]) {
+  int at[JOINT_COUNT];
+  for (uint8_t j = 0; j < JOINT_COUNT; j++) at[j] = start[j];
+  uint32_t ms = 0;
+  for (size_t i = 0; i < poses.size(); i++) {
+    for (uint8_t j = 0; j < JOINT_COUNT; j++) {
+      int to = poses[i].joints[j];
+      if (to != at[j]) ms += (abs(to - at[j]) + 1) * 10;
+      at[j] = to;
+    }
+    ms += 100;
+  }
+  return ms;
+}
+
+// Plays the recording and returns how long it took on the simulated clock
+static uint32_t synchronizedMs() {
+  TEST_ASSERT_EQUAL_STRING("PLAYBACK_STARTED", get("/play_sequence").body.c_str());
+  uint32_t start = millis();
+  while (arm.playing() && millis() - start < 120000) runMs(1);
+  TEST_ASSERT_FALSE(arm.playing());
+  return millis() - start;
+}
+
+// minSpeedup is the gate on sequential / synchronized
+static void compare(const char* name, float minSpeedup) {
+  int start[JOINT_COUNT];
+  for (uint8_t j = 0; j < JOINT_COUNT; j++) start[j] = arm.position((JointId)j);
+  size_t poses = arm.recordedSequence().size();
+  uint32_t before = sequentialMs(arm.recordedSequence(), start);
+  uint32_t after = synchronizedMs();
+  report("%-16s %3u poses: sequential %6u ms, synchronized %6u ms (%.2fx)", name, (unsigned)poses,
+         (unsigned)before, (unsigned)after, (float)before / after);
+  TEST_ASSERT_TRUE_MESSAGE(before >= after * minSpeedup, name);
+}
+
+void setUp() {}
+void tearDown() {}
+
+// Pick and place recorded through the sliders. Each recorded pose moves a
+// single joint, so there is nothing to overlap, and the speed limits
+// (100-180 deg/s) are close to the old 100 deg/s; the acceleration ramps
+// make it somewhat slower than the old constant-speed steps.
+static void test_slider_recording_cycle_time() {
+  for (uint8_t j = 0; j < JOINT_COUNT; j++) {
+    char url[32];
+    snprintf(url, sizeof(url), "/toggle_servo?joint=%u", j);
+    TEST_ASSERT_EQUAL_STRING("enabled", get(url).body.c_str());
+  }
+  runMs(1000);
+
+  TEST_ASSERT_EQUAL_STRING("RECORDING_STARTED", get("/toggle_record").body.c_str());
+  const int poses[][JOINT_COUNT] = {
+      {90, 90, 90, 90}, {30, 100, 70, 90}, {30, 110, 60, 150}, {30, 90, 80, 150},
+      {150, 90, 80, 150}, {150, 110, 60, 60}, {150, 90, 90, 60}, {90, 90, 90, 90},
+  };
+  for (const auto& pose : poses) {
+    for (uint8_t j = 0; j < JOINT_COUNT; j++) {
+      char url[48];
+      snprintf(url, sizeof(url), "/set_servo?joint=%u&pos=%d", j, pose[j]);
+      TEST_ASSERT_EQUAL_INT(200, get(url).code);
+    }
+    runMs(1000);
+  }
+  TEST_ASSERT_EQUAL_STRING("RECORDING_STOPPED", get("/toggle_record").body.c_str());
+  compare("slider recording", 0.7f);
+}
+
+// The same pick and place as whole-arm poses, e.g. from another arm or a
+// sequence file, where every joint moves at once
+static void test_pick_and_place_cycle_time() {
+  TEST_ASSERT_EQUAL_INT(ARM_OK, arm.beginUpload());
+  const uint8_t poses[][JOINT_COUNT] = {
+      {90, 90, 90, 90}, {30, 100, 70, 90}, {30, 110, 60, 150}, {30, 90, 80, 150},
+      {150, 90, 80, 150}, {150, 110, 60, 60}, {150, 90, 90, 60}, {90, 90, 90, 90},
+  };
+  for (const auto& joints : poses) {
+    PackedPose pose = {{joints[0], joints[1], joints[2], joints[3]}, 0};
+    TEST_ASSERT_EQUAL_INT(ARM_OK, arm.uploadPose(pose));
+  }
+  compare("pick and place", 1.15f);
+}
+
+// Random poses inside the collision envelope, as an uploaded sequence
+static void test_random_sequence_cycle_time() {
+  TEST_ASSERT_EQUAL_INT(ARM_OK, arm.beginUpload());
+  uint32_t seed = 12345;
+  auto next = [&seed](int range) {
+    seed = seed * 1103515245 + 12345;
+    return (int)((seed >> 16) % range);
+  };
+  for (int i = 0; i < 40;) {
+    PackedPose pose = {{(uint8_t)next(181), (uint8_t)next(181), (uint8_t)next(181), (uint8_t)next(181)}, 0};
+    if (!envelopeAllows(pose.joints[JOINT_SHOULDER], pose.joints[JOINT_ELBOW])) continue;
+    TEST_ASSERT_EQUAL_INT(ARM_OK, arm.uploadPose(pose));
+    i++;
+  }
+  compare("random", 1.8f);
+}
+
+// Within a segment every joint covers the same fraction of its move at the
+// same time, so the pose follows a straight line in joint space and they
+// all arrive together
+static void test_joints_finish_together() {
+  TEST_ASSERT_EQUAL_INT(ARM_OK, arm.beginUpload());
+  PackedPose from = {{20, 90, 90, 40}, 0};
+  PackedPose to = {{160, 100, 80, 120}, 0};
+  TEST_ASSERT_EQUAL_INT(ARM_OK, arm.uploadPose(from));
+  TEST_ASSERT_EQUAL_INT(ARM_OK, arm.uploadPose(to));
+  TEST_ASSERT_EQUAL_STRING("PLAYBACK_STARTED", get("/play_sequence").body.c_str());
+
+  // Wait for the first pose to be reached and the second segment to begin
+  MotionSnapshot snap;
+  uint32_t limit = millis() + 10000;
+  do {
+    runMs(1);
+    motion.snapshot(snap);
+  } while (snap.target[JOINT_BASE] != to.joints[JOINT_BASE] && millis() < limit);
+
+  int32_t arrived[JOINT_COUNT];
+  for (uint8_t j = 0; j < JOINT_COUNT; j++) arrived[j] = -1;
+  float worst = 0;
+  for (int32_t tick = 0; tick < 2000 && arm.playing(); tick++) {
+    runMs(MotionEngine::TICK_INTERVAL_US / 1000);
+    motion.snapshot(snap);
+    float base = (snap.position[0] - from.joints[0]) / (float)(to.joints[0] - from.joints[0]);
+    for (uint8_t j = 0; j < JOINT_COUNT; j++) {
+      if (arrived[j] < 0 && snap.position[j] == to.joints[j]) arrived[j] = tick;
+      // Positions are whole degrees: each fraction is within half a degree
+      float d = to.joints[j] - from.joints[j];
+      float off = fabsf((snap.position[j] - from.joints[j]) / d - base) - 0.5f / fabsf(d) -
+                  0.5f / fabsf(to.joints[0] - from.joints[0]);
+      if (off > worst) worst = off;
+    }
+  }
+  report("segment: arrival ticks %d %d %d %d, worst departure from the line %.3f", (int)arrived[0],
+         (int)arrived[1], (int)arrived[2], (int)arrived[3], worst);
+  TEST_ASSERT_TRUE(worst <= 0.001f);
+  // Whole degrees again: a joint with a short way to go shows its last
+  // degree earlier, but none is still moving once the longest arrives
+  for (uint8_t j = 0; j < JOINT_COUNT; j++) {
+    TEST_ASSERT_GREATER_OR_EQUAL(0, arrived[j]);
+    TEST_ASSERT_LESS_OR_EQUAL(arrived[0], arrived[j]);
+  }
+}
+
+int main() {
+  setup();
+  UNITY_BEGIN();
+  RUN_TEST(test_slider_recording_cycle_time);
+  RUN_TEST(test_pick_and_place_cycle_time);
+  RUN_TEST(test_random_sequence_cycle_time);
+  RUN_TEST(test_joints_finish_together);
+  return UNITY_END();
+}
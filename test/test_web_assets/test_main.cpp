@@ -0,0 +1,95 @@
+// The page is served as the gzipped bytes tools/build_web.py compiled into
+// flash, revalidates to a 304, and costs no heap in proportion to its size.
+
+#include <ArmSim.h>
+#include <string>
+#include <vector>
+#include "WebAssets.h"
+
+static uint32_t crc32(const std::vector<uint8_t>& data) {
+  uint32_t crc = 0xFFFFFFFF;
+  for (uint8_t b : data) {
+    crc ^= b;
+    for (int k = 0; k < 8; k++) crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+  }
+  return ~crc;
+}
+
+static uint32_t le32(const uint8_t* p) {
+  return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+void setUp() {}
+void tearDown() {}
+
+// Same bytes as the generated array, sent from flash without a copy, and
+// the gzip trailer matches web/index.html (so WebAssets.h isn't stale)
+static void test_served_bytes() {
+  SimResponse r = get("/");
+  TEST_ASSERT_EQUAL_INT(200, r.code);
+  TEST_ASSERT_EQUAL_STRING("text/html", r.contentType.c_str());
+  TEST_ASSERT_EQUAL_STRING("gzip", r.header("Content-Encoding").c_str());
+  TEST_ASSERT_EQUAL_STRING(INDEX_HTML_ETAG, r.header("ETag").c_str());
+  TEST_ASSERT_TRUE(r.fromFlash);
+  TEST_ASSERT_EQUAL_UINT32(INDEX_HTML_GZ_LEN, r.body.size());
+  TEST_ASSERT_EQUAL_MEMORY(INDEX_HTML_GZ, r.body.data(), INDEX_HTML_GZ_LEN);
+
+  const uint8_t* gz = INDEX_HTML_GZ;
+  TEST_ASSERT_EQUAL_UINT8(0x1f, gz[0]);
+  TEST_ASSERT_EQUAL_UINT8(0x8b, gz[1]);
+  FILE* f = fopen("web/index.html", "rb");
+  TEST_ASSERT_NOT_NULL_MESSAGE(f, "run from the project directory");
+  std::vector<uint8_t> html;
+  int c;
+  while ((c = fgetc(f)) != EOF) html.push_back((uint8_t)c);
+  fclose(f);
+  report("index.html: %u bytes, %u gzipped", (unsigned)html.size(), (unsigned)INDEX_HTML_GZ_LEN);
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(crc32(html), le32(gz + INDEX_HTML_GZ_LEN - 8), "WebAssets.h is stale");
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(html.size(), le32(gz + INDEX_HTML_GZ_LEN - 4), "WebAssets.h is stale");
+}
+
+static void test_etag_revalidation() {
+  const char* same[] = {"If-None-Match", INDEX_HTML_ETAG, nullptr};
+  SimResponse r = server.simRequest(HTTP_GET, "/", nullptr, same);
+  TEST_ASSERT_EQUAL_INT(304, r.code);
+  TEST_ASSERT_EQUAL_UINT32(0, r.body.size());
+
+  const char* other[] = {"If-None-Match", "\"0000000000000000\"", nullptr};
+  TEST_ASSERT_EQUAL_INT(200, server.simRequest(HTTP_GET, "/", nullptr, other).code);
+}
+
+// Each request allocates only the response object and its headers, all of
+// it returned afterwards; nothing near the size of the page
+static void test_heap_delta_per_request() {
+  get("/"); // Warm up anything allocated once
+  SimHeapStats before = simHeapStats();
+  const int requests = 100;
+  uint32_t allocations = 0;
+  size_t peak = 0;
+  for (int i = 0; i < requests; i++) {
+    simResetHeapPeak();
+    {
+      SimResponse r = get("/");
+      TEST_ASSERT_EQUAL_INT(200, r.code);
+      allocations += r.allocations;
+    }
+    // Less the test's own copy of the body in SimResponse
+    size_t used = simHeapStats().peakBytes - before.liveBytes - INDEX_HTML_GZ_LEN;
+    if (used > peak) peak = used;
+  }
+  SimHeapStats after = simHeapStats();
+  report("/: %.1f allocations per request, at most %u bytes in use, %d bytes left over",
+         (double)allocations / requests, (unsigned)peak, (int)(after.liveBytes - before.liveBytes));
+  TEST_ASSERT_EQUAL_UINT32(before.liveBytes, after.liveBytes);
+  TEST_ASSERT_LESS_OR_EQUAL(8 * requests, allocations);
+  TEST_ASSERT_LESS_OR_EQUAL(1024, peak);
+}
+
+int main() {
+  setup();
+  UNITY_BEGIN();
+  RUN_TEST(test_served_bytes);
+  RUN_TEST(test_etag_revalidation);
+  RUN_TEST(test_heap_delta_per_request);
+  return UNITY_END();
+}
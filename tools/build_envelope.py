@@ -0,0 +1,118 @@
+# Generates include/EnvelopeTable.h: one bit per whole-degree shoulder/elbow
+# pair, set where the arm keeps clear of the table and its base housing and
+# the linkage is neither folded nor stretched past its limits.
+#
+# The geometry comes from the ARM_* constants in include/Kinematics.h, so
+# editing those and rebuilding is enough. Runs before every PlatformIO build
+# (extra_scripts in platformio.ini) and can be run by hand:
+#   python tools/build_envelope.py
+# The header is only rewritten when the table changes.
+
+import math
+import os
+import re
+
+try:
+    Import("env")  # noqa: F821 - provided by PlatformIO/SCons
+    PROJECT_DIR = env.subst("$PROJECT_DIR")  # noqa: F821
+except NameError:
+    PROJECT_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+SOURCE = os.path.join(PROJECT_DIR, "include", "Kinematics.h")
+OUTPUT = os.path.join(PROJECT_DIR, "include", "EnvelopeTable.h")
+
+DEGREES = 181  # 0-180 for both joints
+
+
+def read_geometry():
+    with open(SOURCE) as f:
+        text = f.read()
+    return {name: int(value) for name, value in
+            re.findall(r"const int32_t (ARM_\w+) = (-?\d+);", text)}
+
+
+def crosses_box(a, b, r_max, z_max):
+    """True if segment a-b passes through |r| < r_max, z < z_max (Liang-Barsky)."""
+    t0, t1 = 0.0, 1.0
+    dr, dz = b[0] - a[0], b[1] - a[1]
+    for p, q in ((-dr, a[0] + r_max), (dr, r_max - a[0]), (dz, z_max - a[1])):
+        if p == 0:
+            if q <= 0:
+                return False
+        else:
+            t = q / p
+            if p < 0:
+                t0 = max(t0, t)
+            else:
+                t1 = min(t1, t)
+    return t0 < t1
+
+
+def allowed(g, shoulder, elbow):
+    """Brute-force check of one pose in the arm's vertical plane (r, z)."""
+    forearm = elbow - g["ARM_ELBOW_LEVEL"] / 100.0
+    # Angle between the upper arm and the forearm at the elbow
+    bend = abs((shoulder - forearm + 180) % 360 - 180)
+    link = 180 - bend
+    if link < g["ARM_LINK_MIN_ANGLE"] / 100.0 or link > g["ARM_LINK_MAX_ANGLE"] / 100.0:
+        return False
+
+    s, f = math.radians(shoulder), math.radians(forearm)
+    shoulder_pt = (0.0, float(g["ARM_SHOULDER_HEIGHT"]))
+    elbow_pt = (shoulder_pt[0] + g["ARM_UPPER_LENGTH"] * math.cos(s),
+                shoulder_pt[1] + g["ARM_UPPER_LENGTH"] * math.sin(s))
+    wrist_pt = (elbow_pt[0] + g["ARM_FOREARM_LENGTH"] * math.cos(f),
+                elbow_pt[1] + g["ARM_FOREARM_LENGTH"] * math.sin(f))
+    # The linkage keeps the gripper level, pointing away from the base
+    tip_pt = (wrist_pt[0] + g["ARM_GRIPPER_LENGTH"], wrist_pt[1])
+
+    for a, b in ((shoulder_pt, elbow_pt), (elbow_pt, wrist_pt), (wrist_pt, tip_pt)):
+        # Links are straight, so their lowest point is an end
+        if min(a[1], b[1]) < g["ARM_TABLE_CLEARANCE"]:
+            return False
+        if crosses_box(a, b, g["ARM_BASE_RADIUS"], g["ARM_BASE_TOP"]):
+            return False
+    return True
+
+
+def build_bits(g):
+    bits = bytearray((DEGREES * DEGREES + 7) // 8)
+    for shoulder in range(DEGREES):
+        for elbow in range(DEGREES):
+            if allowed(g, shoulder, elbow):
+                i = shoulder * DEGREES + elbow
+                bits[i >> 3] |= 1 << (i & 7)
+    return bits
+
+
+def render_header(bits):
+    count = sum(bin(b).count("1") for b in bits)
+    lines = [
+        "// Generated by tools/build_envelope.py from include/Kinematics.h - do not edit.",
+        "#ifndef ENVELOPE_TABLE_H",
+        "#define ENVELOPE_TABLE_H",
+        "",
+        "#include <Arduino.h>",
+        "",
+        "// Bit (shoulder * %d + elbow), LSB first; %d of %d poses allowed" % (DEGREES, count, DEGREES * DEGREES),
+        "const uint16_t ENVELOPE_DEGREES = %d;" % DEGREES,
+        "const uint8_t ENVELOPE_BITS[] PROGMEM = {",
+    ]
+    for i in range(0, len(bits), 16):
+        lines.append("  " + ", ".join("0x%02x" % b for b in bits[i:i + 16]) + ",")
+    lines += ["};", "", "#endif // ENVELOPE_TABLE_H", ""]
+    return "\n".join(lines)
+
+
+def build():
+    header = render_header(build_bits(read_geometry()))
+    if os.path.exists(OUTPUT):
+        with open(OUTPUT, "r") as f:
+            if f.read() == header:
+                return
+    with open(OUTPUT, "w") as f:
+        f.write(header)
+    print("build_envelope: %s -> %s" % (SOURCE, OUTPUT))
+
+
+build()
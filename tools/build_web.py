@@ -0,0 +1,57 @@
+# Compiles web/index.html into include/WebAssets.h as a gzipped byte array
+# plus an ETag, so the firmware can serve the page straight from flash.
+#
+# Runs automatically before every PlatformIO build (extra_scripts in
+# platformio.ini) and can also be run by hand: python tools/build_web.py
+# The header is only rewritten when the page changes.
+
+import gzip
+import hashlib
+import os
+
+try:
+    Import("env")  # noqa: F821 - provided by PlatformIO/SCons
+    PROJECT_DIR = env.subst("$PROJECT_DIR")  # noqa: F821
+except NameError:
+    PROJECT_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+SOURCE = os.path.join(PROJECT_DIR, "web", "index.html")
+OUTPUT = os.path.join(PROJECT_DIR, "include", "WebAssets.h")
+
+
+def render_header(data, etag):
+    lines = [
+        "// Generated by tools/build_web.py from web/index.html - do not edit.",
+        "#ifndef WEB_ASSETS_H",
+        "#define WEB_ASSETS_H",
+        "",
+        "#include <Arduino.h>",
+        "",
+        'const char INDEX_HTML_ETAG[] = "\\"%s\\"";' % etag,
+        "const size_t INDEX_HTML_GZ_LEN = %d;" % len(data),
+        "const uint8_t INDEX_HTML_GZ[] PROGMEM = {",
+    ]
+    for i in range(0, len(data), 16):
+        lines.append("  " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+    lines += ["};", "", "#endif // WEB_ASSETS_H", ""]
+    return "\n".join(lines)
+
+
+def build():
+    with open(SOURCE, "rb") as f:
+        html = f.read()
+    # mtime=0 keeps the output byte-identical for identical input
+    data = gzip.compress(html, compresslevel=9, mtime=0)
+    etag = hashlib.sha1(html).hexdigest()[:16]
+    header = render_header(data, etag)
+
+    if os.path.exists(OUTPUT):
+        with open(OUTPUT, "r") as f:
+            if f.read() == header:
+                return
+    with open(OUTPUT, "w") as f:
+        f.write(header)
+    print("build_web: %s -> %s (%d -> %d bytes)" % (SOURCE, OUTPUT, len(html), len(data)))
+
+
+build()